@@ -0,0 +1,275 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_BATCH_SCHEDULER_HPP
+#define POWER_GRID_MODEL_BATCH_SCHEDULER_HPP
+
+// persistent work-stealing scheduler for batch calculations
+
+#include "enum.hpp"
+#include "power_grid_model.hpp"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace power_grid_model {
+
+// hide implementation in inside namespace
+namespace batch_scheduler_impl {
+
+// range of task indices of one worker [begin, end)
+// aligned to cache line to prevent false sharing between workers
+struct alignas(64) TaskRange {
+    std::mutex mutex;
+    Idx begin{0};
+    Idx end{0};
+};
+
+// pool of persistent threads, worker 0 is always the calling thread
+class WorkerPool {
+  public:
+    WorkerPool() = default;
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+    ~WorkerPool() {
+        {
+            std::scoped_lock const lock{mutex_};
+            stop_ = true;
+        }
+        job_cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    Idx n_threads() const { return static_cast<Idx>(threads_.size()) + 1; }
+
+    // split [0, n_task) in contiguous ranges for n_worker workers
+    void assign_tasks(Idx n_worker, Idx n_task, BatchPartitioning partitioning) {
+        work_stealing_ = partitioning == BatchPartitioning::work_stealing;
+        ranges_ = std::vector<TaskRange>(n_worker);
+        for (Idx worker = 0; worker != n_worker; ++worker) {
+            ranges_[worker].begin = n_task * worker / n_worker;
+            ranges_[worker].end = n_task * (worker + 1) / n_worker;
+        }
+    }
+
+    // run job(worker) for all workers in [0, n_worker), and wait until all are finished
+    void dispatch(Idx n_worker, std::function<void(Idx)> const& job) {
+        // spawn extra threads if needed, they are kept alive afterwards
+        while (n_threads() < n_worker) {
+            threads_.emplace_back([this, worker = n_threads(), generation = generation_] {
+                thread_loop(worker, generation);
+            });
+        }
+        {
+            std::scoped_lock const lock{mutex_};
+            job_ = &job;
+            n_active_workers_ = n_worker;
+            n_running_ = static_cast<Idx>(threads_.size());
+            ++generation_;
+        }
+        job_cv_.notify_all();
+        // calling thread is worker 0
+        job(0);
+        // wait for all the other threads
+        std::unique_lock lock{mutex_};
+        done_cv_.wait(lock, [this] { return n_running_ == 0; });
+        job_ = nullptr;
+    }
+
+    // take one task from the front of the own range
+    // if exhausted, steal the back half of the largest remaining range of another worker
+    Idx next_task(Idx worker) {
+        {
+            TaskRange& own = ranges_[worker];
+            std::scoped_lock const lock{own.mutex};
+            if (own.begin < own.end) {
+                return own.begin++;
+            }
+        }
+        if (!work_stealing_) {
+            return -1;
+        }
+        auto const n_worker = static_cast<Idx>(ranges_.size());
+        while (true) {
+            Idx victim = -1;
+            Idx max_remaining = 0;
+            for (Idx other = 0; other != n_worker; ++other) {
+                if (other == worker) {
+                    continue;
+                }
+                TaskRange& range = ranges_[other];
+                std::scoped_lock const lock{range.mutex};
+                if (range.end - range.begin > max_remaining) {
+                    max_remaining = range.end - range.begin;
+                    victim = other;
+                }
+            }
+            // nothing left to steal
+            if (victim == -1) {
+                return -1;
+            }
+            Idx stolen_begin{};
+            Idx stolen_end{};
+            {
+                TaskRange& range = ranges_[victim];
+                std::scoped_lock const lock{range.mutex};
+                if (range.begin == range.end) {
+                    // the victim finished its range in the meantime, try again
+                    continue;
+                }
+                // back half, rounded up
+                stolen_end = range.end;
+                stolen_begin = range.begin + (range.end - range.begin) / 2;
+                range.end = stolen_begin;
+            }
+            // the first stolen task is returned directly
+            // the rest becomes the own range, which can be stolen again by other workers
+            TaskRange& own = ranges_[worker];
+            std::scoped_lock const lock{own.mutex};
+            own.begin = stolen_begin + 1;
+            own.end = stolen_end;
+            return stolen_begin;
+        }
+    }
+
+  private:
+    std::vector<TaskRange> ranges_;
+    bool work_stealing_{true};
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable done_cv_;
+    std::function<void(Idx)> const* job_{nullptr};
+    Idx n_active_workers_{0};
+    Idx n_running_{0};
+    Idx generation_{0};
+    bool stop_{false};
+
+    void thread_loop(Idx worker, Idx seen_generation) {
+        while (true) {
+            std::function<void(Idx)> const* job{nullptr};
+            {
+                std::unique_lock lock{mutex_};
+                job_cv_.wait(lock, [this, seen_generation] { return stop_ || generation_ != seen_generation; });
+                if (stop_) {
+                    return;
+                }
+                seen_generation = generation_;
+                if (worker < n_active_workers_) {
+                    job = job_;
+                }
+            }
+            if (job != nullptr) {
+                (*job)(worker);
+            }
+            {
+                std::scoped_lock const lock{mutex_};
+                --n_running_;
+            }
+            done_cv_.notify_all();
+        }
+    }
+};
+
+} // namespace batch_scheduler_impl
+
+/*
+Persistent work-stealing scheduler to distribute the scenarios of a batch calculation over threads.
+
+The scenarios [0, n_task) are initially split in contiguous ranges, one per worker.
+Each worker takes scenarios one by one from the front of its own range.
+When its own range is exhausted, it steals the back half of the largest remaining range of another worker.
+In this way the workers with cheap scenarios help the workers with expensive scenarios,
+    while the scenarios handled by one worker remain as contiguous as possible.
+With BatchPartitioning::contiguous, stealing is disabled: each worker handles exactly its own range in order.
+    This keeps consecutive scenarios (e.g. a time series) together in one worker.
+
+The threads are kept alive between calls, so repeated batch calculations do not pay for thread creation.
+The calling thread always acts as worker 0; the pool only holds the additional (n_thread - 1) threads.
+
+Copying a scheduler does not copy its threads. The copy will create its own threads when needed.
+*/
+class BatchScheduler {
+  public:
+    // handle of one worker to retrieve the next task
+    class TaskSource {
+      public:
+        // get the next task index, return -1 if all tasks are handed out
+        Idx next() { return pool_->next_task(worker_); }
+        Idx worker() const { return worker_; }
+
+      private:
+        friend class BatchScheduler;
+        TaskSource(batch_scheduler_impl::WorkerPool& pool, Idx worker) : pool_{&pool}, worker_{worker} {}
+
+        batch_scheduler_impl::WorkerPool* pool_;
+        Idx worker_;
+    };
+
+    BatchScheduler() = default;
+    BatchScheduler(BatchScheduler const& /* other */) : BatchScheduler{} {}
+    BatchScheduler& operator=(BatchScheduler const& /* other */) { return *this; }
+    BatchScheduler(BatchScheduler&&) noexcept = default;
+    BatchScheduler& operator=(BatchScheduler&&) noexcept = default;
+    ~BatchScheduler() = default;
+
+    Idx n_threads() const { return pool_ ? pool_->n_threads() : 1; }
+
+    /*
+    run n_task tasks on n_thread workers, including the calling thread.
+
+    worker_fn(TaskSource& task_source) is called once per worker.
+        The tasks of one worker are handed out in ascending order.
+        It should retrieve tasks via task_source.next() until it returns -1.
+    The function returns when all workers are finished.
+    An exception escaping from worker_fn is re-thrown in the calling thread.
+    */
+    template <std::invocable<TaskSource&> WorkerFn>
+    void run(Idx n_thread, Idx n_task, WorkerFn&& worker_fn,
+             BatchPartitioning partitioning = BatchPartitioning::work_stealing) {
+        n_thread = std::max(Idx{1}, std::min(n_thread, n_task));
+        if (!pool_) {
+            pool_ = std::make_unique<batch_scheduler_impl::WorkerPool>();
+        }
+        batch_scheduler_impl::WorkerPool& pool = *pool_;
+        pool.assign_tasks(n_thread, n_task, partitioning);
+
+        std::vector<std::exception_ptr> exceptions(n_thread);
+        std::function<void(Idx)> const run_worker = [&pool, &worker_fn, &exceptions](Idx worker) {
+            try {
+                TaskSource task_source{pool, worker};
+                worker_fn(task_source);
+            } catch (...) {
+                exceptions[worker] = std::current_exception();
+            }
+        };
+
+        if (n_thread > 1) {
+            pool.dispatch(n_thread, run_worker);
+        } else {
+            run_worker(0);
+        }
+
+        for (auto const& ex : exceptions) {
+            if (ex) {
+                std::rethrow_exception(ex);
+            }
+        }
+    }
+
+  private:
+    std::unique_ptr<batch_scheduler_impl::WorkerPool> pool_;
+};
+
+} // namespace power_grid_model
+
+#endif
@@ -135,6 +135,14 @@ template <bool sym> struct MathModelParam {
     ComplexTensorVector<sym> source_param;
 };
 
+// changed parameters of some branches and shunts of a math model
+template <bool sym> struct MathModelParamIncrement {
+    IdxVector branch_param_to_change; // indices of the changed branch_param
+    std::vector<BranchCalcParam<sym>> branch_param;
+    IdxVector shunt_param_to_change; // indices of the changed shunt_param
+    ComplexTensorVector<sym> shunt_param;
+};
+
 template <bool sym> struct PowerFlowInput {
     ComplexVector source;                // Complex u_ref of each source
     ComplexValueVector<sym> s_injection; // Specified injection power of each load_gen
@@ -99,10 +99,10 @@ class Source : public Appliance {
     UpdateChange update(SourceUpdate const& update) {
         assert(update.id == id());
         bool const topo_changed = set_status(update.status);
-        bool const param_changed = set_u_ref(update.u_ref, update.u_ref_angle);
+        set_u_ref(update.u_ref, update.u_ref_angle);
         // change source connection will change both topo and param
-        // change u ref will change param
-        return {topo_changed, param_changed || topo_changed};
+        // change u ref does not change param, it is only part of the calculation input
+        return {topo_changed, topo_changed};
     }
 
   private:
@@ -9,13 +9,13 @@
 // container for multiple components
 
 #include "exception.hpp"
+#include "id_index.hpp"
 #include "power_grid_model.hpp"
 
 #include <boost/iterator/iterator_facade.hpp>
 
 #include <functional>
 #include <memory>
-#include <unordered_map>
 
 namespace power_grid_model {
 
@@ -61,11 +61,17 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     static constexpr size_t num_gettable = sizeof...(GettableTypes);
 
     // default constructor, operator
+    // the component storage and the id map are shared between copies of the container
+    // a copy of the storage of a component type is only made when the component type is modified, i.e. copy on write
+    Container()
+        : vectors_{std::make_shared<std::vector<StorageableTypes>>()...},
+          map_{std::make_shared<IdIndex>()} {}
 
     // reserve space
     template <class Storageable> void reserve(size_t size) {
-        auto& vec = std::get<std::vector<Storageable>>(vectors_);
+        auto& vec = get_vector<Storageable>();
         vec.reserve(size);
+        get_map().reserve(map_->size() + static_cast<Idx>(size));
     }
 
     // emplace component
@@ -73,17 +79,17 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
         // template<class... Args> Args&&... args perfect forwarding
         assert(!construction_complete_);
         // throw if id already exists
-        if (map_.contains(id)) {
+        if (map_->contains(id)) {
             throw ConflictID{id};
         }
         // find group and position
         auto const group = static_cast<Idx>(get_cls_pos_v<Storageable, StorageableTypes...>);
-        auto& vec = std::get<std::vector<Storageable>>(vectors_);
+        auto& vec = get_vector<Storageable>();
         auto const pos = static_cast<Idx>(vec.size());
         // create object
         vec.emplace_back(std::forward<Args>(args)...);
         // insert idx to map
-        map_[id] = Idx2D{group, pos};
+        get_map().insert(id, Idx2D{group, pos});
     }
 
     // get item based on Idx2D
@@ -103,16 +109,30 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     }
     // get idx by id
     template <class Gettable = void> Idx2D get_idx_by_id(ID id) const {
-        auto const found = map_.find(id);
-        if (found == map_.end()) {
+        Idx2D const* const found = map_->find(id);
+        if (found == nullptr) {
             throw IDNotFound{id};
         }
         if constexpr (!std::is_void_v<Gettable>) {
-            if (!is_base<Gettable>[found->second.group]) {
+            if (!is_base<Gettable>[found->group]) {
                 throw IDWrongType{id};
             }
         }
-        return found->second;
+        return *found;
+    }
+    // find idx by id, without throwing
+    // return Idx2D{-1, -1} if the id is not found or the item is not of the (sub)type Gettable
+    template <class Gettable = void> Idx2D find_idx_by_id(ID id) const noexcept {
+        Idx2D const* const found = map_->find(id);
+        if (found == nullptr) {
+            return Idx2D{-1, -1};
+        }
+        if constexpr (!std::is_void_v<Gettable>) {
+            if (!is_base<Gettable>[found->group]) {
+                return Idx2D{-1, -1};
+            }
+        }
+        return *found;
     }
     // get item based on ID
     template <class Gettable> Gettable& get_item(ID id) {
@@ -143,9 +163,17 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     template <class Gettable> Idx get_seq(ID id) const {
         assert(construction_complete_);
         std::array<Idx, num_storageable + 1> const& cum_size = cum_size_[get_cls_pos_v<Gettable, GettableTypes...>];
-        auto const found = map_.find(id);
-        assert(found != map_.end());
-        return cum_size[found->second.group] + found->second.pos;
+        Idx2D const* const found = map_->find(id);
+        assert(found != nullptr);
+        return cum_size[found->group] + found->pos;
+    }
+
+    // get sequence idx based on idx_2d
+    template <class Gettable> Idx get_seq(Idx2D idx_2d) const {
+        assert(construction_complete_);
+        std::array<Idx, num_storageable + 1> const& cum_size = cum_size_[get_cls_pos_v<Gettable, GettableTypes...>];
+        assert(is_base<Gettable>[idx_2d.group]);
+        return cum_size[idx_2d.group] + idx_2d.pos;
     }
 
     // get idx_2d based on sequence
@@ -182,6 +210,8 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
         construction_complete_ = true;
 #endif // !NDEBUG
         size_ = {size_per_type<GettableTypes>()...};
+        // use direct indexing if the IDs are dense
+        get_map().compact();
         cum_size_ = {accumulate_size_per_vector<GettableTypes>()...};
     };
 
@@ -196,8 +226,10 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     void restore_values() { (restore_values_impl<StorageableTypes>(), ...); }
 
   private:
-    std::tuple<std::vector<StorageableTypes>...> vectors_;
-    std::unordered_map<ID, Idx2D> map_;
+    // shared between copies of the container, see get_vector()
+    std::tuple<std::shared_ptr<std::vector<StorageableTypes>>...> vectors_;
+    // immutable after construction
+    std::shared_ptr<IdIndex> map_;
     std::array<Idx, num_gettable> size_;
     std::array<std::array<Idx, num_storageable + 1>, num_gettable> cum_size_;
 
@@ -208,16 +240,35 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
     bool construction_complete_{false};
 #endif // !NDEBUG
 
+    // get the storage vector of a type
+    // the mutable access copies the vector first if it is shared with other containers
+    template <class Storageable> std::vector<Storageable>& get_vector() {
+        auto& vec_ptr = std::get<std::shared_ptr<std::vector<Storageable>>>(vectors_);
+        if (vec_ptr.use_count() != 1) {
+            vec_ptr = std::make_shared<std::vector<Storageable>>(*vec_ptr);
+        }
+        return *vec_ptr;
+    }
+    template <class Storageable> std::vector<Storageable> const& get_vector() const {
+        return *std::get<std::shared_ptr<std::vector<Storageable>>>(vectors_);
+    }
+    IdIndex& get_map() {
+        if (map_.use_count() != 1) {
+            map_ = std::make_shared<IdIndex>(*map_);
+        }
+        return *map_;
+    }
+
     // get item per type
     template <class GettableBaseType, class StorageableSubType>
         requires std::derived_from<StorageableSubType, GettableBaseType>
     GettableBaseType& get_raw(Idx pos) {
-        return std::get<std::vector<StorageableSubType>>(vectors_)[pos];
+        return get_vector<StorageableSubType>()[pos];
     }
     template <class GettableBaseType, class StorageableSubType>
         requires std::derived_from<StorageableSubType, GettableBaseType>
     GettableBaseType const& get_raw(Idx pos) const {
-        return std::get<std::vector<StorageableSubType>>(vectors_)[pos];
+        return get_vector<StorageableSubType>()[pos];
     }
 
     // templates to select function pointer
@@ -244,7 +295,7 @@ class Container<RetrievableTypes<GettableTypes...>, StorageableTypes...> {
         assert(construction_complete_);
         return std::array<Idx, num_storageable>{
             std::is_base_of_v<Gettable, StorageableTypes>
-                ? static_cast<Idx>(std::get<std::vector<StorageableTypes>>(vectors_).size())
+                ? static_cast<Idx>(get_vector<StorageableTypes>().size())
                 : 0 ...};
     }
     // total size of a type
@@ -30,6 +30,7 @@ enum class CalculationMethod : IntS {
     iterative_current = 3,
     linear_current = 4,
     iec60909 = 5,
+    fast_decoupled = 6,
 };
 
 enum class MeasuredTerminalType : IntS {
@@ -96,6 +97,10 @@ enum class FaultPhase : IntS {
 
 enum class ShortCircuitVoltageScaling : IntS { minimum = 0, maximum = 1 };
 
+enum class PowerFlowInitialization : IntS { flat_start = 0, previous_solution = 1 };
+
+enum class BatchPartitioning : IntS { work_stealing = 0, contiguous = 1 };
+
 enum class CType : IntS { c_int32 = 0, c_int8 = 1, c_double = 2, c_double3 = 3 };
 
 enum class SerializationFormat : IntS { json = 0, msgpack = 1 };
@@ -135,6 +135,12 @@ class InvalidCalculationMethod : public CalculationError {
     InvalidCalculationMethod() : CalculationError("The calculation method is invalid for this calculation!") {}
 };
 
+class NotObservableError : public CalculationError {
+  public:
+    explicit NotObservableError(std::string const& msg)
+        : CalculationError("Not enough measurements available for state estimation.\n" + msg) {}
+};
+
 class UnknownAttributeName : public PowerGridError {
   public:
     explicit UnknownAttributeName(std::string const& attr_name) {
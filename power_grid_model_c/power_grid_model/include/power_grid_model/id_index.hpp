@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_ID_INDEX_HPP
+#define POWER_GRID_MODEL_ID_INDEX_HPP
+
+// index from component ID to Idx2D
+
+#include "power_grid_model.hpp"
+
+#include <bit>
+
+/*
+Flat index from ID to Idx2D, used by the component container
+
+The index has two modes
+    hash:   open addressing hash table with linear probing
+            the entries are stored in one contiguous array, the capacity is a power of two
+    dense:  direct-indexed array, entry of ID id is at position id - offset
+            used when the IDs cover a range which is not much larger than the number of IDs
+
+The index starts in hash mode.
+compact() switches to dense mode if the IDs turn out to be dense.
+An insertion which does not fit in the dense range switches back to hash mode.
+In both modes an empty entry is marked by group == -1.
+*/
+
+namespace power_grid_model {
+
+class IdIndex {
+  public:
+    // the dense array is used if the range of IDs is at most this factor times the number of IDs
+    static constexpr Idx max_dense_ratio = 2;
+
+    Idx size() const { return size_; }
+    bool is_dense() const { return dense_; }
+
+    void reserve(Idx size) {
+        if (!dense_ && capacity_for(size) > static_cast<Idx>(entries_.size())) {
+            rehash(capacity_for(size));
+        }
+    }
+
+    bool contains(ID id) const { return find(id) != nullptr; }
+
+    // return nullptr if the ID does not exist
+    Idx2D const* find(ID id) const {
+        if (dense_) {
+            Idx const pos = static_cast<Idx>(id) - offset_;
+            if (pos < 0 || pos >= static_cast<Idx>(entries_.size()) || entries_[pos].idx.group == -1) {
+                return nullptr;
+            }
+            return &entries_[pos].idx;
+        }
+        if (entries_.empty()) {
+            return nullptr;
+        }
+        for (size_t slot = hash(id);; slot = (slot + 1) & mask()) {
+            Entry const& entry = entries_[slot];
+            if (entry.idx.group == -1) {
+                return nullptr;
+            }
+            if (entry.id == id) {
+                return &entry.idx;
+            }
+        }
+    }
+
+    // insert or overwrite
+    void insert(ID id, Idx2D idx) {
+        assert(idx.group != -1);
+        if (dense_) {
+            Idx const pos = static_cast<Idx>(id) - offset_;
+            if (pos >= 0 && pos < static_cast<Idx>(entries_.size())) {
+                Entry& entry = entries_[pos];
+                size_ += (entry.idx.group == -1) ? 1 : 0;
+                entry = Entry{.idx = idx, .id = id};
+                return;
+            }
+            // out of the dense range
+            rehash(capacity_for(size_ + 1));
+        }
+        if (capacity_for(size_ + 1) > static_cast<Idx>(entries_.size())) {
+            rehash(capacity_for(size_ + 1));
+        }
+        size_t slot = hash(id);
+        while (entries_[slot].idx.group != -1 && entries_[slot].id != id) {
+            slot = (slot + 1) & mask();
+        }
+        Entry& entry = entries_[slot];
+        size_ += (entry.idx.group == -1) ? 1 : 0;
+        entry = Entry{.idx = idx, .id = id};
+    }
+
+    // switch to the direct-indexed array if the IDs are dense
+    void compact() {
+        if (dense_ || size_ == 0) {
+            return;
+        }
+        ID min_id = std::numeric_limits<ID>::max();
+        ID max_id = std::numeric_limits<ID>::min();
+        for (Entry const& entry : entries_) {
+            if (entry.idx.group != -1) {
+                min_id = std::min(min_id, entry.id);
+                max_id = std::max(max_id, entry.id);
+            }
+        }
+        Idx const range = static_cast<Idx>(max_id) - static_cast<Idx>(min_id) + 1;
+        if (range > max_dense_ratio * size_) {
+            return;
+        }
+        std::vector<Entry> dense_entries(range, empty_entry);
+        for (Entry const& entry : entries_) {
+            if (entry.idx.group != -1) {
+                dense_entries[static_cast<Idx>(entry.id) - min_id] = entry;
+            }
+        }
+        entries_ = std::move(dense_entries);
+        offset_ = min_id;
+        dense_ = true;
+    }
+
+  private:
+    struct Entry {
+        Idx2D idx;
+        ID id;
+    };
+    static constexpr Entry empty_entry{.idx = {-1, -1}, .id = 0};
+
+    // in dense mode, the entry of ID id is at id - offset_
+    // in hash mode, the size of entries_ is zero or a power of two
+    std::vector<Entry> entries_;
+    Idx size_{0};
+    Idx offset_{0};
+    bool dense_{false};
+
+    // keep the load factor at most 1/2, at least two slots such that the hash shift is valid
+    static Idx capacity_for(Idx size) {
+        return static_cast<Idx>(std::bit_ceil(static_cast<size_t>(std::max(Idx{2}, 2 * size))));
+    }
+    size_t mask() const { return entries_.size() - 1; }
+    // fibonacci hashing, the IDs are often consecutive
+    size_t hash(ID id) const {
+        constexpr uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+        auto const h = static_cast<uint64_t>(static_cast<uint32_t>(id)) * multiplier;
+        return static_cast<size_t>(h >> (64 - std::countr_zero(entries_.size()))) & mask();
+    }
+
+    // rebuild as hash table with the new capacity
+    void rehash(Idx capacity) {
+        std::vector<Entry> old_entries(capacity, empty_entry);
+        old_entries.swap(entries_);
+        dense_ = false;
+        offset_ = 0;
+        for (Entry const& entry : old_entries) {
+            if (entry.idx.group == -1) {
+                continue;
+            }
+            size_t slot = hash(entry.id);
+            while (entries_[slot].idx.group != -1) {
+                slot = (slot + 1) & mask();
+            }
+            entries_[slot] = entry;
+        }
+    }
+};
+
+} // namespace power_grid_model
+
+#endif
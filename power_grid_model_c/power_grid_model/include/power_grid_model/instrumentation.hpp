@@ -0,0 +1,246 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_INSTRUMENTATION_HPP
+#define POWER_GRID_MODEL_INSTRUMENTATION_HPP
+
+#include "power_grid_model.hpp"
+#include "timer.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+/*
+Low overhead timing of the calculation steps.
+
+An InstrumentedTimer adds its duration to a fixed-size table of counters, keyed by the integer code of the step.
+No strings are built and no memory is allocated while timing.
+The counters are only converted to a CalculationInfo when the calculation info is requested.
+
+Each thread records into the counters set by the innermost InstrumentationScope of that thread.
+Outside of any scope, the durations are recorded into counters of the thread which are never reported.
+
+Optionally, each thread can also record the begin and end of every timed step into a TraceRecorder,
+tagged with the thread and the scenario, to see how the scenarios of a batch are distributed over the threads.
+The events can be exported in the Chrome trace event format, see to_chrome_trace().
+
+Define POWER_GRID_MODEL_DISABLE_INSTRUMENTATION to compile out the timers entirely.
+*/
+
+namespace power_grid_model {
+
+class InstrumentationCounters {
+  public:
+    static constexpr Idx max_size = 32;
+
+    void add(int code, char const* name, double duration) {
+        for (Idx i = 0; i != size_; ++i) {
+            Entry& entry = entries_[i];
+            if (entry.code == code && (entry.name == name || std::string_view{entry.name} == name)) {
+                entry.duration += duration;
+                return;
+            }
+        }
+        // the number of different steps is small and fixed, more steps are not recorded
+        assert(size_ < max_size);
+        if (size_ < max_size) {
+            entries_[size_++] = {code, name, duration};
+        }
+    }
+
+    void merge(InstrumentationCounters const& other) {
+        for (Idx i = 0; i != other.size_; ++i) {
+            add(other.entries_[i].code, other.entries_[i].name, other.entries_[i].duration);
+        }
+    }
+
+    // add the durations to the calculation info
+    void collect(CalculationInfo& info) const {
+        for (Idx i = 0; i != size_; ++i) {
+            info[Timer::make_key(entries_[i].code, entries_[i].name)] += entries_[i].duration;
+        }
+    }
+
+    void clear() { size_ = 0; }
+    bool empty() const { return size_ == 0; }
+
+  private:
+    struct Entry {
+        int code;
+        char const* name;
+        double duration;
+    };
+
+    std::array<Entry, max_size> entries_{};
+    Idx size_{0};
+};
+
+// begin and end of one timed step, in microseconds since the start of the traced calculation
+struct TraceEvent {
+    int code;
+    char const* name;
+    Idx thread;
+    Idx scenario; // -1 if the step does not belong to one scenario
+    double begin;
+    double end;
+};
+
+// the trace events of one thread
+class TraceRecorder {
+  public:
+    TraceRecorder() = default;
+    TraceRecorder(Idx thread, Clock::time_point origin) : thread_{thread}, origin_{origin} {}
+
+    // tag the next events with the given scenario
+    void set_scenario(Idx scenario) { scenario_ = scenario; }
+
+    void add(int code, char const* name, Clock::time_point begin, Clock::time_point end) {
+        events_.push_back({code, name, thread_, scenario_, to_microseconds(begin), to_microseconds(end)});
+    }
+
+    std::vector<TraceEvent> const& events() const { return events_; }
+    std::vector<TraceEvent> take_events() { return std::move(events_); }
+
+  private:
+    Idx thread_{0};
+    Idx scenario_{-1};
+    Clock::time_point origin_{};
+    std::vector<TraceEvent> events_;
+
+    double to_microseconds(Clock::time_point time) const {
+        return std::chrono::duration<double, std::micro>(time - origin_).count();
+    }
+};
+
+// convert the events to a JSON document in the Chrome trace event format
+// the document can be opened with chrome://tracing or https://ui.perfetto.dev
+inline std::string to_chrome_trace(std::vector<TraceEvent> const& events) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+    for (auto it = events.cbegin(); it != events.cend(); ++it) {
+        if (it != events.cbegin()) {
+            out << ",";
+        }
+        out << "\n{\"name\":\"";
+        // the names are fixed literals, only quotes and backslashes need escaping
+        for (char const* c = it->name; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\') {
+                out << '\\';
+            }
+            out << *c;
+        }
+        out << "\",\"cat\":\"calculation\",\"ph\":\"X\",\"pid\":0,\"tid\":" << it->thread
+            << ",\"ts\":" << it->begin << ",\"dur\":" << (it->end - it->begin) << ",\"args\":{\"code\":" << it->code
+            << ",\"scenario\":" << it->scenario << "}}";
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out.str();
+}
+
+#ifndef POWER_GRID_MODEL_DISABLE_INSTRUMENTATION
+
+// record the timers of the current thread into the given counters during the lifetime of the scope
+class InstrumentationScope {
+  public:
+    explicit InstrumentationScope(InstrumentationCounters& counters) : previous_{current_} { current_ = &counters; }
+    ~InstrumentationScope() { current_ = previous_; }
+
+    InstrumentationScope(InstrumentationScope const&) = delete;
+    InstrumentationScope& operator=(InstrumentationScope const&) = delete;
+
+    static InstrumentationCounters& current() {
+        if (current_ == nullptr) {
+            thread_local InstrumentationCounters unreported;
+            unreported.clear();
+            return unreported;
+        }
+        return *current_;
+    }
+
+  private:
+    static inline thread_local InstrumentationCounters* current_{nullptr};
+    InstrumentationCounters* previous_;
+};
+
+// record the begin and end of the timers of the current thread into the given recorder during the lifetime of the scope
+// tracing is disabled in the scope if the recorder is nullptr
+class TraceScope {
+  public:
+    explicit TraceScope(TraceRecorder* recorder) : previous_{current_} { current_ = recorder; }
+    ~TraceScope() { current_ = previous_; }
+
+    TraceScope(TraceScope const&) = delete;
+    TraceScope& operator=(TraceScope const&) = delete;
+
+    static TraceRecorder* current() { return current_; }
+
+  private:
+    static inline thread_local TraceRecorder* current_{nullptr};
+    TraceRecorder* previous_;
+};
+
+class InstrumentedTimer {
+  public:
+    InstrumentedTimer() = default;
+    InstrumentedTimer(int code, char const* name) : code_{code}, name_{name}, start_{Clock::now()} {}
+
+    InstrumentedTimer(InstrumentedTimer const&) = delete;
+    InstrumentedTimer& operator=(InstrumentedTimer const&) = delete;
+
+    // stop the current timer and take over the other one
+    InstrumentedTimer& operator=(InstrumentedTimer&& timer) noexcept {
+        stop();
+        code_ = timer.code_;
+        name_ = timer.name_;
+        start_ = timer.start_;
+        timer.name_ = nullptr;
+        return *this;
+    }
+
+    ~InstrumentedTimer() { stop(); }
+
+    void stop() {
+        if (name_ != nullptr) {
+            auto const now = Clock::now();
+            InstrumentationScope::current().add(code_, name_, Duration(now - start_).count());
+            if (TraceRecorder* const recorder = TraceScope::current(); recorder != nullptr) {
+                recorder->add(code_, name_, start_, now);
+            }
+            name_ = nullptr;
+        }
+    }
+
+  private:
+    int code_{};
+    char const* name_{nullptr};
+    Clock::time_point start_;
+};
+
+#else
+
+class InstrumentationScope {
+  public:
+    explicit InstrumentationScope(InstrumentationCounters& /* counters */) {}
+};
+
+class TraceScope {
+  public:
+    explicit TraceScope(TraceRecorder* /* recorder */) {}
+};
+
+class InstrumentedTimer {
+  public:
+    InstrumentedTimer() = default;
+    InstrumentedTimer(int /* code */, char const* /* name */) {}
+    void stop() {}
+};
+
+#endif
+
+} // namespace power_grid_model
+
+#endif // POWER_GRID_MODEL_INSTRUMENTATION_HPP
@@ -7,23 +7,59 @@
 #define POWER_GRID_MODEL_MAIN_CORE_CALCULATION_INFO_HPP
 
 #include "../power_grid_model.hpp"
+#include "../timer.hpp"
+
+#include <algorithm>
+#include <array>
 
 namespace power_grid_model::main_core {
 
-inline CalculationInfo merge_calculation_info(std::vector<CalculationInfo> const& infos) {
-    CalculationInfo result;
+// keys of the power flow and state estimation number of iterations, and of the final deviation
+inline std::array<std::string, 3> const& maximum_calculation_info_keys() {
+    static std::array<std::string, 3> const keys{Timer::make_key(2226, "Max number of iterations"),
+                                                 Timer::make_key(2228, "Max number of iterations"),
+                                                 Timer::make_key(2229, "Max final deviation")};
+    return keys;
+}
 
-    const auto key = Timer::make_key(2226, "Max number of iterations");
-    for (auto const& info : infos) {
-        for (auto const& [k, v] : info) {
-            if (k == key) {
-                result[k] = std::max(result[k], v);
-            } else {
-                result[k] += v;
-            }
+// add the entries of source to destination
+// the timings are summed, the number of iterations and the final deviation are the maximum of both
+inline void merge_calculation_info_into(CalculationInfo& destination, CalculationInfo const& source) {
+    auto const& maximum_keys = maximum_calculation_info_keys();
+    for (auto const& [k, v] : source) {
+        if (std::ranges::find(maximum_keys, k) != maximum_keys.cend()) {
+            destination[k] = std::max(destination[k], v);
+        } else {
+            destination[k] += v;
         }
     }
+}
 
+// write the statistics of one scenario, from the calculation info of that scenario only
+inline void record_scenario_statistics(ScenarioStatistics const& statistics, Idx scenario, CalculationInfo const& info,
+                                       double wall_time) {
+    auto const& maximum_keys = maximum_calculation_info_keys();
+    auto const get_value = [&info](std::string const& key, double default_value) {
+        auto const found = info.find(key);
+        return found == info.cend() ? default_value : found->second;
+    };
+    if (statistics.n_iterations != nullptr) {
+        statistics.n_iterations[scenario] =
+            static_cast<Idx>(std::max(get_value(maximum_keys[0], 0.0), get_value(maximum_keys[1], 0.0)));
+    }
+    if (statistics.max_deviation != nullptr) {
+        statistics.max_deviation[scenario] = get_value(maximum_keys[2], nan);
+    }
+    if (statistics.wall_time != nullptr) {
+        statistics.wall_time[scenario] = wall_time;
+    }
+}
+
+inline CalculationInfo merge_calculation_info(std::vector<CalculationInfo> const& infos) {
+    CalculationInfo result;
+    for (auto const& info : infos) {
+        merge_calculation_info_into(result, info);
+    }
     return result;
 }
 
@@ -6,6 +6,7 @@
 #ifndef POWER_GRID_MODEL_MAIN_CORE_MATH_STATE_HPP
 #define POWER_GRID_MODEL_MAIN_CORE_MATH_STATE_HPP
 
+#include "../math_solver/math_solver.hpp"
 #include "../math_solver/y_bus.hpp"
 
 namespace power_grid_model::main_core {
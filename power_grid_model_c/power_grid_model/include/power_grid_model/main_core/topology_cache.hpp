@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_MAIN_CORE_TOPOLOGY_CACHE_HPP
+#define POWER_GRID_MODEL_MAIN_CORE_TOPOLOGY_CACHE_HPP
+
+#include "math_state.hpp"
+
+#include "../calculation_parameters.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+
+namespace power_grid_model::main_core {
+
+// math models (topology, Y bus and solvers) of previously built topologies,
+//     keyed by the component connections they are built from
+// the cache is not copied with the model, so every copy (e.g. per batch thread) keeps its own
+// the cache is disabled (zero capacity) by default
+class TopologyCache {
+  public:
+    struct Entry {
+        ComponentConnections comp_conn;
+        std::vector<std::shared_ptr<MathModelTopology const>> math_topology;
+        std::shared_ptr<TopologicalComponentToMathCoupling const> topo_comp_coup;
+        MathState math_state;
+    };
+
+    static constexpr Idx default_capacity = 8;
+
+    TopologyCache() = default;
+    TopologyCache(TopologyCache const& /* other */) : TopologyCache{} {}
+    TopologyCache& operator=(TopologyCache const& /* other */) {
+        clear();
+        return *this;
+    }
+    TopologyCache(TopologyCache&&) noexcept = default;
+    TopologyCache& operator=(TopologyCache&&) noexcept = default;
+    ~TopologyCache() = default;
+
+    Idx capacity() const { return capacity_; }
+    Idx size() const { return static_cast<Idx>(entries_.size()); }
+
+    void set_capacity(Idx capacity) {
+        capacity_ = capacity;
+        evict();
+    }
+
+    void clear() {
+        entries_.clear();
+        keys_.clear();
+    }
+
+    // hash of the switching statuses
+    static size_t hash(ComponentConnections const& comp_conn) {
+        size_t seed = 0;
+        auto const combine = [&seed](IntS status) {
+            seed ^= std::hash<IntS>{}(status) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        };
+        for (auto const& connected : comp_conn.branch_connected) {
+            std::for_each(connected.cbegin(), connected.cend(), combine);
+        }
+        for (auto const& connected : comp_conn.branch3_connected) {
+            std::for_each(connected.cbegin(), connected.cend(), combine);
+        }
+        std::for_each(comp_conn.source_connected.cbegin(), comp_conn.source_connected.cend(), combine);
+        return seed;
+    }
+
+    // take the entry built from the same connections out of the cache, if any
+    std::optional<Entry> take(ComponentConnections const& comp_conn) {
+        size_t const key = hash(comp_conn);
+        for (Idx i = 0; i != size(); ++i) {
+            if (keys_[i] == key && is_equal(entries_[i].comp_conn, comp_conn)) {
+                std::optional<Entry> result{std::move(entries_[i])};
+                entries_.erase(entries_.begin() + i);
+                keys_.erase(keys_.begin() + i);
+                return result;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // store an entry, the least recently stored entries are evicted if the capacity is exceeded
+    void store(Entry&& entry) {
+        if (capacity_ <= 0) {
+            return;
+        }
+        keys_.push_back(hash(entry.comp_conn));
+        entries_.push_back(std::move(entry));
+        evict();
+    }
+
+  private:
+    Idx capacity_{0};
+    // ordered from least to most recently stored
+    std::vector<Entry> entries_;
+    std::vector<size_t> keys_;
+
+    static bool is_equal(ComponentConnections const& x, ComponentConnections const& y) {
+        return x.branch_connected == y.branch_connected && x.branch3_connected == y.branch3_connected &&
+               x.source_connected == y.source_connected && x.branch_phase_shift == y.branch_phase_shift &&
+               x.branch3_phase_shift == y.branch3_phase_shift;
+    }
+
+    void evict() {
+        auto const n_evict = std::max(Idx{0}, size() - std::max(Idx{0}, capacity_));
+        entries_.erase(entries_.begin(), entries_.begin() + n_evict);
+        keys_.erase(keys_.begin(), keys_.begin() + n_evict);
+    }
+};
+
+} // namespace power_grid_model::main_core
+
+#endif
@@ -10,17 +10,91 @@
 
 #include "../all_components.hpp"
 
+#include <span>
+
 namespace power_grid_model::main_core {
 
+// sequence indices of the updated components of one type, for all scenarios of a batch
+// the sequence indices of scenario pos are idx[indptr[pos]:indptr[pos + 1]]
+// if indptr is empty, the update is independent and all scenarios use the same sequence indices
+// an entry {-1, -1} means the ID is not found or has the wrong type, the update will raise the error
+struct SequenceIdx {
+    std::vector<Idx2D> idx;
+    IdxVector indptr;
+
+    std::span<Idx2D const> scenario(Idx pos) const {
+        if (indptr.empty()) {
+            return idx;
+        }
+        return std::span{idx}.subspan(indptr[pos], indptr[pos + 1] - indptr[pos]);
+    }
+};
+using SequenceIdxMap = std::map<std::string, SequenceIdx, std::less<>>;
+
+// sequence numbers of the branches, branch3s and shunts of which only the parameters changed
+// they are used to update the math model parameters and the Y bus incrementally
+struct ParameterChanges {
+    // if true, the changes are not tracked and all the parameters need to be re-calculated
+    bool all{false};
+    IdxVector branch;
+    IdxVector branch3;
+    IdxVector shunt;
+
+    Idx size() const { return static_cast<Idx>(branch.size() + branch3.size() + shunt.size()); }
+    bool empty() const { return !all && size() == 0; }
+
+    void set_all() {
+        clear();
+        all = true;
+    }
+    void clear() {
+        all = false;
+        branch.clear();
+        branch3.clear();
+        shunt.clear();
+    }
+    // merge other changes, fall back to all when more than max_size changes are tracked
+    void merge(ParameterChanges const& other, Idx max_size) {
+        if (all) {
+            return;
+        }
+        if (other.all || size() + other.size() > max_size) {
+            set_all();
+            return;
+        }
+        branch.insert(branch.end(), other.branch.cbegin(), other.branch.cend());
+        branch3.insert(branch3.end(), other.branch3.cbegin(), other.branch3.cend());
+        shunt.insert(shunt.end(), other.shunt.cbegin(), other.shunt.cend());
+    }
+};
+
+// register a component of which only the parameters changed
+template <std::derived_from<Base> Component, class ComponentContainer>
+    requires model_component_state<MainModelState, ComponentContainer, Component>
+void register_parameter_change(MainModelState<ComponentContainer> const& state, Idx2D const& sequence_single,
+                               ParameterChanges& param_changes) {
+    if constexpr (std::derived_from<Component, Branch>) {
+        param_changes.branch.push_back(state.components.template get_seq<Branch>(sequence_single));
+    } else if constexpr (std::derived_from<Component, Branch3>) {
+        param_changes.branch3.push_back(state.components.template get_seq<Branch3>(sequence_single));
+    } else if constexpr (std::derived_from<Component, Shunt>) {
+        param_changes.shunt.push_back(state.components.template get_seq<Shunt>(sequence_single));
+    } else {
+        // other components do not contribute to the math model parameters in a tracked way
+        param_changes.all = true;
+    }
+}
+
 // template to update components
 // using forward interators
 // different selection based on component type
 // if sequence_idx is given, it will be used to load the object instead of using IDs via hash map.
+// the components of which only the parameters changed are registered in param_changes
 template <std::derived_from<Base> Component, class CacheType, class ComponentContainer,
           std::forward_iterator ForwardIterator>
     requires model_component_state<MainModelState, ComponentContainer, Component>
 UpdateChange update_component(MainModelState<ComponentContainer>& state, ForwardIterator begin, ForwardIterator end,
-                              std::vector<Idx2D> const& sequence_idx = {}) {
+                              std::span<Idx2D const> sequence_idx, ParameterChanges& param_changes) {
     bool const has_sequence_id = !sequence_idx.empty();
     Idx seq = 0;
 
@@ -31,8 +105,10 @@ UpdateChange update_component(MainModelState<ComponentContainer>& state, Forward
         // get component
         // either using ID via hash map
         // either directly using sequence id
-        Idx2D const sequence_single =
-            has_sequence_id ? sequence_idx[seq] : state.components.template get_idx_by_id<Component>(it->id);
+        // an unknown sequence id is looked up again via the hash map, to raise the error
+        Idx2D const sequence_single = has_sequence_id && sequence_idx[seq].group != -1
+                                          ? sequence_idx[seq]
+                                          : state.components.template get_idx_by_id<Component>(it->id);
 
         if constexpr (CacheType::value) {
             state.components.template cache_item<Component>(sequence_single.pos);
@@ -40,12 +116,25 @@ UpdateChange update_component(MainModelState<ComponentContainer>& state, Forward
 
         auto& comp = state.components.template get_item<Component>(sequence_single);
 
-        changed = changed || comp.update(*it);
+        UpdateChange const comp_changed = comp.update(*it);
+        if (comp_changed.param && !comp_changed.topo) {
+            register_parameter_change<Component>(state, sequence_single, param_changes);
+        }
+        changed = changed || comp_changed;
     }
 
     return changed;
 }
 
+template <std::derived_from<Base> Component, class CacheType, class ComponentContainer,
+          std::forward_iterator ForwardIterator>
+    requires model_component_state<MainModelState, ComponentContainer, Component>
+UpdateChange update_component(MainModelState<ComponentContainer>& state, ForwardIterator begin, ForwardIterator end,
+                              std::span<Idx2D const> sequence_idx = {}) {
+    ParameterChanges param_changes;
+    return update_component<Component, CacheType>(state, begin, end, sequence_idx, param_changes);
+}
+
 template <bool sym>
 void update_y_bus(YBus<sym>& y_bus, std::shared_ptr<MathModelParam<sym> const> const& math_model_param) {
     y_bus.update_admittance(math_model_param);
@@ -66,6 +155,18 @@ void update_y_bus(MathState& math_state, std::vector<MathModelParam<sym>> const&
     }
 }
 
+template <bool sym>
+void update_y_bus(MathState& math_state, std::vector<MathModelParamIncrement<sym>> const& math_model_param_increments,
+                  Idx n_math_solvers) {
+    for (Idx i = 0; i != n_math_solvers; ++i) {
+        if constexpr (sym) {
+            math_state.y_bus_vec_sym[i].update_admittance_increment(math_model_param_increments[i]);
+        } else {
+            math_state.y_bus_vec_asym[i].update_admittance_increment(math_model_param_increments[i]);
+        }
+    }
+}
+
 } // namespace power_grid_model::main_core
 
 #endif
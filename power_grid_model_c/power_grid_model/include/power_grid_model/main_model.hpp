@@ -9,9 +9,11 @@
 // main model class
 
 // main include
+#include "batch_scheduler.hpp"
 #include "calculation_parameters.hpp"
 #include "container.hpp"
 #include "exception.hpp"
+#include "instrumentation.hpp"
 #include "power_grid_model.hpp"
 #include "timer.hpp"
 #include "topology.hpp"
@@ -31,6 +33,7 @@
 #include "main_core/math_state.hpp"
 #include "main_core/output.hpp"
 #include "main_core/topology.hpp"
+#include "main_core/topology_cache.hpp"
 #include "main_core/update.hpp"
 
 // threading
@@ -79,12 +82,13 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     // function pointer definition
     using InputFunc = void (*)(MainModelImpl& x, DataPointer<true> const& data_ptr, Idx position);
     using UpdateFunc = void (*)(MainModelImpl& x, DataPointer<true> const& data_ptr, Idx position,
-                                std::vector<Idx2D> const& sequence_idx);
+                                std::span<Idx2D const> sequence_idx);
     template <math_output_type MathOutputType>
     using OutputFunc = void (*)(MainModelImpl& x, std::vector<MathOutputType> const& math_output,
                                 DataPointer<false> const& data_ptr, Idx position);
     using CheckUpdateFunc = bool (*)(ConstDataPointer const& component_update);
-    using GetSeqIdxFunc = std::vector<Idx2D> (*)(MainModelImpl const& x, ConstDataPointer const& component_update);
+    using GetSeqIdxFunc = main_core::SequenceIdx (*)(MainModelImpl& x, ConstDataPointer const& component_update,
+                                                     Idx n_thread);
     using GetIndexerFunc = void (*)(MainModelImpl const& x, ID const* id_begin, Idx size, Idx* indexer_begin);
 
     static constexpr Idx ignore_output{-1};
@@ -123,6 +127,11 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         return state_.components.template size<CompType>();
     }
 
+    // get component by id, read-only, such that the storage is not copied if it is shared with other models
+    template <class CompType> CompType const& get_component(ID id) const {
+        return state_.components.template get_item<CompType>(id);
+    }
+
     // all component count
     std::map<std::string, Idx> all_component_count() const {
         std::map<std::string, Idx> map;
@@ -155,15 +164,18 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     // different selection based on component type
     // if sequence_idx is given, it will be used to load the object instead of using IDs via hash map.
     template <class CompType, class CacheType, std::forward_iterator ForwardIterator>
-    void update_component(ForwardIterator begin, ForwardIterator end, std::vector<Idx2D> const& sequence_idx = {}) {
+    void update_component(ForwardIterator begin, ForwardIterator end, std::span<Idx2D const> sequence_idx = {}) {
         assert(construction_complete_);
 
-        UpdateChange const changed = main_core::update_component<CompType, CacheType>(state_, begin, end, sequence_idx);
+        main_core::ParameterChanges param_changes;
+        UpdateChange const changed =
+            main_core::update_component<CompType, CacheType>(state_, begin, end, sequence_idx, param_changes);
 
         // update, get changed variable
-        update_state(changed);
+        update_state(changed, param_changes);
         if constexpr (CacheType::value) {
             cached_state_changes_ = cached_state_changes_ || changed;
+            cached_param_changes_.merge(param_changes, max_tracked_parameter_changes());
         }
     }
 
@@ -176,10 +188,10 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     // update all components
     template <class CacheType>
     void update_component(ConstDataset const& update_data, Idx pos = 0,
-                          std::map<std::string, std::vector<Idx2D>, std::less<>> const& sequence_idx_map = {}) {
+                          main_core::SequenceIdxMap const& sequence_idx_map = {}) {
         static constexpr std::array<UpdateFunc, n_types> update{[](MainModelImpl& model,
                                                                    DataPointer<true> const& data_ptr, Idx position,
-                                                                   std::vector<Idx2D> const& sequence_idx) {
+                                                                   std::span<Idx2D const> sequence_idx) {
             auto const [begin, end] = data_ptr.get_iterators<typename ComponentType::UpdateType>(position);
             model.update_component<ComponentType, CacheType>(begin, end, sequence_idx);
         }...};
@@ -196,7 +208,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 update[entry.index](*this, found->second, pos, {});
             } else {
                 // else update using pre-cached sequence number
-                update[entry.index](*this, found->second, pos, found_seq->second);
+                update[entry.index](*this, found->second, pos, found_seq->second.scenario(pos));
             }
         }
     }
@@ -205,8 +217,9 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     void restore_components() {
         state_.components.restore_values();
 
-        update_state(cached_state_changes_);
+        update_state(cached_state_changes_, cached_param_changes_);
         cached_state_changes_ = {};
+        cached_param_changes_.clear();
     }
 
     // set complete construction
@@ -239,11 +252,14 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         is_topology_up_to_date_ = false;
         is_sym_parameter_up_to_date_ = false;
         is_asym_parameter_up_to_date_ = false;
+        sym_param_changes_.set_all();
+        asym_param_changes_.set_all();
         n_math_solvers_ = 0;
         main_core::clear(math_state_);
         state_.math_topology.clear();
         state_.topo_comp_coup.reset();
         state_.comp_coup = {};
+        built_topo_comp_coup_.reset();
     }
 
     /*
@@ -266,12 +282,26 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     }
 
   private:
-    void update_state(const UpdateChange& changes) {
+    void update_state(const UpdateChange& changes, main_core::ParameterChanges const& param_changes) {
         // if topology changed, everything is not up to date
         // if only param changed, set param to not up to date
         is_topology_up_to_date_ = is_topology_up_to_date_ && !changes.topo;
         is_sym_parameter_up_to_date_ = is_sym_parameter_up_to_date_ && !changes.topo && !changes.param;
         is_asym_parameter_up_to_date_ = is_asym_parameter_up_to_date_ && !changes.topo && !changes.param;
+        // keep track of the components with changed parameters, for the incremental update of the Y bus
+        if (changes.topo) {
+            sym_param_changes_.set_all();
+            asym_param_changes_.set_all();
+        } else {
+            sym_param_changes_.merge(param_changes, max_tracked_parameter_changes());
+            asym_param_changes_.merge(param_changes, max_tracked_parameter_changes());
+        }
+    }
+
+    // above this number of tracked parameter changes, all the parameters are re-calculated
+    Idx max_tracked_parameter_changes() const {
+        return static_cast<Idx>(state_.comp_topo->branch_node_idx.size() + state_.comp_topo->branch3_node_idx.size() +
+                                state_.comp_topo->shunt_node_idx.size());
     }
 
     template <math_output_type MathOutputType, typename MathSolverType, typename YBus, typename InputType,
@@ -286,20 +316,23 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
 
         assert(construction_complete_);
         calculation_info_ = CalculationInfo{};
+        instrumentation_.clear();
+        InstrumentationScope const scope{instrumentation_};
         // prepare
         auto const& input = [this, &prepare_input] {
-            Timer const timer(calculation_info_, 2100, "Prepare");
+            InstrumentedTimer const timer(2100, "Prepare");
             prepare_solvers<sym>();
             return prepare_input();
         }();
         // calculate
         return [this, &input, &solve] {
-            Timer const timer(calculation_info_, 2200, "Math Calculation");
+            InstrumentedTimer const timer(2200, "Math Calculation");
             auto& solvers = get_solvers<sym>();
             auto& y_bus_vec = get_y_bus<sym>();
             std::vector<MathOutputType> math_output;
             math_output.reserve(n_math_solvers_);
             for (Idx i = 0; i != n_math_solvers_; ++i) {
+                solvers[i].set_threading(n_factorization_thread_);
                 math_output.emplace_back(solve(solvers[i], y_bus_vec[i], input[i]));
             }
             return math_output;
@@ -308,12 +341,14 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
 
     template <bool sym>
     std::vector<MathOutput<sym>> calculate_power_flow_(double err_tol, Idx max_iter,
-                                                       CalculationMethod calculation_method) {
+                                                       CalculationMethod calculation_method,
+                                                       PowerFlowInitialization initialization) {
         return calculate_<MathOutput<sym>, MathSolver<sym>, YBus<sym>, PowerFlowInput<sym>>(
             [this] { return prepare_power_flow_input<sym>(); },
-            [this, err_tol, max_iter, calculation_method](MathSolver<sym>& solver, YBus<sym> const& y_bus,
-                                                          PowerFlowInput<sym> const& input) {
-                return solver.run_power_flow(input, err_tol, max_iter, calculation_info_, calculation_method, y_bus);
+            [this, err_tol, max_iter, calculation_method, initialization](
+                MathSolver<sym>& solver, YBus<sym> const& y_bus, PowerFlowInput<sym> const& input) {
+                return solver.run_power_flow(input, err_tol, max_iter, calculation_info_, calculation_method, y_bus,
+                                             initialization);
             });
     }
 
@@ -340,29 +375,94 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
             });
     }
 
+    // short circuit calculation of both voltage scaling cases, which only differ in the source voltages
+    // the first outputs are for voltage_scaling, the second for the opposite voltage scaling
+    // both cases are solved with the same factorization
+    template <bool sym>
+    std::array<std::vector<ShortCircuitMathOutput<sym>>, 2>
+    calculate_short_circuit_paired_(ShortCircuitVoltageScaling voltage_scaling, CalculationMethod calculation_method) {
+        assert(construction_complete_);
+        calculation_info_ = CalculationInfo{};
+        instrumentation_.clear();
+        InstrumentationScope const scope{instrumentation_};
+        // prepare
+        auto [input, paired_input] = [this, voltage_scaling] {
+            InstrumentedTimer const timer(2100, "Prepare");
+            prepare_solvers<sym>();
+            return std::pair{prepare_short_circuit_input<sym>(voltage_scaling),
+                             prepare_short_circuit_input<sym>(paired_voltage_scaling(voltage_scaling))};
+        }();
+        // calculate
+        InstrumentedTimer const timer(2200, "Math Calculation");
+        auto& solvers = get_solvers<sym>();
+        auto& y_bus_vec = get_y_bus<sym>();
+        std::array<std::vector<ShortCircuitMathOutput<sym>>, 2> math_output;
+        for (Idx i = 0; i != n_math_solvers_; ++i) {
+            solvers[i].set_threading(n_factorization_thread_);
+            std::array const cases{std::move(input[i]), std::move(paired_input[i])};
+            auto outputs = solvers[i].run_short_circuit(cases, calculation_info_, calculation_method, y_bus_vec[i]);
+            math_output[0].push_back(std::move(outputs[0]));
+            math_output[1].push_back(std::move(outputs[1]));
+        }
+        return math_output;
+    }
+
+    static constexpr ShortCircuitVoltageScaling paired_voltage_scaling(ShortCircuitVoltageScaling voltage_scaling) {
+        return voltage_scaling == ShortCircuitVoltageScaling::minimum ? ShortCircuitVoltageScaling::maximum
+                                                                      : ShortCircuitVoltageScaling::minimum;
+    }
+
     // get sequence idx map for fast caching of component sequences
-    // only applicable for independent update dataset
-    std::map<std::string, std::vector<Idx2D>, std::less<>> get_sequence_idx_map(ConstDataset const& update_data) const {
+    // for an independent component update, the sequence indices of the first scenario are used for all scenarios
+    // otherwise the sequence indices of all scenarios are looked up in parallel, in n_thread threads
+    main_core::SequenceIdxMap get_sequence_idx_map(ConstDataset const& update_data, Idx n_thread) {
         // function pointer array to get cached idx
         static constexpr std::array<GetSeqIdxFunc, n_types> get_seq_idx{
-            [](MainModelImpl const& model, ConstDataPointer const& component_update) -> std::vector<Idx2D> {
+            [](MainModelImpl& model, ConstDataPointer const& component_update,
+               Idx n_thread_) -> main_core::SequenceIdx {
                 using UpdateType = typename ComponentType::UpdateType;
                 // no batch
                 if (component_update.batch_size() < 1) {
                     return {};
                 }
-                // begin and end of the first batch
-                auto const [it_begin, it_end] = component_update.template get_iterators<UpdateType>(0);
-                // vector
-                std::vector<Idx2D> seq_idx(std::distance(it_begin, it_end));
-                std::transform(it_begin, it_end, seq_idx.begin(), [&model](UpdateType const& update) {
-                    return model.state_.components.template get_idx_by_id<ComponentType>(update.id);
-                });
+                // the IDs which are not found are marked, the error is raised when updating that scenario
+                auto const get_idx = [&model](UpdateType const& update) {
+                    return model.state_.components.template find_idx_by_id<ComponentType>(update.id);
+                };
+
+                main_core::SequenceIdx seq_idx;
+                if (is_component_update_independent<ComponentType>(component_update)) {
+                    // begin and end of the first batch
+                    auto const [it_begin, it_end] = component_update.template get_iterators<UpdateType>(0);
+                    seq_idx.idx.resize(std::distance(it_begin, it_end));
+                    std::transform(it_begin, it_end, seq_idx.idx.begin(), get_idx);
+                    return seq_idx;
+                }
+
+                // the sequence indices have the same layout as the update data
+                Idx const n_batch = component_update.batch_size();
+                UpdateType const* const data_begin = component_update.template get_iterators<UpdateType>(-1).first;
+                seq_idx.indptr.resize(n_batch + 1);
+                for (Idx batch = 0; batch != n_batch; ++batch) {
+                    auto const [it_begin, it_end] = component_update.template get_iterators<UpdateType>(batch);
+                    seq_idx.indptr[batch] = std::distance(data_begin, it_begin);
+                    seq_idx.indptr[batch + 1] = std::distance(data_begin, it_end);
+                }
+                seq_idx.idx.resize(seq_idx.indptr.back());
+                auto const fill_scenarios = [&component_update, &seq_idx, &get_idx,
+                                             data_begin](BatchScheduler::TaskSource& task_source) {
+                    for (Idx batch = task_source.next(); batch != -1; batch = task_source.next()) {
+                        auto const [it_begin, it_end] = component_update.template get_iterators<UpdateType>(batch);
+                        std::transform(it_begin, it_end, seq_idx.idx.begin() + std::distance(data_begin, it_begin),
+                                       get_idx);
+                    }
+                };
+                model.batch_scheduler_.run(n_thread_, n_batch, fill_scenarios);
                 return seq_idx;
             }...};
 
         // fill in the map per component type
-        std::map<std::string, std::vector<Idx2D>, std::less<>> sequence_idx_map;
+        main_core::SequenceIdxMap sequence_idx_map;
         for (ComponentEntry const& entry : AllComponents::component_index_map) {
             auto const found = update_data.find(entry.name);
             // skip if component does not exist
@@ -370,11 +470,12 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 continue;
             }
             // add
-            sequence_idx_map[entry.name] = get_seq_idx[entry.index](*this, found->second);
+            sequence_idx_map[entry.name] = get_seq_idx[entry.index](*this, found->second, n_thread);
         }
         return sequence_idx_map;
     }
 
+  public:
     /*
     run the calculation function in batch on the provided update data.
 
@@ -385,19 +486,46 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         < 0 sequential
         = 0 parallel, use number of hardware threads
         > 0 specify number of parallel threads
+    the parallel threads are kept alive in the batch scheduler between calls.
+    partitioning
+        work_stealing: idle threads help threads with expensive scenarios
+        contiguous: each thread calculates one contiguous block of scenarios in order,
+            such that the solver state carries over between consecutive scenarios, e.g. in a time series
+    if there is no batch, the threads are used to parallelize the sparse LU factorization of the single calculation.
     raise a BatchCalculationError if any of the calculations in the batch raised an exception
     */
     template <typename Calculate>
         requires std::invocable<std::remove_cvref_t<Calculate>, MainModelImpl&, Dataset const&, Idx>
     BatchParameter batch_calculation_(Calculate&& calculation_fn, Dataset const& result_data,
-                                      ConstDataset const& update_data, Idx threading = -1) {
+                                      ConstDataset const& update_data, Idx threading = -1,
+                                      BatchPartitioning partitioning = BatchPartitioning::work_stealing) {
         // if the update batch is one empty map without any component
         // execute one power flow in the current instance, no batch calculation is needed
         // NOTE: if the map is not empty but the datasets inside are empty
         //     that will be considered as a zero batch_size
         bool const all_empty = update_data.empty();
+        auto const trace_origin = Clock::now();
+        trace_.clear();
         if (all_empty) {
-            calculation_fn(*this, result_data, 0);
+            // the threads are used to parallelize the sparse LU factorization of the single calculation
+            n_factorization_thread_ = get_n_thread(threading);
+            auto const start = Clock::now();
+            TraceRecorder recorder{0, trace_origin};
+            recorder.set_scenario(0);
+            try {
+                TraceScope const trace_scope{tracing_ ? &recorder : nullptr};
+                calculation_fn(*this, result_data, 0);
+            } catch (...) {
+                n_factorization_thread_ = 1;
+                main_core::record_scenario_statistics(scenario_statistics_, 0, calculation_info_,
+                                                      Duration(Clock::now() - start).count());
+                trace_ = recorder.take_events();
+                throw;
+            }
+            n_factorization_thread_ = 1;
+            main_core::record_scenario_statistics(scenario_statistics_, 0, calculation_info_,
+                                                  Duration(Clock::now() - start).count());
+            trace_ = recorder.take_events();
             return BatchParameter{};
         }
 
@@ -414,8 +542,55 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
 
         // calculate once to cache topology, ignore results, all math solvers are initialized
+        // each worker calculates one scenario per task
+        run_batch_workers_(
+            update_data, n_batch, n_batch, threading, partitioning, trace_origin,
+            [this, &calculation_fn] { calculation_fn(*this, {}, ignore_output); },
+            [&calculation_fn, &result_data, &update_data](MainModelImpl& model,
+                                                            main_core::SequenceIdxMap const& sequence_idx_map,
+                                                            BatchThreadInfo& thread_info, Idx batch_number) {
+                auto const start = Clock::now();
+                thread_info.trace.set_scenario(batch_number);
+                InstrumentedTimer const t_total_single(0100, "Total single calculation in thread");
+                // try to update model and run calculation
+                catch_scenario_error(thread_info, batch_number, [&] {
+                    {
+                        InstrumentedTimer const t_update_model(1200, "Update model");
+                        model.template update_component<cached_update_t>(update_data, batch_number, sequence_idx_map);
+                    }
+                    calculation_fn(model, result_data, batch_number);
+                    {
+                        InstrumentedTimer const t_update_model(1201, "Restore model");
+                        model.restore_components();
+                    }
+                });
+                main_core::record_scenario_statistics(model.scenario_statistics_, batch_number,
+                                                      model.calculation_info_, Duration(Clock::now() - start).count());
+            });
+
+        return BatchParameter{};
+    }
+
+  private:
+    /*
+    run the tasks of a batch calculation of n_batch scenarios in parallel.
+
+    The calculation is prepared once in the current instance, such that the topology is cached and all math solvers
+    are initialized. The preparation is traced on thread 0, before the workers start.
+    Each worker keeps its own copy of the model, and pulls tasks from the scheduler until none are left.
+    The task function calculates the scenarios of one task on the copy of the worker, given the cached component
+    update order of all scenarios. The calculation info and instrumentation of the copy are collected per task,
+    the timings, trace and errors of all tasks of the worker in its own thread info.
+    raise a BatchCalculationError if any of the scenarios failed
+    */
+    template <typename Prepare, typename Task>
+    void run_batch_workers_(ConstDataset const& update_data, Idx n_batch, Idx n_task, Idx threading,
+                            BatchPartitioning partitioning, Clock::time_point trace_origin, Prepare&& prepare,
+                            Task&& task) {
+        TraceRecorder preparation_recorder{0, trace_origin};
         try {
-            calculation_fn(*this, {}, ignore_output);
+            TraceScope const trace_scope{tracing_ ? &preparation_recorder : nullptr};
+            prepare();
         } catch (const SparseMatrixError&) {
             // missing entries are provided in the update data
         }
@@ -423,92 +598,214 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         // const ref of current instance
         MainModelImpl const& base_model = *this;
 
-        // cache component update order if possible
-        std::map<std::string, std::vector<Idx2D>, std::less<>> const sequence_idx_map =
-            MainModelImpl::is_update_independent(update_data)
-                ? get_sequence_idx_map(update_data)
-                : std::map<std::string, std::vector<Idx2D>, std::less<>>{};
+        // run tasks sequential or parallel
+        Idx const n_thread = std::min(get_n_thread(threading), n_task);
+        std::vector<BatchThreadInfo> thread_infos(n_thread);
 
-        // error messages
-        std::vector<std::string> exceptions(n_batch, "");
-        std::vector<CalculationInfo> infos(n_batch);
+        // cache component update order of all scenarios
+        main_core::SequenceIdxMap const sequence_idx_map =
+            get_sequence_idx_map(update_data, std::min(get_n_thread(threading), n_batch));
 
-        // lambda for sub batch calculation
-        auto sub_batch = [&base_model, &exceptions, &infos, &calculation_fn, &result_data, &update_data,
-                          &sequence_idx_map, n_batch](Idx start, Idx stride) {
-            Timer const t_total(infos[start], 0000, "Total in thread");
+        auto sub_batch = [&base_model, &thread_infos, &task, &sequence_idx_map, tracing = tracing_,
+                          trace_origin](BatchScheduler::TaskSource& task_source) {
+            BatchThreadInfo& thread_info = thread_infos[task_source.worker()];
+            thread_info.trace = TraceRecorder{task_source.worker(), trace_origin};
+            InstrumentationScope const scope{thread_info.counters};
+            TraceScope const trace_scope{tracing ? &thread_info.trace : nullptr};
+            InstrumentedTimer const t_total(0000, "Total in thread");
 
-            auto model = [&base_model, &infos, start] {
-                Timer const t_copy_model(infos[start], 1100, "Copy model");
+            auto model = [&base_model] {
+                InstrumentedTimer const t_copy_model(1100, "Copy model");
                 return MainModelImpl{base_model};
             }();
-
-            for (Idx batch_number = start; batch_number < n_batch; batch_number += stride) {
-                Timer const t_total_single(infos[batch_number], 0100, "Total single calculation in thread");
-                // try to update model and run calculation
-                try {
-                    {
-                        Timer const t_update_model(infos[batch_number], 1200, "Update model");
-                        model.template update_component<cached_update_t>(update_data, batch_number, sequence_idx_map);
-                    }
-                    calculation_fn(model, result_data, batch_number);
-                    {
-                        Timer const t_update_model(infos[batch_number], 1201, "Restore model");
-                        model.restore_components();
-                    }
-                } catch (std::exception const& ex) {
-                    exceptions[batch_number] = ex.what();
-                } catch (...) {
-                    exceptions[batch_number] = "unknown exception";
-                }
-
-                infos[batch_number].merge(model.calculation_info_);
+            // the preparation is not part of the calculation info of the scenarios
+            model.calculation_info_.clear();
+            model.instrumentation_.clear();
+            // recurring switching states in the batch re-use their solvers
+            model.topology_cache_.set_capacity(main_core::TopologyCache::default_capacity);
+
+            for (Idx task_number = task_source.next(); task_number != -1; task_number = task_source.next()) {
+                task(model, sequence_idx_map, thread_info, task_number);
+                main_core::merge_calculation_info_into(thread_info.info, model.calculation_info_);
+                thread_info.counters.merge(model.instrumentation_);
+                model.calculation_info_.clear();
+                model.instrumentation_.clear();
             }
+            thread_info.trace.set_scenario(-1);
         };
 
-        // run batches sequential or parallel
-        auto const hardware_thread = static_cast<Idx>(std::thread::hardware_concurrency());
-        // run sequential if
-        //    specified threading < 0
-        //    use hardware threads, but it is either unknown (0) or only has one thread (1)
-        //    specified threading = 1
-        if (threading < 0 || threading == 1 || (threading == 0 && hardware_thread < 2)) {
-            // run all in sequential
-            sub_batch(0, 1);
-        } else {
-            // create parallel threads
-            Idx const n_thread = std::min(threading == 0 ? hardware_thread : threading, n_batch);
-            std::vector<std::thread> threads;
-            threads.reserve(n_thread);
-            for (Idx thread_number = 0; thread_number < n_thread; ++thread_number) {
-                // compute each sub batch with stride
-                threads.emplace_back(sub_batch, thread_number, n_thread);
-            }
-            for (auto& thread : threads) {
-                thread.join();
-            }
-        }
+        batch_scheduler_.run(n_thread, n_task, sub_batch, partitioning);
 
-        handle_batch_exceptions(exceptions);
-        calculation_info_ = main_core::merge_calculation_info(infos);
+        merge_thread_infos(thread_infos, preparation_recorder.take_events());
+        handle_batch_exceptions(thread_infos);
+    }
 
-        return BatchParameter{};
+    // error message of a failed scenario in a batch calculation
+    struct ScenarioError {
+        Idx scenario;
+        std::string message;
+    };
+
+    // timings, trace and errors of the scenarios calculated by one thread of a batch calculation
+    // aligned to a cache line, so that different threads do not write into the same cache line
+    struct alignas(64) BatchThreadInfo {
+        InstrumentationCounters counters;
+        CalculationInfo info;
+        std::vector<ScenarioError> errors;
+        TraceRecorder trace;
+    };
+
+    // run the calculation of a scenario, the error is collected in the thread info instead of thrown
+    template <typename Fn> static void catch_scenario_error(BatchThreadInfo& thread_info, Idx scenario, Fn&& fn) {
+        try {
+            std::forward<Fn>(fn)();
+        } catch (std::exception const& ex) {
+            thread_info.errors.push_back({scenario, ex.what()});
+        } catch (...) {
+            thread_info.errors.push_back({scenario, "unknown exception"});
+        }
     }
 
-    static void handle_batch_exceptions(std::vector<std::string> const& exceptions) {
+    // the trace of the batch consists of the given events before the batch and the events of all threads
+    void merge_thread_infos(std::vector<BatchThreadInfo> const& thread_infos, std::vector<TraceEvent> trace) {
+        calculation_info_ = CalculationInfo{};
+        instrumentation_.clear();
+        trace_ = std::move(trace);
+        for (BatchThreadInfo const& thread_info : thread_infos) {
+            main_core::merge_calculation_info_into(calculation_info_, thread_info.info);
+            thread_info.counters.collect(calculation_info_);
+            trace_.insert(trace_.end(), thread_info.trace.events().cbegin(), thread_info.trace.events().cend());
+        }
+        std::ranges::stable_sort(trace_, {}, &TraceEvent::begin);
+    }
+
+    static void handle_batch_exceptions(std::vector<BatchThreadInfo> const& thread_infos) {
+        std::vector<ScenarioError> errors;
+        for (BatchThreadInfo const& thread_info : thread_infos) {
+            errors.insert(errors.end(), thread_info.errors.cbegin(), thread_info.errors.cend());
+        }
+        if (errors.empty()) {
+            return;
+        }
+        std::ranges::sort(errors, {}, &ScenarioError::scenario);
+
         std::string combined_error_message;
         IdxVector failed_scenarios;
         std::vector<std::string> err_msgs;
-        for (Idx batch = 0; batch < static_cast<Idx>(exceptions.size()); ++batch) {
-            // append exception if it is not empty
-            if (!exceptions[batch].empty()) {
-                combined_error_message += "Error in batch #" + std::to_string(batch) + ": " + exceptions[batch];
-                failed_scenarios.push_back(batch);
-                err_msgs.push_back(exceptions[batch]);
+        for (ScenarioError& error : errors) {
+            combined_error_message += "Error in batch #" + std::to_string(error.scenario) + ": " + error.message;
+            failed_scenarios.push_back(error.scenario);
+            err_msgs.push_back(std::move(error.message));
+        }
+        throw BatchCalculationError(combined_error_message, failed_scenarios, err_msgs);
+    }
+
+    // number of scenarios solved at once as multiple right-hand sides
+    static constexpr Idx multi_rhs_block_size = 64;
+
+    /*
+    batch power flow with the linear current method, for update data which only changes injections.
+
+    The Y bus, and thus the factorization, is the same for all scenarios.
+    The scenarios are distributed over the threads in blocks of multi_rhs_block_size scenarios.
+    The power flow inputs of the scenarios in one block are solved at once, as multiple right-hand sides.
+    */
+    template <bool sym>
+    BatchParameter calculate_linear_current_injection_batch_(Dataset const& result_data,
+                                                             ConstDataset const& update_data, Idx threading,
+                                                             BatchPartitioning partitioning) {
+        Idx const n_batch = update_data.cbegin()->second.batch_size();
+        auto const trace_origin = Clock::now();
+        trace_.clear();
+
+        // calculate once to prepare and prefactorize the solvers, ignore results
+        // each worker calculates one block of scenarios per task
+        Idx const n_block = (n_batch + multi_rhs_block_size - 1) / multi_rhs_block_size;
+        run_batch_workers_(
+            update_data, n_batch, n_block, threading, partitioning, trace_origin,
+            [this] {
+                calculate_power_flow_<sym>(std::numeric_limits<double>::max(), 1, CalculationMethod::linear_current,
+                                           PowerFlowInitialization::flat_start);
+            },
+            [&result_data, &update_data, n_batch](MainModelImpl& model,
+                                                  main_core::SequenceIdxMap const& sequence_idx_map,
+                                                  BatchThreadInfo& thread_info, Idx block) {
+                Idx const begin = block * multi_rhs_block_size;
+                Idx const end = std::min(n_batch, begin + multi_rhs_block_size);
+                auto const start = Clock::now();
+                // the steps of a block are tagged with the first scenario of the block
+                thread_info.trace.set_scenario(begin);
+                model.template calculate_linear_current_block_<sym>(result_data, update_data, sequence_idx_map, begin,
+                                                                    end, thread_info);
+                // the scenarios of the block are solved together, they share the wall time of the block
+                double const wall_time = Duration(Clock::now() - start).count() / static_cast<double>(end - begin);
+                for (Idx batch_number = begin; batch_number != end; ++batch_number) {
+                    main_core::record_scenario_statistics(model.scenario_statistics_, batch_number,
+                                                          model.calculation_info_, wall_time);
+                }
+            });
+
+        return BatchParameter{};
+    }
+
+    // calculate the scenarios [begin, end) of an injection-only batch with the linear current method
+    // the update is applied twice per scenario: once to get the power flow input, once to output the result
+    template <bool sym>
+    void calculate_linear_current_block_(Dataset const& result_data, ConstDataset const& update_data,
+                                         main_core::SequenceIdxMap const& sequence_idx_map,
+                                         Idx begin, Idx end, BatchThreadInfo& thread_info) {
+        // power flow input per math model, per scenario
+        std::vector<std::vector<PowerFlowInput<sym>>> inputs(n_math_solvers_);
+        IdxVector scenarios;
+        for (Idx batch_number = begin; batch_number != end; ++batch_number) {
+            catch_scenario_error(thread_info, batch_number, [&] {
+                InstrumentedTimer const t_update_model(1200, "Update model");
+                update_component<cached_update_t>(update_data, batch_number, sequence_idx_map);
+                auto input = prepare_power_flow_input<sym>();
+                restore_components();
+                for (Idx i = 0; i != n_math_solvers_; ++i) {
+                    inputs[i].push_back(std::move(input[i]));
+                }
+                scenarios.push_back(batch_number);
+            });
+        }
+
+        // solve all scenarios at once per math model
+        std::vector<std::vector<MathOutput<sym>>> math_output(scenarios.size());
+        try {
+            InstrumentedTimer const timer(2200, "Math Calculation");
+            prepare_solvers<sym>();
+            auto& solvers = get_solvers<sym>();
+            auto& y_bus_vec = get_y_bus<sym>();
+            for (Idx i = 0; i != n_math_solvers_; ++i) {
+                auto outputs =
+                    solvers[i].run_power_flow_linear_current_batch(inputs[i], calculation_info_, y_bus_vec[i]);
+                for (size_t k = 0; k != scenarios.size(); ++k) {
+                    math_output[k].push_back(std::move(outputs[k]));
+                }
             }
+        } catch (std::exception const&) {
+            // calculate the scenarios one by one, to get the error of each scenario
+            for (Idx const batch_number : scenarios) {
+                catch_scenario_error(thread_info, batch_number, [&] {
+                    update_component<cached_update_t>(update_data, batch_number, sequence_idx_map);
+                    calculate_power_flow<sym>(std::numeric_limits<double>::infinity(), 1,
+                                              CalculationMethod::linear_current, result_data, batch_number);
+                    restore_components();
+                });
+            }
+            return;
         }
-        if (!combined_error_message.empty()) {
-            throw BatchCalculationError(combined_error_message, failed_scenarios, err_msgs);
+
+        // output the results
+        for (size_t k = 0; k != scenarios.size(); ++k) {
+            Idx const batch_number = scenarios[k];
+            catch_scenario_error(thread_info, batch_number, [&] {
+                InstrumentedTimer const t_output(1202, "Output result");
+                update_component<cached_update_t>(update_data, batch_number, sequence_idx_map);
+                output_result(math_output[k], result_data, batch_number);
+                restore_components();
+            });
         }
     }
 
@@ -531,6 +828,16 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                            });
     }
 
+    // whether the update data only updates load/gen components
+    // such an update changes the injections, but never the topology or the Y bus
+    static bool is_update_injection_only(ConstDataset const& update_data) {
+        static constexpr std::array is_load_gen{std::derived_from<ComponentType, GenericLoadGen>...};
+        return std::all_of(AllComponents::component_index_map.cbegin(), AllComponents::component_index_map.cend(),
+                           [&update_data](ComponentEntry const& entry) {
+                               return is_load_gen[entry.index] || update_data.find(entry.name) == update_data.cend();
+                           });
+    }
+
     template <class Component> static bool is_component_update_independent(ConstDataPointer const& component_update) {
         // If the batch size is (0 or) 1, then the update data for this component is 'independent'
         if (component_update.batch_size() <= 1) {
@@ -561,36 +868,50 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     }
 
     // Single load flow calculation, returning math output results
+    // the iterative methods can start from the solution of the previous calculation, see PowerFlowInitialization
     template <bool sym>
-    std::vector<MathOutput<sym>> calculate_power_flow(double err_tol, Idx max_iter,
-                                                      CalculationMethod calculation_method) {
-        return calculate_power_flow_<sym>(err_tol, max_iter, calculation_method);
+    std::vector<MathOutput<sym>>
+    calculate_power_flow(double err_tol, Idx max_iter, CalculationMethod calculation_method,
+                         PowerFlowInitialization initialization = PowerFlowInitialization::flat_start) {
+        return calculate_power_flow_<sym>(err_tol, max_iter, calculation_method, initialization);
     }
 
     // Single load flow calculation, propagating the results to result_data
     template <bool sym>
     void calculate_power_flow(double err_tol, Idx max_iter, CalculationMethod calculation_method,
-                              Dataset const& result_data, Idx pos = 0) {
+                              Dataset const& result_data, Idx pos = 0,
+                              PowerFlowInitialization initialization = PowerFlowInitialization::flat_start) {
         assert(construction_complete_);
-        auto const math_output = calculate_power_flow_<sym>(err_tol, max_iter, calculation_method);
+        auto const math_output = calculate_power_flow_<sym>(err_tol, max_iter, calculation_method, initialization);
         if (pos != ignore_output) {
             output_result(math_output, result_data, pos);
         }
     }
 
     // Batch load flow calculation, propagating the results to result_data
+    // with PowerFlowInitialization::previous_solution each scenario starts from the solution of the previous
+    //     scenario calculated in the same thread
     template <bool sym>
     BatchParameter calculate_power_flow(double err_tol, Idx max_iter, CalculationMethod calculation_method,
                                         Dataset const& result_data, ConstDataset const& update_data,
-                                        Idx threading = -1) {
+                                        Idx threading = -1,
+                                        PowerFlowInitialization initialization = PowerFlowInitialization::flat_start,
+                                        BatchPartitioning partitioning = BatchPartitioning::work_stealing) {
+        // with the linear current method, a batch which only updates injections is solved with one factorization
+        if (calculation_method == CalculationMethod::linear_current && !update_data.empty() &&
+            update_data.cbegin()->second.batch_size() > 0 && is_update_injection_only(update_data)) {
+            return calculate_linear_current_injection_batch_<sym>(result_data, update_data, threading, partitioning);
+        }
         return batch_calculation_(
-            [err_tol, max_iter, calculation_method](MainModelImpl& model, Dataset const& target_data, Idx pos) {
+            [err_tol, max_iter, calculation_method, initialization](MainModelImpl& model, Dataset const& target_data,
+                                                                    Idx pos) {
                 auto const err_tol_ = pos != ignore_output ? err_tol : std::numeric_limits<double>::max();
                 auto const max_iter_ = pos != ignore_output ? max_iter : 1;
 
-                model.calculate_power_flow<sym>(err_tol_, max_iter_, calculation_method, target_data, pos);
+                model.calculate_power_flow<sym>(err_tol_, max_iter_, calculation_method, target_data, pos,
+                                                initialization);
             },
-            result_data, update_data, threading);
+            result_data, update_data, threading, partitioning);
     }
 
     // Single state estimation calculation, returning math output results
@@ -613,7 +934,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     template <bool sym>
     BatchParameter calculate_state_estimation(double err_tol, Idx max_iter, CalculationMethod calculation_method,
                                               Dataset const& result_data, ConstDataset const& update_data,
-                                              Idx threading = -1) {
+                                              Idx threading = -1,
+                                              BatchPartitioning partitioning = BatchPartitioning::work_stealing) {
         return batch_calculation_(
             [err_tol, max_iter, calculation_method](MainModelImpl& model, Dataset const& target_data, Idx pos) {
                 auto const err_tol_ = pos != ignore_output ? err_tol : std::numeric_limits<double>::max();
@@ -621,7 +943,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
 
                 model.calculate_state_estimation<sym>(err_tol_, max_iter_, calculation_method, target_data, pos);
             },
-            result_data, update_data, threading);
+            result_data, update_data, threading, partitioning);
     }
 
     // Single short circuit calculation, returning short circuit math output results
@@ -649,14 +971,52 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     // Batch short circuit calculation, propagating the results to result_data
     BatchParameter calculate_short_circuit(ShortCircuitVoltageScaling voltage_scaling,
                                            CalculationMethod calculation_method, Dataset const& result_data,
-                                           ConstDataset const& update_data, Idx threading = -1) {
+                                           ConstDataset const& update_data, Idx threading = -1,
+                                           BatchPartitioning partitioning = BatchPartitioning::work_stealing) {
         return batch_calculation_(
             [voltage_scaling, calculation_method](MainModelImpl& model, Dataset const& target_data, Idx pos) {
                 if (pos != ignore_output) {
                     model.calculate_short_circuit(voltage_scaling, calculation_method, target_data, pos);
                 }
             },
-            result_data, update_data, threading);
+            result_data, update_data, threading, partitioning);
+    }
+
+    // Single short circuit calculation of both voltage scaling cases with one factorization
+    // the results for voltage_scaling are propagated to result_data,
+    //     the results for the opposite voltage scaling to paired_result_data
+    void calculate_short_circuit_paired(ShortCircuitVoltageScaling voltage_scaling,
+                                        CalculationMethod calculation_method, Dataset const& result_data,
+                                        Dataset const& paired_result_data, Idx pos = 0) {
+        assert(construction_complete_);
+        if (std::all_of(state_.components.template citer<Fault>().begin(),
+                        state_.components.template citer<Fault>().end(),
+                        [](Fault const& fault) { return fault.get_fault_type() == FaultType::three_phase; })) {
+            auto const math_output = calculate_short_circuit_paired_<true>(voltage_scaling, calculation_method);
+            output_result(math_output[0], result_data, pos);
+            output_result(math_output[1], paired_result_data, pos);
+        } else {
+            auto const math_output = calculate_short_circuit_paired_<false>(voltage_scaling, calculation_method);
+            output_result(math_output[0], result_data, pos);
+            output_result(math_output[1], paired_result_data, pos);
+        }
+    }
+
+    // Batch short circuit calculation of both voltage scaling cases with one factorization per scenario
+    BatchParameter calculate_short_circuit_paired(ShortCircuitVoltageScaling voltage_scaling,
+                                                  CalculationMethod calculation_method, Dataset const& result_data,
+                                                  Dataset const& paired_result_data, ConstDataset const& update_data,
+                                                  Idx threading = -1,
+                                                  BatchPartitioning partitioning = BatchPartitioning::work_stealing) {
+        return batch_calculation_(
+            [voltage_scaling, calculation_method, &paired_result_data](MainModelImpl& model,
+                                                                       Dataset const& target_data, Idx pos) {
+                if (pos != ignore_output) {
+                    model.calculate_short_circuit_paired(voltage_scaling, calculation_method, target_data,
+                                                         paired_result_data, pos);
+                }
+            },
+            result_data, update_data, threading, partitioning);
     }
 
     template <typename Component, math_output_type MathOutputType, std::forward_iterator ResIt>
@@ -680,7 +1040,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
                 model.output_result<ComponentType>(math_output_, begin);
             }...};
 
-        Timer const t_output(calculation_info_, 3000, "Produce output");
+        InstrumentationScope const scope{instrumentation_};
+        InstrumentedTimer const t_output(3000, "Produce output");
         for (ComponentEntry const& entry : AllComponents::component_index_map) {
             auto const found = result_data.find(entry.name);
             // skip if component does not exist
@@ -692,10 +1053,30 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
     }
 
-    CalculationInfo calculation_info() { return calculation_info_; }
+    // the timings are only converted to the calculation info format when requested
+    CalculationInfo calculation_info() {
+        CalculationInfo info = calculation_info_;
+        instrumentation_.collect(info);
+        return info;
+    }
+
+    // the statistics of each scenario of the next calculations are written into the given arrays
+    void set_scenario_statistics(ScenarioStatistics const& scenario_statistics) {
+        scenario_statistics_ = scenario_statistics;
+    }
+
+    // record the begin and end of the calculation steps of the next calculations, per thread and scenario
+    void set_tracing(bool tracing) { tracing_ = tracing; }
+
+    // trace events of the last calculation, sorted by begin time, empty if tracing was disabled
+    std::vector<TraceEvent> const& trace() const { return trace_; }
 
   private:
     CalculationInfo calculation_info_; // needs to be first due to padding override
+    InstrumentationCounters instrumentation_;
+    ScenarioStatistics scenario_statistics_{};
+    bool tracing_{false};
+    std::vector<TraceEvent> trace_;
 
     double system_frequency_;
 
@@ -706,12 +1087,38 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     bool is_topology_up_to_date_{false};
     bool is_sym_parameter_up_to_date_{false};
     bool is_asym_parameter_up_to_date_{false};
+    // connections and coupling of the last full topology build, used to patch the topology when switching
+    ComponentConnections built_comp_conn_;
+    std::shared_ptr<TopologicalComponentToMathCoupling const> built_topo_comp_coup_;
+    // math models of other topologies built earlier, only enabled in the batch calculation threads
+    main_core::TopologyCache topology_cache_;
     UpdateChange cached_state_changes_{};
+    // components with changed parameters since the last Y bus update, per symmetry
+    main_core::ParameterChanges sym_param_changes_{.all = true, .branch = {}, .branch3 = {}, .shunt = {}};
+    main_core::ParameterChanges asym_param_changes_{.all = true, .branch = {}, .branch3 = {}, .shunt = {}};
+    main_core::ParameterChanges cached_param_changes_{};
+    // persistent threads for batch calculation, not copied with the model
+    BatchScheduler batch_scheduler_;
+    // number of threads for the sparse LU factorization, only used for a single calculation
+    Idx n_factorization_thread_{1};
 #ifndef NDEBUG
     // construction_complete is used for debug assertions only
     bool construction_complete_{false};
 #endif // !NDEBUG
 
+    // get number of threads from threading
+    // run sequential if
+    //    specified threading < 0
+    //    use hardware threads, but it is either unknown (0) or only has one thread (1)
+    //    specified threading = 1
+    static Idx get_n_thread(Idx threading) {
+        auto const hardware_thread = static_cast<Idx>(std::thread::hardware_concurrency());
+        if (threading < 0 || threading == 1 || (threading == 0 && hardware_thread < 2)) {
+            return 1;
+        }
+        return threading == 0 ? hardware_thread : threading;
+    }
+
     template <bool sym> bool& is_parameter_up_to_date() {
         if constexpr (sym) {
             return is_sym_parameter_up_to_date_;
@@ -719,6 +1126,21 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
             return is_asym_parameter_up_to_date_;
         }
     }
+    template <bool sym> bool is_parameter_up_to_date() const {
+        if constexpr (sym) {
+            return is_sym_parameter_up_to_date_;
+        } else {
+            return is_asym_parameter_up_to_date_;
+        }
+    }
+
+    template <bool sym> main_core::ParameterChanges& get_parameter_changes() {
+        if constexpr (sym) {
+            return sym_param_changes_;
+        } else {
+            return asym_param_changes_;
+        }
+    }
 
     template <bool sym> std::vector<MathSolver<sym>>& get_solvers() {
         if constexpr (sym) {
@@ -738,8 +1160,6 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
 
     void rebuild_topology() {
         assert(construction_complete_);
-        // clear old solvers
-        reset_solvers();
         // get connection info
         ComponentConnections comp_conn;
         comp_conn.branch_connected.resize(state_.comp_topo->branch_node_idx.size());
@@ -767,16 +1187,60 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         std::transform(state_.components.template citer<Source>().begin(),
                        state_.components.template citer<Source>().end(), comp_conn.source_connected.begin(),
                        [](Source const& source) { return source.status(); });
+        // try to patch the existing topology, keeping the Y bus and solvers
+        if (built_topo_comp_coup_) {
+            auto patched_coup = Topology::patch_topology(*state_.comp_topo, built_comp_conn_, comp_conn,
+                                                         state_.math_topology, built_topo_comp_coup_);
+            if (patched_coup) {
+                state_.topo_comp_coup = std::move(patched_coup);
+                is_topology_up_to_date_ = true;
+                is_sym_parameter_up_to_date_ = false;
+                is_asym_parameter_up_to_date_ = false;
+                sym_param_changes_.set_all();
+                asym_param_changes_.set_all();
+                return;
+            }
+        }
+        // re-use the math models of a recurring topology
+        if (auto cached = topology_cache_.take(comp_conn); cached.has_value()) {
+            cache_built_topology();
+            reset_solvers();
+            built_comp_conn_ = std::move(cached->comp_conn);
+            built_topo_comp_coup_ = std::move(cached->topo_comp_coup);
+            state_.math_topology = std::move(cached->math_topology);
+            state_.topo_comp_coup = built_topo_comp_coup_;
+            math_state_ = std::move(cached->math_state);
+            n_math_solvers_ = static_cast<Idx>(state_.math_topology.size());
+            is_topology_up_to_date_ = true;
+            return;
+        }
+        // clear old solvers
+        cache_built_topology();
+        reset_solvers();
         // re build
         Topology topology{*state_.comp_topo, comp_conn};
         std::tie(state_.math_topology, state_.topo_comp_coup) = topology.build_topology();
+        built_comp_conn_ = std::move(comp_conn);
+        built_topo_comp_coup_ = state_.topo_comp_coup;
         n_math_solvers_ = static_cast<Idx>(state_.math_topology.size());
         is_topology_up_to_date_ = true;
         is_sym_parameter_up_to_date_ = false;
         is_asym_parameter_up_to_date_ = false;
     }
 
-    template <bool sym> std::vector<MathModelParam<sym>> get_math_param() {
+    // move the math models of the last full topology build into the topology cache
+    void cache_built_topology() {
+        if (topology_cache_.capacity() <= 0 || !built_topo_comp_coup_ ||
+            (math_state_.math_solvers_sym.empty() && math_state_.math_solvers_asym.empty())) {
+            return;
+        }
+        topology_cache_.store({.comp_conn = std::move(built_comp_conn_),
+                               .math_topology = std::move(state_.math_topology),
+                               .topo_comp_coup = std::move(built_topo_comp_coup_),
+                               .math_state = std::move(math_state_)});
+    }
+
+    template <bool sym> std::vector<MathModelParam<sym>> get_math_param() const {
         std::vector<MathModelParam<sym>> math_param(n_math_solvers_);
         for (Idx i = 0; i != n_math_solvers_; ++i) {
             math_param[i].branch_param.resize(state_.math_topology[i]->n_branch());
@@ -829,6 +1293,47 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         return math_param;
     }
 
+    // get the parameters of the changed components only
+    template <bool sym>
+    std::vector<MathModelParamIncrement<sym>>
+    get_math_param_increment(main_core::ParameterChanges const& changes) const {
+        std::vector<MathModelParamIncrement<sym>> math_param_increment(n_math_solvers_);
+        for (Idx const i : changes.branch) {
+            Idx2D const math_idx = state_.topo_comp_coup->branch[i];
+            if (math_idx.group == -1) {
+                continue;
+            }
+            auto& increment = math_param_increment[math_idx.group];
+            increment.branch_param_to_change.push_back(math_idx.pos);
+            increment.branch_param.push_back(
+                state_.components.template get_item_by_seq<Branch>(i).template calc_param<sym>());
+        }
+        for (Idx const i : changes.branch3) {
+            Idx2DBranch3 const math_idx = state_.topo_comp_coup->branch3[i];
+            if (math_idx.group == -1) {
+                continue;
+            }
+            auto& increment = math_param_increment[math_idx.group];
+            auto const branch3_param =
+                state_.components.template get_item_by_seq<Branch3>(i).template calc_param<sym>();
+            for (size_t branch2 = 0; branch2 < 3; ++branch2) {
+                increment.branch_param_to_change.push_back(math_idx.pos[branch2]);
+                increment.branch_param.push_back(branch3_param[branch2]);
+            }
+        }
+        for (Idx const i : changes.shunt) {
+            Idx2D const math_idx = state_.topo_comp_coup->shunt[i];
+            if (math_idx.group == -1) {
+                continue;
+            }
+            auto& increment = math_param_increment[math_idx.group];
+            increment.shunt_param_to_change.push_back(math_idx.pos);
+            increment.shunt_param.push_back(
+                state_.components.template get_item_by_seq<Shunt>(i).template calc_param<sym>());
+        }
+        return math_param_increment;
+    }
+
     static constexpr auto include_all = [](Idx) { return true; };
 
     /** This is a heavily templated member function because it operates on many different variables of many different
@@ -884,7 +1389,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
               std::invocable<Idx> PredicateIn = decltype(include_all)>
         requires std::convertible_to<std::invoke_result_t<PredicateIn, Idx>, bool>
     void prepare_input(std::vector<Idx2D> const& components, std::vector<CalcStructOut>& calc_input,
-                       PredicateIn include = include_all) {
+                       PredicateIn include = include_all) const {
         for (Idx i = 0, n = (Idx)components.size(); i != n; ++i) {
             if (include(i)) {
                 Idx2D const math_idx = components[i];
@@ -903,7 +1408,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
               std::invocable<Idx> PredicateIn = decltype(include_all)>
         requires std::convertible_to<std::invoke_result_t<PredicateIn, Idx>, bool>
     void prepare_input(std::vector<Idx2D> const& components, std::vector<CalcStructOut>& calc_input,
-                       std::invocable<ComponentIn const&> auto extra_args, PredicateIn include = include_all) {
+                       std::invocable<ComponentIn const&> auto extra_args, PredicateIn include = include_all) const {
         for (Idx i = 0, n = (Idx)components.size(); i != n; ++i) {
             if (include(i)) {
                 Idx2D const math_idx = components[i];
@@ -919,7 +1424,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     }
 
     template <calculation_input_type CalcInputType>
-    auto calculate_param(auto const& c, auto const&... extra_args)
+    auto calculate_param(auto const& c, auto const&... extra_args) const
         requires requires {
                      { c.calc_param(extra_args...) };
                  }
@@ -928,7 +1433,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     }
 
     template <calculation_input_type CalcInputType>
-    auto calculate_param(auto const& c, auto const&... extra_args)
+    auto calculate_param(auto const& c, auto const&... extra_args) const
         requires requires {
                      { c.template calc_param<symmetric_calculation_input_type<CalcInputType>>(extra_args...) };
                  }
@@ -938,7 +1443,8 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     }
 
     template <bool sym, IntSVector(StateEstimationInput<sym>::*component), class Component>
-    void prepare_input_status(std::vector<Idx2D> const& objects, std::vector<StateEstimationInput<sym>>& input) {
+    void prepare_input_status(std::vector<Idx2D> const& objects,
+                              std::vector<StateEstimationInput<sym>>& input) const {
         for (Idx i = 0, n = (Idx)objects.size(); i != n; ++i) {
             Idx2D const math_idx = objects[i];
             if (math_idx.group == -1) {
@@ -949,7 +1455,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
     }
 
-    template <bool sym> std::vector<PowerFlowInput<sym>> prepare_power_flow_input() {
+    template <bool sym> std::vector<PowerFlowInput<sym>> prepare_power_flow_input() const {
         assert(is_topology_up_to_date_ && is_parameter_up_to_date<sym>());
         std::vector<PowerFlowInput<sym>> pf_input(n_math_solvers_);
         for (Idx i = 0; i != n_math_solvers_; ++i) {
@@ -965,7 +1471,7 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         return pf_input;
     }
 
-    template <bool sym> std::vector<StateEstimationInput<sym>> prepare_state_estimation_input() {
+    template <bool sym> std::vector<StateEstimationInput<sym>> prepare_state_estimation_input() const {
         assert(is_topology_up_to_date_ && is_parameter_up_to_date<sym>());
 
         std::vector<StateEstimationInput<sym>> se_input(n_math_solvers_);
@@ -1032,11 +1538,14 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
     std::vector<ShortCircuitInput> prepare_short_circuit_input(ShortCircuitVoltageScaling voltage_scaling) {
         assert(is_topology_up_to_date_ && is_parameter_up_to_date<sym>());
 
+        // read-only access, such that the component storage shared with other models is not copied
+        ComponentContainer const& components = state_.components;
+
         std::vector<IdxVector> topo_fault_indices(state_.math_topology.size());
         std::vector<IdxVector> topo_bus_indices(state_.math_topology.size());
 
-        for (Idx fault_idx{0}; fault_idx < state_.components.template size<Fault>(); ++fault_idx) {
-            auto const& fault = state_.components.template get_item_by_seq<Fault>(fault_idx);
+        for (Idx fault_idx{0}; fault_idx < components.template size<Fault>(); ++fault_idx) {
+            auto const& fault = components.template get_item_by_seq<Fault>(fault_idx);
             if (fault.status()) {
                 auto const node_idx = state_.components.template get_seq<Node>(fault.get_fault_object());
                 auto const topo_bus_idx = state_.topo_comp_coup->node[node_idx];
@@ -1066,12 +1575,12 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         state_.comp_coup = ComponentToMathCoupling{.fault = std::move(fault_coup)};
 
         prepare_input<ShortCircuitInput, FaultCalcParam, &ShortCircuitInput::faults, Fault>(
-            state_.comp_coup.fault, sc_input, [this](Fault const& fault) {
-                return state_.components.template get_item<Node>(fault.get_fault_object()).u_rated();
+            state_.comp_coup.fault, sc_input, [&components](Fault const& fault) {
+                return components.template get_item<Node>(fault.get_fault_object()).u_rated();
             });
         prepare_input<ShortCircuitInput, DoubleComplex, &ShortCircuitInput::source, Source>(
-            state_.topo_comp_coup->source, sc_input, [this, voltage_scaling](Source const& source) {
-                return std::pair{state_.components.template get_item<Node>(source.node()).u_rated(), voltage_scaling};
+            state_.topo_comp_coup->source, sc_input, [&components, voltage_scaling](Source const& source) {
+                return std::pair{components.template get_item<Node>(source.node()).u_rated(), voltage_scaling};
             });
 
         return sc_input;
@@ -1119,12 +1628,19 @@ class MainModelImpl<ExtraRetrievableTypes<ExtraRetrievableType...>, ComponentLis
         }
         // if parameters are not up to date, update them
         else if (!is_parameter_up_to_date<sym>()) {
-            // get param, will be consumed
-            std::vector<MathModelParam<sym>> const math_params = get_math_param<sym>();
-            main_core::update_y_bus(math_state_, math_params, n_math_solvers_);
+            main_core::ParameterChanges const& param_changes = get_parameter_changes<sym>();
+            if (param_changes.all) {
+                // get param, will be consumed
+                std::vector<MathModelParam<sym>> const math_params = get_math_param<sym>();
+                main_core::update_y_bus(math_state_, math_params, n_math_solvers_);
+            } else {
+                // only re-calculate the changed components and patch the affected Y bus entries
+                main_core::update_y_bus(math_state_, get_math_param_increment<sym>(param_changes), n_math_solvers_);
+            }
         }
         // else do nothing, set everything up to date
         is_parameter_up_to_date<sym>() = true;
+        get_parameter_changes<sym>().clear();
     }
 };
 
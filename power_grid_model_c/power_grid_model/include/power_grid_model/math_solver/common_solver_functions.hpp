@@ -9,6 +9,7 @@
 #include "y_bus.hpp"
 
 #include "../calculation_parameters.hpp"
+#include "../exception.hpp"
 
 namespace power_grid_model::common_solver_functions {
 
@@ -0,0 +1,425 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_MATH_SOLVER_FAST_DECOUPLED_PF_SOLVER_HPP
+#define POWER_GRID_MODEL_MATH_SOLVER_FAST_DECOUPLED_PF_SOLVER_HPP
+
+/*
+Fast Decoupled Power Flow, XB version
+
+Description:
+    The Newton-Raphson Jacobian is approximated by two constant, decoupled matrices.
+    The coupling blocks N = V * dP/dV and M = dQ/dTheta are neglected,
+        and the blocks H = dP/dTheta and L = V * dQ/dV are evaluated at the start voltage with magnitude 1.
+    The start voltage has the intrinsic phase shift, for asymmetric also shifted by 120 degrees per phase:
+        U = exp(1j * (phase shift))
+    For a (phase shift compensated) admittance y_ij, the flat start derivative is:
+        b(y_ij) = Gij .* sij - Bij .* cij
+        cij = Ui_r @* Uj_r + Ui_i @* Uj_i
+        sij = Ui_i @* Uj_r - Ui_r @* Uj_i
+    For symmetric calculation without phase shift this is the well known b(y) = -Im(y).
+
+    B' (for P-Theta) only contains the series reactance of the branches and the sources.
+        The series resistance, the shunt admittance and the off-nominal tap ratio are ignored.
+        The series admittance ys of a branch is recovered from the branch parameters:
+            yft * ytf = ys^2 / |k|^2, ytt / yff = |k|^2
+        and replaced by the pure reactive admittance -1j / x, x = Im(1 / ys).
+        The phase shift of yft and ytf is kept, because it is compensated by the start voltage.
+        For asymmetric calculation this is done per sequence component.
+            The zero and negative sequence also keep the reactance of the shunts
+            and the self reactance of the transformer windings blocking the sequence,
+            because these sequence networks can be grounded by shunts and transformer windings only.
+    B'' (for Q-V) is -Im(Y) with all the elements, including the shunts and the admittance of the sources.
+    Together with the successive half iterations below, this XB scheme also converges in grids with a high R/X ratio.
+
+    Iteration, in two successive half iterations:
+        del_theta = B'^-1 * (del_p / V), update theta
+        del_v = B''^-1 * (del_q / V), with del_q calculated using the updated theta, update V
+    The power mismatch del_pq = PQ_sp - PQ_cal is calculated in the same way as in the Newton-Raphson method.
+
+Prefactorization:
+    B' and B'' only depend on the Y bus and the topology.
+    Hence they are factorized once and re-used in all the iterations and in subsequent batches,
+        as long as the Y bus does not change.
+
+The convergence is linear instead of quadratic. It typically needs more, but much cheaper, iterations than
+    Newton-Raphson.
+*/
+
+#include "common_solver_functions.hpp"
+#include "iterative_pf_solver.hpp"
+#include "sparse_lu_solver.hpp"
+#include "y_bus.hpp"
+
+#include "../calculation_parameters.hpp"
+#include "../exception.hpp"
+#include "../power_grid_model.hpp"
+#include "../three_phase_tensor.hpp"
+#include "../timer.hpp"
+
+namespace power_grid_model {
+
+// hide implementation in inside namespace
+namespace math_model_impl {
+
+// solver
+template <bool sym> class FastDecoupledPFSolver : public IterativePFSolver<sym, FastDecoupledPFSolver<sym>> {
+  public:
+    FastDecoupledPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
+        : IterativePFSolver<sym, FastDecoupledPFSolver>{y_bus, topo_ptr},
+          theta_(y_bus.size()),
+          v_(y_bus.size()),
+          u_half_(y_bus.size()),
+          del_p_(y_bus.size()),
+          del_q_(y_bus.size()),
+          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
+          perm_p_(y_bus.size()),
+          perm_q_(y_bus.size()) {}
+
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
+
+    // Initialize the unknown variable in polar form
+    // Build and prefactorize B' and B'' matrices if the Y bus is not up to date
+    void initialize_derived_solver(YBus<sym> const& y_bus, MathOutput<sym> const& output) {
+        for (Idx i = 0; i != this->n_bus_; ++i) {
+            v_[i] = cabs(output.u[i]);
+            theta_[i] = arg(output.u[i]);
+        }
+        if (y_data_version_ != y_bus.admittance_version()) {
+            ComplexValueVector<sym> const u0 = flat_start_voltage();
+            RealTensorVector<sym> mat_data_p = calculate_b_p_matrix(y_bus, u0);
+            RealTensorVector<sym> mat_data_q = calculate_b_q_matrix(y_bus, u0);
+            sparse_solver_.prefactorize(mat_data_p, perm_p_);
+            sparse_solver_.prefactorize(mat_data_q, perm_q_);
+            // move pre-factorized version into shared ptr
+            mat_data_p_ = std::make_shared<RealTensorVector<sym> const>(std::move(mat_data_p));
+            mat_data_q_ = std::make_shared<RealTensorVector<sym> const>(std::move(mat_data_q));
+            // cache version
+            y_data_version_ = y_bus.admittance_version();
+        }
+    }
+
+    // P-Theta half iteration: solve B' * del_theta = del_p / V and update theta
+    // Then calculate the reactive power mismatch with the updated theta, divided by the voltage magnitude
+    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                ComplexValueVector<sym> const& u) {
+        for (Idx bus_number = 0; bus_number != this->n_bus_; ++bus_number) {
+            del_p_[bus_number] = real(calculate_mismatch(y_bus, input, u, bus_number)) / v_[bus_number];
+        }
+        // inplace
+        sparse_solver_.solve_with_prefactorized_matrix(*mat_data_p_, perm_p_, del_p_, del_p_);
+        for (Idx bus_number = 0; bus_number != this->n_bus_; ++bus_number) {
+            theta_[bus_number] += del_p_[bus_number];
+            u_half_[bus_number] = v_[bus_number] * exp(1.0i * theta_[bus_number]);
+        }
+        for (Idx bus_number = 0; bus_number != this->n_bus_; ++bus_number) {
+            del_q_[bus_number] = imag(calculate_mismatch(y_bus, input, u_half_, bus_number)) / v_[bus_number];
+        }
+    }
+
+    // Q-V half iteration: solve B'' * del_v = del_q / V
+    // inplace
+    void solve_matrix() { sparse_solver_.solve_with_prefactorized_matrix(*mat_data_q_, perm_q_, del_q_, del_q_); }
+
+    // Get maximum deviation among all bus voltages
+    double iterate_unknown(ComplexValueVector<sym>& u) {
+        double max_dev = 0.0;
+        for (Idx i = 0; i != this->n_bus_; ++i) {
+            v_[i] += del_q_[i];
+            // U = V * exp(1i*theta)
+            ComplexValue<sym> const u_tmp = v_[i] * exp(1.0i * theta_[i]);
+            double const dev = max_val(cabs(u_tmp - u[i]));
+            // a diverging iteration can overflow, it should never be considered as converged
+            max_dev = std::isnan(dev) ? std::numeric_limits<double>::infinity() : std::max(dev, max_dev);
+            u[i] = u_tmp;
+        }
+        return max_dev;
+    }
+
+  private:
+    // unknown in polar form
+    RealValueVector<sym> theta_;
+    RealValueVector<sym> v_;
+    // voltage after the P-Theta half iteration
+    ComplexValueVector<sym> u_half_;
+    // this stores in different steps
+    // 1. power mismatch divided by voltage magnitude
+    // 2. iteration step of theta and V
+    RealValueVector<sym> del_p_;
+    RealValueVector<sym> del_q_;
+    std::shared_ptr<RealTensorVector<sym> const> mat_data_p_;
+    std::shared_ptr<RealTensorVector<sym> const> mat_data_q_;
+    std::uint64_t y_data_version_{};
+    SparseLUSolver<RealTensor<sym>, RealValue<sym>, RealValue<sym>> sparse_solver_;
+    typename SparseLUSolver<RealTensor<sym>, RealValue<sym>, RealValue<sym>>::BlockPermArray perm_p_;
+    typename SparseLUSolver<RealTensor<sym>, RealValue<sym>, RealValue<sym>>::BlockPermArray perm_q_;
+
+    // Gij .* sij - Bij .* cij
+    static RealTensor<sym> calculate_b(ComplexTensor<sym> const& yij, ComplexValue<sym> const& ui,
+                                       ComplexValue<sym> const& uj) {
+        RealTensor<sym> const c_ij =
+            vector_outer_product(real(ui), real(uj)) + vector_outer_product(imag(ui), imag(uj));
+        RealTensor<sym> const s_ij =
+            vector_outer_product(imag(ui), real(uj)) - vector_outer_product(real(ui), imag(uj));
+        return real(yij) * s_ij - imag(yij) * c_ij;
+    }
+
+    // pure reactive admittance -1j / x, x = Im(1 / y)
+    // a purely resistive element is treated as a reactance with the same magnitude
+    static DoubleComplex reactance_admittance(DoubleComplex const& y) {
+        if (cabs(y) == 0.0) {
+            return 0.0;
+        }
+        DoubleComplex const z = 1.0 / y;
+        double const x = imag(z) == 0.0 ? cabs(z) : imag(z);
+        return -1.0i / x;
+    }
+
+    // B' contribution of a branch in one sequence component
+    struct BranchXB {
+        DoubleComplex y_series{};  // pure reactive series admittance, tap ratio and phase shift removed
+        DoubleComplex shift_ft{1.0}; // phase shift of the coupling from-to, exp(1j * phase shift)
+        DoubleComplex shift_tf{1.0}; // phase shift of the coupling to-from, exp(-1j * phase shift)
+        DoubleComplex y_shunt_f{}; // grounding reactance at the from side, only for a blocked sequence
+        DoubleComplex y_shunt_t{}; // grounding reactance at the to side, only for a blocked sequence
+    };
+
+    static BranchXB calculate_branch_xb(DoubleComplex const& yff, DoubleComplex const& yft, DoubleComplex const& ytf,
+                                        DoubleComplex const& ytt, bool ground_blocked) {
+        BranchXB branch_xb{};
+        DoubleComplex ys{};
+        double tap = 1.0;
+        // connected in series
+        if (cabs(yft) != 0.0 && cabs(ytf) != 0.0) {
+            // ytt / yff = |k|^2
+            if (cabs(yff) != 0.0 && cabs(ytt) != 0.0) {
+                tap = std::sqrt(cabs(ytt) / cabs(yff));
+            }
+            // yft * ytf = ys^2 / |k|^2
+            // the sign of the root is chosen such that ys points in the same direction as the self admittance
+            ys = tap * std::sqrt(yft * ytf);
+            if (real(ys * conj(cabs(ytt) == 0.0 ? yff : ytt)) < 0.0) {
+                ys = -ys;
+            }
+            branch_xb.y_series = reactance_admittance(ys);
+            // yft = -ys / conj(k), ytf = -ys / k, k = tap * exp(-1j * phase shift)
+            // the phase shift is kept, it differs per sequence for asymmetric calculation
+            branch_xb.shift_ft = -yft * tap / ys;
+            branch_xb.shift_tf = -ytf * tap / ys;
+        } else if (ground_blocked) {
+            // a sequence blocked by the winding type can still be grounded by the self admittance at either side
+            branch_xb.y_shunt_f = reactance_admittance(yff);
+            branch_xb.y_shunt_t = reactance_admittance(ytt);
+        }
+        return branch_xb;
+    }
+
+    // sequence components of a (circulant) admittance tensor, i.e. the diagonal of A^-1 * Y * A
+    static ComplexValue<sym> to_sequence(ComplexTensor<sym> const& y) {
+        if constexpr (sym) {
+            return y;
+        } else {
+            return ComplexValue<false>{
+                (get_sym_matrix_inv().matrix() * y.matrix() * get_sym_matrix().matrix()).diagonal().array()};
+        }
+    }
+
+    static ComplexTensor<sym> from_sequence(ComplexValue<sym> const& y) {
+        if constexpr (sym) {
+            return y;
+        } else {
+            return ComplexTensor<false>{
+                (get_sym_matrix().matrix() * y.matrix().asDiagonal() * get_sym_matrix_inv().matrix()).array()};
+        }
+    }
+
+    // zero, positive and negative sequence for asymmetric, only positive sequence for symmetric
+    static constexpr Idx n_seq = sym ? 1 : 3;
+    static constexpr bool is_positive_sequence(Idx seq) { return sym || seq == 1; }
+    static DoubleComplex& seq_value(ComplexValue<sym>& y_seq, Idx seq) {
+        if constexpr (sym) {
+            return y_seq;
+        } else {
+            return y_seq(seq);
+        }
+    }
+
+    // start voltage with magnitude 1, only the phase shift is relevant
+    ComplexValueVector<sym> flat_start_voltage() const {
+        std::vector<double> const& phase_shift = *this->phase_shift_;
+        ComplexValueVector<sym> u0(this->n_bus_);
+        for (Idx bus = 0; bus != this->n_bus_; ++bus) {
+            u0[bus] = ComplexValue<sym>{std::exp(1.0i * phase_shift[bus])};
+        }
+        return u0;
+    }
+
+    // B': series reactance of the branches and the sources, fill-ins are zero
+    //     the zero and negative sequence of asymmetric calculation also contain the shunts and the grounding of
+    //     blocked transformer windings, because these sequence networks can be grounded by those elements only
+    RealTensorVector<sym> calculate_b_p_matrix(YBus<sym> const& y_bus, ComplexValueVector<sym> const& u0) const {
+        IdxVector const& source_bus_indptr = *this->source_bus_indptr_;
+        IdxVector const& indptr = y_bus.row_indptr_lu();
+        IdxVector const& indices = y_bus.col_indices_lu();
+        IdxVector const& map_lu_y_bus = y_bus.map_lu_y_bus();
+        IdxVector const& bus_entry = y_bus.lu_diag();
+        IdxVector const& y_bus_entry_indptr = y_bus.y_bus_entry_indptr();
+        std::vector<YBusElement> const& y_bus_element = y_bus.y_bus_element();
+        MathModelParam<sym> const& param = y_bus.math_model_param();
+
+        std::vector<std::array<BranchXB, n_seq>> branch_xb(param.branch_param.size());
+        for (size_t branch = 0; branch != param.branch_param.size(); ++branch) {
+            BranchCalcParam<sym> const& branch_param = param.branch_param[branch];
+            ComplexValue<sym> yff = to_sequence(branch_param.yff());
+            ComplexValue<sym> yft = to_sequence(branch_param.yft());
+            ComplexValue<sym> ytf = to_sequence(branch_param.ytf());
+            ComplexValue<sym> ytt = to_sequence(branch_param.ytt());
+            for (Idx seq = 0; seq != n_seq; ++seq) {
+                branch_xb[branch][seq] =
+                    calculate_branch_xb(seq_value(yff, seq), seq_value(yft, seq), seq_value(ytf, seq),
+                                        seq_value(ytt, seq), !is_positive_sequence(seq));
+            }
+        }
+
+        RealTensorVector<sym> mat_data(y_bus.nnz_lu(), RealTensor<sym>{0.0});
+        for (Idx row = 0; row != this->n_bus_; ++row) {
+            for (Idx k = indptr[row]; k != indptr[row + 1]; ++k) {
+                Idx const k_y_bus = map_lu_y_bus[k];
+                if (k_y_bus == -1) {
+                    continue;
+                }
+                ComplexValue<sym> y_seq{};
+                for (Idx element = y_bus_entry_indptr[k_y_bus]; element != y_bus_entry_indptr[k_y_bus + 1];
+                     ++element) {
+                    YBusElement const& y_element = y_bus_element[element];
+                    for (Idx seq = 0; seq != n_seq; ++seq) {
+                        add_xb_element(y_element, seq, branch_xb, param, seq_value(y_seq, seq));
+                    }
+                }
+                mat_data[k] = calculate_b(from_sequence(y_seq), u0[row], u0[indices[k]]);
+            }
+            for (Idx source = source_bus_indptr[row]; source != source_bus_indptr[row + 1]; ++source) {
+                ComplexValue<sym> y_seq = to_sequence(param.source_param[source]);
+                for (Idx seq = 0; seq != n_seq; ++seq) {
+                    seq_value(y_seq, seq) = reactance_admittance(seq_value(y_seq, seq));
+                }
+                mat_data[bus_entry[row]] += calculate_b(from_sequence(y_seq), u0[row], u0[row]);
+            }
+        }
+        return mat_data;
+    }
+
+    static void add_xb_element(YBusElement const& y_element, Idx seq,
+                               std::vector<std::array<BranchXB, n_seq>> const& branch_xb,
+                               MathModelParam<sym> const& param, DoubleComplex& y_x) {
+        switch (y_element.element_type) {
+            using enum YBusElementType;
+
+        case bff:
+            y_x += branch_xb[y_element.idx][seq].y_series + branch_xb[y_element.idx][seq].y_shunt_f;
+            break;
+        case btt:
+            y_x += branch_xb[y_element.idx][seq].y_series + branch_xb[y_element.idx][seq].y_shunt_t;
+            break;
+        case bft:
+            y_x -= branch_xb[y_element.idx][seq].y_series * branch_xb[y_element.idx][seq].shift_ft;
+            break;
+        case btf:
+            y_x -= branch_xb[y_element.idx][seq].y_series * branch_xb[y_element.idx][seq].shift_tf;
+            break;
+        case shunt:
+            if (!is_positive_sequence(seq)) {
+                ComplexValue<sym> y_shunt = to_sequence(param.shunt_param[y_element.idx]);
+                y_x += reactance_admittance(seq_value(y_shunt, seq));
+            }
+            break;
+        default:
+            throw MissingCaseForEnumError("Fast decoupled B' matrix", y_element.element_type);
+        }
+    }
+
+    // B'': -Im(Y) including the shunts and the sources, fill-ins are zero
+    RealTensorVector<sym> calculate_b_q_matrix(YBus<sym> const& y_bus, ComplexValueVector<sym> const& u0) const {
+        IdxVector const& source_bus_indptr = *this->source_bus_indptr_;
+        IdxVector const& indptr = y_bus.row_indptr_lu();
+        IdxVector const& indices = y_bus.col_indices_lu();
+        IdxVector const& map_lu_y_bus = y_bus.map_lu_y_bus();
+        IdxVector const& bus_entry = y_bus.lu_diag();
+        ComplexTensorVector<sym> const& ydata = y_bus.admittance();
+
+        RealTensorVector<sym> mat_data(y_bus.nnz_lu(), RealTensor<sym>{0.0});
+        for (Idx row = 0; row != this->n_bus_; ++row) {
+            for (Idx k = indptr[row]; k != indptr[row + 1]; ++k) {
+                if (Idx const k_y_bus = map_lu_y_bus[k]; k_y_bus != -1) {
+                    mat_data[k] = calculate_b(ydata[k_y_bus], u0[row], u0[indices[k]]);
+                }
+            }
+            for (Idx source = source_bus_indptr[row]; source != source_bus_indptr[row + 1]; ++source) {
+                mat_data[bus_entry[row]] +=
+                    calculate_b(y_bus.math_model_param().source_param[source], u0[row], u0[row]);
+            }
+        }
+        return mat_data;
+    }
+
+    // PQ_sp - PQ_cal, starting with negative power injection into the network
+    ComplexValue<sym> calculate_mismatch(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                                         ComplexValueVector<sym> const& u, Idx bus_number) const {
+        ComplexValue<sym> del_s = -y_bus.calculate_injection(u, bus_number);
+        add_loads(bus_number, input, *this->load_gen_bus_indptr_, *this->load_gen_type_, del_s);
+        add_sources(bus_number, y_bus, input, *this->source_bus_indptr_, u, del_s);
+        return del_s;
+    }
+
+    void add_loads(Idx bus_number, PowerFlowInput<sym> const& input, IdxVector const& load_gen_bus_indptr,
+                   std::vector<LoadGenType> const& load_gen_type, ComplexValue<sym>& del_s) const {
+        for (Idx load_number = load_gen_bus_indptr[bus_number]; load_number != load_gen_bus_indptr[bus_number + 1];
+             ++load_number) {
+            LoadGenType const type = load_gen_type[load_number];
+            switch (type) {
+                using enum LoadGenType;
+
+            case const_pq:
+                // PQ_sp = PQ_base
+                del_s += input.s_injection[load_number];
+                break;
+            case const_y:
+                // PQ_sp = PQ_base * V^2
+                del_s += input.s_injection[load_number] * v_[bus_number] * v_[bus_number];
+                break;
+            case const_i:
+                // PQ_sp = PQ_base * V
+                del_s += input.s_injection[load_number] * v_[bus_number];
+                break;
+            default:
+                throw MissingCaseForEnumError("Power mismatch calculation", type);
+            }
+        }
+    }
+
+    void add_sources(Idx bus_number, YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
+                     IdxVector const& source_bus_indptr, ComplexValueVector<sym> const& u,
+                     ComplexValue<sym>& del_s) const {
+        for (Idx source_number = source_bus_indptr[bus_number]; source_number != source_bus_indptr[bus_number + 1];
+             ++source_number) {
+            ComplexTensor<sym> const y_ref = y_bus.math_model_param().source_param[source_number];
+            ComplexValue<sym> const u_ref{input.source[source_number]};
+            // S_source = U .* conj(Y_ref * (U_ref - U))
+            del_s += u[bus_number] * conj(dot(y_ref, u_ref - u[bus_number]));
+        }
+    }
+};
+
+template class FastDecoupledPFSolver<true>;
+template class FastDecoupledPFSolver<false>;
+
+} // namespace math_model_impl
+
+template <bool sym> using FastDecoupledPFSolver = math_model_impl::FastDecoupledPFSolver<sym>;
+
+} // namespace power_grid_model
+
+#endif
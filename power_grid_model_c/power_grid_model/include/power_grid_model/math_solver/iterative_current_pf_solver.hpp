@@ -58,10 +58,12 @@ Nomenclature:
 #include "common_solver_functions.hpp"
 #include "iterative_pf_solver.hpp"
 #include "sparse_lu_solver.hpp"
+#include "woodbury_lu_solver.hpp"
 #include "y_bus.hpp"
 
 #include "../calculation_parameters.hpp"
 #include "../exception.hpp"
+#include "../instrumentation.hpp"
 #include "../power_grid_model.hpp"
 #include "../three_phase_tensor.hpp"
 #include "../timer.hpp"
@@ -74,22 +76,21 @@ namespace math_model_impl {
 // solver
 template <bool sym> class IterativeCurrentPFSolver : public IterativePFSolver<sym, IterativeCurrentPFSolver<sym>> {
   public:
-    using BlockPermArray =
-        typename SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>::BlockPermArray;
-
     IterativeCurrentPFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
         : IterativePFSolver<sym, IterativeCurrentPFSolver>{y_bus, topo_ptr},
           rhs_u_(y_bus.size()),
-          y_data_ptr_(nullptr),
           sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()} {}
 
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
+
     // Add source admittance to Y bus and set variable for prepared y bus to true
     void initialize_derived_solver(YBus<sym> const& y_bus, MathOutput<sym> const& /* output */) {
         IdxVector const& source_bus_indptr = *this->source_bus_indptr_;
         IdxVector const& bus_entry = y_bus.lu_diag();
         // if Y bus is not up to date
         // re-build matrix and prefactorize Build y bus data with source admittance
-        if (y_data_ptr_ != &y_bus.admittance()) {
+        if (y_data_version_ != y_bus.admittance_version()) {
             ComplexTensorVector<sym> mat_data(y_bus.nnz_lu());
             common_solver_functions::copy_y_bus<sym>(y_bus, mat_data);
 
@@ -104,14 +105,64 @@ template <bool sym> class IterativeCurrentPFSolver : public IterativePFSolver<sy
                 }
             }
             // prefactorize
-            BlockPermArray perm(this->n_bus_);
-            sparse_solver_.prefactorize(mat_data, perm);
+            sparse_solver_.prefactorize(mat_data);
             // move pre-factorized version into shared ptr
             mat_data_ = std::make_shared<ComplexTensorVector<sym> const>(std::move(mat_data));
-            perm_ = std::make_shared<BlockPermArray const>(std::move(perm));
-            // cache pointer
-            y_data_ptr_ = &y_bus.admittance();
+            // cache version
+            y_data_version_ = y_bus.admittance_version();
+        }
+    }
+
+    // linear current calculation, i.e. one iteration from flat start, of many inputs at once
+    // the injections of all inputs are solved as multiple right-hand sides with the same prefactorized matrix
+    std::vector<MathOutput<sym>> run_linear_current_batch(YBus<sym> const& y_bus,
+                                                          std::vector<PowerFlowInput<sym>> const& inputs,
+                                                          CalculationInfo& calculation_info) {
+        auto const n_rhs = static_cast<Idx>(inputs.size());
+        std::vector<MathOutput<sym>> outputs(n_rhs);
+        if (n_rhs == 0) {
+            return outputs;
+        }
+
+        InstrumentedTimer main_timer{2220, "Math solver"};
+        ComplexValueVector<sym> multi_rhs(this->n_bus_ * n_rhs);
+        {
+            InstrumentedTimer const sub_timer{2221, "Initialize calculation"};
+            for (auto& output : outputs) {
+                output.u.resize(this->n_bus_);
+            }
+            for (Idx k = 0; k != n_rhs; ++k) {
+                this->initialize_flat_start(inputs[k], outputs[k].u);
+            }
+            initialize_derived_solver(y_bus, outputs.front());
         }
+        {
+            InstrumentedTimer const sub_timer{2222, "Prepare the matrices"};
+            for (Idx k = 0; k != n_rhs; ++k) {
+                prepare_matrix_and_rhs(y_bus, inputs[k], outputs[k].u);
+                for (Idx bus_number = 0; bus_number != this->n_bus_; ++bus_number) {
+                    multi_rhs[bus_number * n_rhs + k] = rhs_u_[bus_number];
+                }
+            }
+        }
+        {
+            InstrumentedTimer const sub_timer{2223, "Solve sparse linear equation"};
+            sparse_solver_.solve_with_prefactorized_matrix(*mat_data_, n_rhs, multi_rhs, multi_rhs);
+        }
+        {
+            InstrumentedTimer const sub_timer{2225, "Calculate Math Result"};
+            for (Idx k = 0; k != n_rhs; ++k) {
+                for (Idx bus_number = 0; bus_number != this->n_bus_; ++bus_number) {
+                    outputs[k].u[bus_number] = multi_rhs[bus_number * n_rhs + k];
+                }
+                this->calculate_result(y_bus, inputs[k], outputs[k]);
+            }
+        }
+        main_timer.stop();
+
+        static auto const key = Timer::make_key(2226, "Max number of iterations");
+        calculation_info[key] = std::max(calculation_info[key], 1.0);
+        return outputs;
     }
 
     // Prepare matrix calculates injected current ie. RHS of solver for each iteration.
@@ -133,7 +184,7 @@ template <bool sym> class IterativeCurrentPFSolver : public IterativePFSolver<sy
 
     // Solve the linear equations I_inj = YU
     // inplace
-    void solve_matrix() { sparse_solver_.solve_with_prefactorized_matrix(*mat_data_, *perm_, rhs_u_, rhs_u_); }
+    void solve_matrix() { sparse_solver_.solve_with_prefactorized_matrix(*mat_data_, rhs_u_, rhs_u_); }
 
     // Find maximum deviation in voltage among all buses
     double iterate_unknown(ComplexValueVector<sym>& u) {
@@ -153,10 +204,9 @@ template <bool sym> class IterativeCurrentPFSolver : public IterativePFSolver<sy
   private:
     ComplexValueVector<sym> rhs_u_;
     std::shared_ptr<ComplexTensorVector<sym> const> mat_data_;
-    ComplexTensorVector<sym> const* y_data_ptr_;
-    // sparse solver
-    SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> sparse_solver_;
-    std::shared_ptr<BlockPermArray const> perm_;
+    std::uint64_t y_data_version_{};
+    // sparse solver, re-using the base case factorization for small changes
+    WoodburyLUSolver<sym> sparse_solver_;
 
     void add_loads(Idx const& bus_number, PowerFlowInput<sym> const& input, IdxVector const& load_gen_bus_indptr,
                    std::vector<LoadGenType> const& load_gen_type, ComplexValueVector<sym> const& u) {
@@ -16,6 +16,7 @@
 
 #include "../calculation_parameters.hpp"
 #include "../exception.hpp"
+#include "../instrumentation.hpp"
 #include "../power_grid_model.hpp"
 #include "../three_phase_tensor.hpp"
 #include "../timer.hpp"
@@ -27,37 +28,44 @@ template <bool sym, typename DerivedSolver> class IterativePFSolver {
   public:
     friend DerivedSolver;
     MathOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
-                                   Idx max_iter, CalculationInfo& calculation_info) {
+                                   Idx max_iter, CalculationInfo& calculation_info,
+                                   PowerFlowInitialization initialization = PowerFlowInitialization::flat_start) {
+        // start from the solution of the previous calculation if available
+        // fall back to flat start if that does not converge
+        if (initialization == PowerFlowInitialization::previous_solution &&
+            static_cast<Idx>(previous_u_.size()) == n_bus_) {
+            try {
+                return run_power_flow_from(y_bus, input, err_tol, max_iter, calculation_info, previous_u_);
+            } catch (IterationDiverge const&) {
+                // retry with flat start
+            } catch (SparseMatrixError const&) {
+                // retry with flat start
+            }
+        }
+        return run_power_flow_from(y_bus, input, err_tol, max_iter, calculation_info, {});
+    }
+
+    MathOutput<sym> run_power_flow_from(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, double err_tol,
+                                        Idx max_iter, CalculationInfo& calculation_info,
+                                        ComplexValueVector<sym> const& initial_u) {
         // get derived reference for derived solver class
-        auto derived_solver = static_cast<DerivedSolver&>(*this);
-        IdxVector const& source_bus_indptr = *source_bus_indptr_;
-        std::vector<double> const& phase_shift = *phase_shift_;
+        auto& derived_solver = static_cast<DerivedSolver&>(*this);
 
         // prepare
         MathOutput<sym> output;
         output.u.resize(n_bus_);
         double max_dev = std::numeric_limits<double>::infinity();
 
-        Timer main_timer{calculation_info, 2220, "Math solver"};
+        InstrumentedTimer main_timer{2220, "Math solver"};
 
         // initialize
         {
-            Timer const sub_timer{calculation_info, 2221, "Initialize calculation"};
-            // average u_ref of all sources
-            DoubleComplex const u_ref = [&]() {
-                DoubleComplex sum_u_ref = 0.0;
-                for (Idx bus = 0; bus != n_bus_; ++bus) {
-                    for (Idx source = source_bus_indptr[bus]; source != source_bus_indptr[bus + 1]; ++source) {
-                        sum_u_ref += input.source[source] * std::exp(1.0i * -phase_shift[bus]); // offset phase shift
-                    }
-                }
-                return sum_u_ref / (double)input.source.size();
-            }();
-
-            // assign u_ref as flat start
-            for (Idx i = 0; i != n_bus_; ++i) {
-                // consider phase shift
-                output.u[i] = ComplexValue<sym>{u_ref * std::exp(1.0i * phase_shift[i])};
+            InstrumentedTimer const sub_timer{2221, "Initialize calculation"};
+            if (initial_u.empty()) {
+                initialize_flat_start(input, output.u);
+            } else {
+                // warm start
+                output.u = initial_u;
             }
 
             // Further initialization specific to the derived solver
@@ -73,35 +81,61 @@ template <bool sym, typename DerivedSolver> class IterativePFSolver {
             }
             {
                 // Prepare the matrices of linear equations to be solved
-                Timer const sub_timer{calculation_info, 2222, "Prepare the matrices"};
+                InstrumentedTimer const sub_timer{2222, "Prepare the matrices"};
                 derived_solver.prepare_matrix_and_rhs(y_bus, input, output.u);
             }
             {
                 // Solve the linear equations
-                Timer const sub_timer{calculation_info, 2223, "Solve sparse linear equation"};
+                InstrumentedTimer const sub_timer{2223, "Solve sparse linear equation"};
                 derived_solver.solve_matrix();
             }
             {
                 // Calculate maximum deviation of voltage at any bus
-                Timer const sub_timer{calculation_info, 2224, "Iterate unknown"};
+                InstrumentedTimer const sub_timer{2224, "Iterate unknown"};
                 max_dev = derived_solver.iterate_unknown(output.u);
             }
         } while (max_dev > err_tol);
 
         // calculate math result
         {
-            Timer const sub_timer{calculation_info, 2225, "Calculate Math Result"};
+            InstrumentedTimer const sub_timer{2225, "Calculate Math Result"};
             calculate_result(y_bus, input, output);
         }
         // Manually stop timers to avoid "Max number of iterations" to be included in the timing.
         main_timer.stop();
 
-        const auto key = Timer::make_key(2226, "Max number of iterations");
+        static auto const key = Timer::make_key(2226, "Max number of iterations");
         calculation_info[key] = std::max(calculation_info[key], (double)num_iter);
+        static auto const deviation_key = Timer::make_key(2229, "Max final deviation");
+        calculation_info[deviation_key] = std::max(calculation_info[deviation_key], max_dev);
 
+        // keep the solution as start point for the next calculation
+        previous_u_ = output.u;
         return output;
     }
 
+    // flat start: averaged u_ref of all sources, shifted by the phase shift of each bus
+    void initialize_flat_start(PowerFlowInput<sym> const& input, ComplexValueVector<sym>& u) const {
+        IdxVector const& source_bus_indptr = *source_bus_indptr_;
+        std::vector<double> const& phase_shift = *phase_shift_;
+        // average u_ref of all sources
+        DoubleComplex const u_ref = [&]() {
+            DoubleComplex sum_u_ref = 0.0;
+            for (Idx bus = 0; bus != n_bus_; ++bus) {
+                for (Idx source = source_bus_indptr[bus]; source != source_bus_indptr[bus + 1]; ++source) {
+                    sum_u_ref += input.source[source] * std::exp(1.0i * -phase_shift[bus]); // offset phase shift
+                }
+            }
+            return sum_u_ref / (double)input.source.size();
+        }();
+
+        // assign u_ref as flat start
+        for (Idx i = 0; i != n_bus_; ++i) {
+            // consider phase shift
+            u[i] = ComplexValue<sym>{u_ref * std::exp(1.0i * phase_shift[i])};
+        }
+    }
+
     void calculate_result(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, MathOutput<sym>& output) {
         // pending to correct
         // call y bus
@@ -128,6 +162,8 @@ template <bool sym, typename DerivedSolver> class IterativePFSolver {
     std::shared_ptr<IdxVector const> load_gen_bus_indptr_;
     std::shared_ptr<IdxVector const> source_bus_indptr_;
     std::shared_ptr<std::vector<LoadGenType> const> load_gen_type_;
+    // converged voltage of the last calculation
+    ComplexValueVector<sym> previous_u_;
     IterativePFSolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> const& topo_ptr)
         : n_bus_{y_bus.size()},
           phase_shift_{topo_ptr, &topo_ptr->phase_shift},
@@ -32,10 +32,12 @@ if there are sources
 
 #include "common_solver_functions.hpp"
 #include "sparse_lu_solver.hpp"
+#include "woodbury_lu_solver.hpp"
 #include "y_bus.hpp"
 
 #include "../calculation_parameters.hpp"
 #include "../exception.hpp"
+#include "../instrumentation.hpp"
 #include "../power_grid_model.hpp"
 #include "../three_phase_tensor.hpp"
 #include "../timer.hpp"
@@ -53,29 +55,31 @@ template <bool sym> class LinearPFSolver {
           load_gen_bus_indptr_{topo_ptr, &topo_ptr->load_gen_bus_indptr},
           source_bus_indptr_{topo_ptr, &topo_ptr->source_bus_indptr},
           mat_data_(y_bus.nnz_lu()),
-          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
-          perm_(n_bus_) {}
+          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()} {}
+
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
 
     MathOutput<sym> run_power_flow(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input,
-                                   CalculationInfo& calculation_info) {
+                                   CalculationInfo& /* calculation_info */) {
         // output
         MathOutput<sym> output;
         output.u.resize(n_bus_);
 
-        Timer const main_timer(calculation_info, 2220, "Math solver");
+        InstrumentedTimer const main_timer(2220, "Math solver");
 
         // prepare matrix
-        Timer sub_timer(calculation_info, 2221, "Prepare matrix");
+        InstrumentedTimer sub_timer(2221, "Prepare matrix");
         common_solver_functions::copy_y_bus<sym>(y_bus, mat_data_);
         prepare_matrix_and_rhs(y_bus, input, output);
 
         // solve
         // u vector will have I_injection for slack bus for now
-        sub_timer = Timer(calculation_info, 2222, "Solve sparse linear equation");
-        sparse_solver_.prefactorize_and_solve(mat_data_, perm_, output.u, output.u);
+        sub_timer = InstrumentedTimer(2222, "Solve sparse linear equation");
+        sparse_solver_.prefactorize_and_solve(mat_data_, output.u, output.u);
 
         // calculate math result
-        sub_timer = Timer(calculation_info, 2223, "Calculate Math Result");
+        sub_timer = InstrumentedTimer(2223, "Calculate Math Result");
         calculate_result(y_bus, input, output);
 
         // output
@@ -89,9 +93,8 @@ template <bool sym> class LinearPFSolver {
     std::shared_ptr<IdxVector const> source_bus_indptr_;
     // sparse linear equation
     ComplexTensorVector<sym> mat_data_;
-    // sparse solver
-    SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> sparse_solver_;
-    typename SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>::BlockPermArray perm_;
+    // sparse solver, re-using the base case factorization for small changes
+    WoodburyLUSolver<sym> sparse_solver_;
 
     void prepare_matrix_and_rhs(YBus<sym> const& y_bus, PowerFlowInput<sym> const& input, MathOutput<sym>& output) {
         // getter
@@ -6,15 +6,18 @@
 #ifndef POWER_GRID_MODEL_MATH_SOLVER_MATH_SOLVER_HPP
 #define POWER_GRID_MODEL_MATH_SOLVER_MATH_SOLVER_HPP
 
+#include "fast_decoupled_pf_solver.hpp"
 #include "iterative_current_pf_solver.hpp"
 #include "iterative_linear_se_solver.hpp"
 #include "linear_pf_solver.hpp"
 #include "newton_raphson_pf_solver.hpp"
+#include "newton_raphson_se_solver.hpp"
 #include "short_circuit_solver.hpp"
 #include "y_bus.hpp"
 
 #include "../calculation_parameters.hpp"
 #include "../exception.hpp"
+#include "../instrumentation.hpp"
 #include "../power_grid_model.hpp"
 #include "../three_phase_tensor.hpp"
 #include "../timer.hpp"
@@ -32,7 +35,8 @@ template <bool sym> class MathSolver {
 
     MathOutput<sym> run_power_flow(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
                                    CalculationInfo& calculation_info, CalculationMethod calculation_method,
-                                   YBus<sym> const& y_bus) {
+                                   YBus<sym> const& y_bus,
+                                   PowerFlowInitialization initialization = PowerFlowInitialization::flat_start) {
         using enum CalculationMethod;
 
         // set method to always linear if all load_gens have const_y
@@ -42,39 +46,69 @@ template <bool sym> class MathSolver {
         case default_method:
             [[fallthrough]]; // use Newton-Raphson by default
         case newton_raphson:
-            return run_power_flow_newton_raphson(input, err_tol, max_iter, calculation_info, y_bus);
+            return run_power_flow_newton_raphson(input, err_tol, max_iter, calculation_info, y_bus, initialization);
         case linear:
             return run_power_flow_linear(input, err_tol, max_iter, calculation_info, y_bus);
         case linear_current:
             return run_power_flow_linear_current(input, err_tol, max_iter, calculation_info, y_bus);
         case iterative_current:
-            return run_power_flow_iterative_current(input, err_tol, max_iter, calculation_info, y_bus);
+            return run_power_flow_iterative_current(input, err_tol, max_iter, calculation_info, y_bus, initialization);
+        case fast_decoupled:
+            return run_power_flow_fast_decoupled(input, err_tol, max_iter, calculation_info, y_bus, initialization);
         default:
             throw InvalidCalculationMethod{};
         }
     }
 
+    // linear current power flow of many inputs with the same Y bus at once
+    // the inputs are solved as multiple right-hand sides with one factorization
+    // if all load_gens have const_y, the matrix depends on the input, and the inputs are calculated one by one
+    std::vector<MathOutput<sym>> run_power_flow_linear_current_batch(std::vector<PowerFlowInput<sym>> const& inputs,
+                                                                     CalculationInfo& calculation_info,
+                                                                     YBus<sym> const& y_bus) {
+        if (all_const_y_) {
+            std::vector<MathOutput<sym>> outputs;
+            outputs.reserve(inputs.size());
+            for (auto const& input : inputs) {
+                outputs.push_back(run_power_flow_linear(input, 0.0, 1, calculation_info, y_bus));
+            }
+            return outputs;
+        }
+        if (!iterative_current_pf_solver_.has_value()) {
+            InstrumentedTimer const timer(2210, "Create math solver");
+            iterative_current_pf_solver_.emplace(y_bus, topo_ptr_);
+        }
+        iterative_current_pf_solver_.value().set_threading(n_thread_);
+        return iterative_current_pf_solver_.value().run_linear_current_batch(y_bus, inputs, calculation_info);
+    }
+
     MathOutput<sym> run_state_estimation(StateEstimationInput<sym> const& input, double err_tol, Idx max_iter,
                                          CalculationInfo& calculation_info, CalculationMethod calculation_method,
                                          YBus<sym> const& y_bus) {
-        if (calculation_method != CalculationMethod::default_method &&
-            calculation_method != CalculationMethod::iterative_linear) {
-            throw InvalidCalculationMethod{};
-        }
+        using enum CalculationMethod;
 
-        // construct model if needed
-        if (!iterative_linear_se_solver_.has_value()) {
-            Timer const timer(calculation_info, 2210, "Create math solver");
-            iterative_linear_se_solver_.emplace(y_bus, topo_ptr_);
+        switch (calculation_method) {
+        case default_method:
+            [[fallthrough]]; // use iterative linear by default
+        case iterative_linear:
+            return run_state_estimation_iterative_linear(input, err_tol, max_iter, calculation_info, y_bus);
+        case newton_raphson:
+            return run_state_estimation_newton_raphson(input, err_tol, max_iter, calculation_info, y_bus);
+        default:
+            throw InvalidCalculationMethod{};
         }
-
-        // call calculation
-        return iterative_linear_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter,
-                                                                        calculation_info);
     }
 
     ShortCircuitMathOutput<sym> run_short_circuit(ShortCircuitInput const& input, CalculationInfo& calculation_info,
                                                   CalculationMethod calculation_method, YBus<sym> const& y_bus) {
+        return std::move(run_short_circuit(std::span{&input, 1}, calculation_info, calculation_method, y_bus).front());
+    }
+
+    // short circuit calculation of several cases which only differ in the source voltages
+    std::vector<ShortCircuitMathOutput<sym>> run_short_circuit(std::span<ShortCircuitInput const> inputs,
+                                                               CalculationInfo& /* calculation_info */,
+                                                               CalculationMethod calculation_method,
+                                                               YBus<sym> const& y_bus) {
         if (calculation_method != CalculationMethod::default_method &&
             calculation_method != CalculationMethod::iec60909) {
             throw InvalidCalculationMethod{};
@@ -82,62 +116,118 @@ template <bool sym> class MathSolver {
 
         // construct model if needed
         if (!iec60909_sc_solver_.has_value()) {
-            Timer const timer(calculation_info, 2210, "Create math solver");
+            InstrumentedTimer const timer(2210, "Create math solver");
             iec60909_sc_solver_.emplace(y_bus, topo_ptr_);
         }
+        iec60909_sc_solver_.value().set_threading(n_thread_);
 
         // call calculation
-        return iec60909_sc_solver_.value().run_short_circuit(y_bus, input);
+        return iec60909_sc_solver_.value().run_short_circuit(y_bus, inputs);
     }
 
+    // set number of threads to parallelize the sparse LU factorization of a single calculation
+    void set_threading(Idx n_thread) { n_thread_ = n_thread; }
+
     void clear_solver() {
         newton_pf_solver_.reset();
         linear_pf_solver_.reset();
         iterative_current_pf_solver_.reset();
+        fast_decoupled_pf_solver_.reset();
         iterative_linear_se_solver_.reset();
+        newton_raphson_se_solver_.reset();
     }
 
   private:
     std::shared_ptr<MathModelTopology const> topo_ptr_;
     bool all_const_y_; // if all the load_gen is const element_admittance (impedance) type
+    Idx n_thread_{1};
     std::optional<NewtonRaphsonPFSolver<sym>> newton_pf_solver_;
     std::optional<LinearPFSolver<sym>> linear_pf_solver_;
     std::optional<IterativeLinearSESolver<sym>> iterative_linear_se_solver_;
+    std::optional<NewtonRaphsonSESolver<sym>> newton_raphson_se_solver_;
     std::optional<IterativeCurrentPFSolver<sym>> iterative_current_pf_solver_;
+    std::optional<FastDecoupledPFSolver<sym>> fast_decoupled_pf_solver_;
     std::optional<ShortCircuitSolver<sym>> iec60909_sc_solver_;
 
     MathOutput<sym> run_power_flow_newton_raphson(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
-                                                  CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+                                                  CalculationInfo& calculation_info, YBus<sym> const& y_bus,
+                                                  PowerFlowInitialization initialization) {
         if (!newton_pf_solver_.has_value()) {
-            Timer const timer(calculation_info, 2210, "Create math solver");
+            InstrumentedTimer const timer(2210, "Create math solver");
             newton_pf_solver_.emplace(y_bus, topo_ptr_);
         }
-        return newton_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info);
+        newton_pf_solver_.value().set_threading(n_thread_);
+        return newton_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info,
+                                                        initialization);
     }
 
     MathOutput<sym> run_power_flow_linear(PowerFlowInput<sym> const& input, double /* err_tol */, Idx /* max_iter */,
                                           CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
         if (!linear_pf_solver_.has_value()) {
-            Timer const timer(calculation_info, 2210, "Create math solver");
+            InstrumentedTimer const timer(2210, "Create math solver");
             linear_pf_solver_.emplace(y_bus, topo_ptr_);
         }
+        linear_pf_solver_.value().set_threading(n_thread_);
         return linear_pf_solver_.value().run_power_flow(y_bus, input, calculation_info);
     }
 
     MathOutput<sym> run_power_flow_iterative_current(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
-                                                     CalculationInfo& calculation_info, YBus<sym> const& y_bus) {
+                                                     CalculationInfo& calculation_info, YBus<sym> const& y_bus,
+                                                     PowerFlowInitialization initialization) {
         if (!iterative_current_pf_solver_.has_value()) {
-            Timer const timer(calculation_info, 2210, "Create math solver");
+            InstrumentedTimer const timer(2210, "Create math solver");
             iterative_current_pf_solver_.emplace(y_bus, topo_ptr_);
         }
-        return iterative_current_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info);
+        iterative_current_pf_solver_.value().set_threading(n_thread_);
+        return iterative_current_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info,
+                                                                   initialization);
+    }
+
+    MathOutput<sym> run_power_flow_fast_decoupled(PowerFlowInput<sym> const& input, double err_tol, Idx max_iter,
+                                                  CalculationInfo& calculation_info, YBus<sym> const& y_bus,
+                                                  PowerFlowInitialization initialization) {
+        if (!fast_decoupled_pf_solver_.has_value()) {
+            InstrumentedTimer const timer(2210, "Create math solver");
+            fast_decoupled_pf_solver_.emplace(y_bus, topo_ptr_);
+        }
+        fast_decoupled_pf_solver_.value().set_threading(n_thread_);
+        return fast_decoupled_pf_solver_.value().run_power_flow(y_bus, input, err_tol, max_iter, calculation_info,
+                                                                initialization);
+    }
+
+    MathOutput<sym> run_state_estimation_iterative_linear(StateEstimationInput<sym> const& input, double err_tol,
+                                                          Idx max_iter, CalculationInfo& calculation_info,
+                                                          YBus<sym> const& y_bus) {
+        // construct model if needed
+        if (!iterative_linear_se_solver_.has_value()) {
+            InstrumentedTimer const timer(2210, "Create math solver");
+            iterative_linear_se_solver_.emplace(y_bus, topo_ptr_);
+        }
+        iterative_linear_se_solver_.value().set_threading(n_thread_);
+
+        // call calculation
+        return iterative_linear_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter,
+                                                                        calculation_info);
+    }
+
+    MathOutput<sym> run_state_estimation_newton_raphson(StateEstimationInput<sym> const& input, double err_tol,
+                                                        Idx max_iter, CalculationInfo& calculation_info,
+                                                        YBus<sym> const& y_bus) {
+        if (!newton_raphson_se_solver_.has_value()) {
+            InstrumentedTimer const timer(2210, "Create math solver");
+            newton_raphson_se_solver_.emplace(y_bus, topo_ptr_);
+        }
+        newton_raphson_se_solver_.value().set_threading(n_thread_);
+        return newton_raphson_se_solver_.value().run_state_estimation(y_bus, input, err_tol, max_iter,
+                                                                      calculation_info);
     }
 
     MathOutput<sym> run_power_flow_linear_current(PowerFlowInput<sym> const& input, double /* err_tol */,
                                                   Idx /* max_iter */, CalculationInfo& calculation_info,
                                                   YBus<sym> const& y_bus) {
+        // the linear current method is defined as one iteration from flat start
         return run_power_flow_iterative_current(input, std::numeric_limits<double>::infinity(), 1, calculation_info,
-                                                y_bus);
+                                                y_bus, PowerFlowInitialization::flat_start);
     }
 };
 
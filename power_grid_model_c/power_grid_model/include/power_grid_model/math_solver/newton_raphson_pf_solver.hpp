@@ -212,6 +212,9 @@ template <bool sym> class NewtonRaphsonPFSolver : public IterativePFSolver<sym,
           sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
           perm_(y_bus.size()) {}
 
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
+
     // Initilize the unknown variable in polar form
     void initialize_derived_solver(YBus<sym> const& /* y_bus */, MathOutput<sym> const& output) {
         // get magnitude and angle of start voltage
@@ -239,7 +242,12 @@ template <bool sym> class NewtonRaphsonPFSolver : public IterativePFSolver<sym,
     }
 
     // Solve the linear Equations
-    void solve_matrix() { sparse_solver_.prefactorize_and_solve(data_jac_, perm_, del_x_pq_, del_x_pq_); }
+    // the block permutations of the previous factorization are re-used as static pivots,
+    //     both across iterations and across calculations with the same topology
+    void solve_matrix() {
+        sparse_solver_.prefactorize_and_solve(data_jac_, perm_, del_x_pq_, del_x_pq_, has_block_perm_);
+        has_block_perm_ = true;
+    }
 
     // Get maximum deviation among all bus voltages
     double iterate_unknown(ComplexValueVector<sym>& u) {
@@ -275,6 +283,8 @@ template <bool sym> class NewtonRaphsonPFSolver : public IterativePFSolver<sym,
     SparseLUSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>> sparse_solver_;
     // permutation array
     typename SparseLUSolver<PFJacBlock<sym>, ComplexPower<sym>, PolarPhasor<sym>>::BlockPermArray perm_;
+    // permutation array contains the result of a previous factorization
+    bool has_block_perm_{false};
 
     static PFJacBlock<sym> calculate_hnml(ComplexTensor<sym> const& yij, ComplexValue<sym> const& ui,
                                           ComplexValue<sym> const& uj) {
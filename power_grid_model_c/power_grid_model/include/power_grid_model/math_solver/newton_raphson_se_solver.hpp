@@ -0,0 +1,543 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_MATH_SOLVER_NEWTON_RAPHSON_SE_SOLVER_HPP
+#define POWER_GRID_MODEL_MATH_SOLVER_NEWTON_RAPHSON_SE_SOLVER_HPP
+
+/*
+Newton Raphson state estimation solver
+
+****** Unknown
+The voltage is in polar coordinate, the same as Newton-Raphson power flow
+U_i = V_i * exp(1j * theta_i)
+The increment of the unknown is
+del_x_i = [del_theta_i, del_V_i/V_i]^T
+
+****** Measurement
+The measurements are split in two groups
+z = [
+        V_i, theta_i (if angle is measured)  for voltage measurement
+        P, Q                                 for branch/shunt flow measurement
+    ]
+z_c = [P_i, Q_i]                             for bus injection measurement
+
+The objective is the weighted least square of z, subject to the bus injection measurement with its variance
+    min 1/2 * (z - h(x))^T W (z - h(x)) + 1/2 * e^T R^-1 e
+    subject to c(x) + e = z_c
+
+****** Iteration
+The Gauss-Newton iteration of the WLS problem is written in the augmented (Hachtel) form,
+    so the sparsity of the gain matrix is the same as the sparsity of the Y bus, even with bus injection measurements.
+[
+   [G = H^T W H,  C^T],
+   [C,            -R ]
+] *
+[
+    del_x,
+    lambda
+] =
+[
+    H^T W (z - h(x)),
+    z_c - c(x)
+]
+H = dh/dx
+C = dc/dx
+R = diag(variance), if the bus has no injection measurement, R = 1 and C = 0
+
+****** Jacobian of power
+S_m = diag(U_m) * conj(sum_b{Y_mb * U_b})
+M_mb = diag(U_m) * conj(Y_mb) * diag(conj(U_b))
+
+dP_m/dtheta_b = Im(M_mb)
+dP_m/dV_b * V_b = Re(M_mb)
+dQ_m/dtheta_b = -Re(M_mb)
+dQ_m/dV_b * V_b = Im(M_mb)
+
+if m == b, correct the diagonal for the dependency via U_m
+dP_m/dtheta_m += diag(-Q_m)
+dP_m/dV_m * V_m += diag(P_m)
+dQ_m/dtheta_m += diag(P_m)
+dQ_m/dV_m * V_m += diag(Q_m)
+
+****** Angle reference
+Without any voltage angle measurement, all the angles can be shifted together.
+The increment of the angle at the slack bus is then penalized with a zero residual.
+This only fixes the reference of the angle and does not change the estimated state.
+*/
+
+#include "block_matrix.hpp"
+#include "measured_values.hpp"
+#include "observability.hpp"
+#include "sparse_lu_solver.hpp"
+#include "y_bus.hpp"
+
+#include "../calculation_parameters.hpp"
+#include "../exception.hpp"
+#include "../instrumentation.hpp"
+#include "../power_grid_model.hpp"
+#include "../three_phase_tensor.hpp"
+#include "../timer.hpp"
+
+namespace power_grid_model {
+
+// hide implementation in inside namespace
+namespace math_model_impl {
+
+// block class for the unknown vector and/or right-hand side in Newton-Raphson state estimation equation
+// [del_theta, del_v/v, lambda_p, lambda_q]
+template <bool sym> struct NRSEUnknown : public Block<double, sym, false, 4> {
+    static constexpr int n_half = sym ? 2 : 6;
+
+    // eigen expression
+    using Block<double, sym, false, 4>::Block;
+    using Block<double, sym, false, 4>::operator=;
+
+    auto del_x() { return this->template head<n_half>(); }
+    auto lambda() { return this->template tail<n_half>(); }
+
+    auto eta() { return this->template head<n_half>(); }
+    auto tau() { return this->template tail<n_half>(); }
+};
+
+// block class for the right hand side in Newton-Raphson state estimation equation
+template <bool sym> using NRSERhs = NRSEUnknown<sym>;
+
+// class of 4*4 (12*12) Newton-Raphson se gain block
+/*
+[
+   [G, QT]
+   [Q, R ]
+]
+*/
+template <bool sym> class NRSEGainBlock : public Block<double, sym, true, 4> {
+  public:
+    static constexpr int n_half = sym ? 2 : 6;
+
+    // eigen expression
+    using Block<double, sym, true, 4>::Block;
+    using Block<double, sym, true, 4>::operator=;
+
+    auto g() { return this->template topLeftCorner<n_half, n_half>(); }
+    auto qt() { return this->template topRightCorner<n_half, n_half>(); }
+    auto q() { return this->template bottomLeftCorner<n_half, n_half>(); }
+    auto r() { return this->template bottomRightCorner<n_half, n_half>(); }
+};
+
+// solver
+template <bool sym> class NewtonRaphsonSESolver {
+    static constexpr int n_phase = sym ? 1 : 3;
+    static constexpr int n_half = 2 * n_phase;
+
+    using PhaseVector = Eigen::Matrix<DoubleComplex, n_phase, 1>;
+    using PhaseTensor = Eigen::Matrix<DoubleComplex, n_phase, n_phase>;
+    // jacobian of [P, Q] w.r.t. [theta, v] of one bus
+    using Jacobian = Eigen::Matrix<double, n_half, n_half>;
+    using PowerResidual = Eigen::Matrix<double, n_half, 1>;
+
+    // linearized power flow measurement of a branch side or a shunt
+    struct FlowMeasurement {
+        // jacobian w.r.t. the bus at from-side (0) and to-side (1) of the branch
+        std::array<Jacobian, 2> jac{Jacobian::Zero(), Jacobian::Zero()};
+        PowerResidual residual{PowerResidual::Zero()};
+        double weight{};
+    };
+
+  public:
+    NewtonRaphsonSESolver(YBus<sym> const& y_bus, std::shared_ptr<MathModelTopology const> topo_ptr)
+        : n_bus_{y_bus.size()},
+          math_topo_{std::move(topo_ptr)},
+          data_gain_(y_bus.nnz_lu()),
+          x_rhs_(y_bus.size()),
+          branch_measurement_(math_topo_->n_branch()),
+          shunt_measurement_(math_topo_->n_shunt()),
+          sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
+          perm_(y_bus.size()) {}
+
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
+
+    MathOutput<sym> run_state_estimation(YBus<sym> const& y_bus, StateEstimationInput<sym> const& input, double err_tol,
+                                         Idx max_iter, CalculationInfo& calculation_info) {
+        // prepare
+        InstrumentedTimer main_timer;
+        InstrumentedTimer sub_timer;
+        MathOutput<sym> output;
+        output.u.resize(n_bus_);
+        output.bus_injection.resize(n_bus_);
+        double max_dev = std::numeric_limits<double>::max();
+
+        main_timer = InstrumentedTimer(2220, "Math solver");
+
+        // preprocess measured value
+        sub_timer = InstrumentedTimer(2221, "Pre-process measured value");
+        MeasuredValues<sym> const measured_values{y_bus, input};
+        observability_check_.check(measured_values, *math_topo_);
+
+        // initialize voltage with initial angle
+        sub_timer = InstrumentedTimer(2223, "Initialize voltages");
+        RealValue<sym> const mean_angle_shift = measured_values.mean_angle_shift();
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            output.u[bus] = exp(1.0i * (mean_angle_shift + math_topo_->phase_shift[bus]));
+        }
+
+        // loop to iterate
+        Idx num_iter = 0;
+        do {
+            if (num_iter++ == max_iter) {
+                throw IterationDiverge{max_iter, max_dev, err_tol};
+            }
+            sub_timer = InstrumentedTimer(2224, "Calculate jacobian and rhs");
+            prepare_matrix_and_rhs(y_bus, measured_values, output.u);
+            sub_timer = InstrumentedTimer(2225, "Solve sparse linear equation");
+            sparse_solver_.prefactorize_and_solve(data_gain_, perm_, x_rhs_, x_rhs_);
+            sub_timer = InstrumentedTimer(2226, "Iterate unknown");
+            max_dev = iterate_unknown(output.u);
+        } while (max_dev > err_tol);
+
+        // calculate math result
+        sub_timer = InstrumentedTimer(2227, "Calculate Math Result");
+        calculate_result(y_bus, measured_values, output);
+
+        // Manually stop timers to avoid "Max number of iterations" to be included in the timing.
+        sub_timer.stop();
+        main_timer.stop();
+
+        static auto const key = Timer::make_key(2228, "Max number of iterations");
+        calculation_info[key] = std::max(calculation_info[key], (double)num_iter);
+        static auto const deviation_key = Timer::make_key(2229, "Max final deviation");
+        calculation_info[deviation_key] = std::max(calculation_info[deviation_key], max_dev);
+
+        return output;
+    }
+
+  private:
+    // array selection function pointer
+    static constexpr std::array has_branch_{&MeasuredValues<sym>::has_branch_from, &MeasuredValues<sym>::has_branch_to};
+    static constexpr std::array branch_power_{&MeasuredValues<sym>::branch_from_power,
+                                              &MeasuredValues<sym>::branch_to_power};
+
+    Idx n_bus_;
+    // shared topo data
+    std::shared_ptr<MathModelTopology const> math_topo_;
+    // cached result of the necessary observability check
+    ObservabilityCheck<sym> observability_check_;
+
+    // data for gain matrix
+    std::vector<NRSEGainBlock<sym>> data_gain_;
+    // unknown and rhs
+    std::vector<NRSERhs<sym>> x_rhs_;
+    // linearized flow measurements of the current iteration
+    std::vector<std::array<FlowMeasurement, 2>> branch_measurement_;
+    std::vector<FlowMeasurement> shunt_measurement_;
+    // solver
+    SparseLUSolver<NRSEGainBlock<sym>, NRSERhs<sym>, NRSEUnknown<sym>> sparse_solver_;
+    typename SparseLUSolver<NRSEGainBlock<sym>, NRSERhs<sym>, NRSEUnknown<sym>>::BlockPermArray perm_;
+
+    static PhaseVector to_phase(ComplexValue<sym> const& x) {
+        if constexpr (sym) {
+            return PhaseVector::Constant(x);
+        } else {
+            return x.matrix();
+        }
+    }
+    static PhaseTensor to_phase_tensor(ComplexTensor<sym> const& x) {
+        if constexpr (sym) {
+            return PhaseTensor::Constant(x);
+        } else {
+            return x.matrix();
+        }
+    }
+
+    static RealValue<sym> to_value(Eigen::Array<double, n_phase, 1> const& x) {
+        if constexpr (sym) {
+            return x(0);
+        } else {
+            return RealValue<false>{x};
+        }
+    }
+
+    // jacobian of S_m = diag(U_m) * conj(Y_mb * U_b) w.r.t. the voltage at bus b, excluding the dependency via U_m
+    static Jacobian power_jacobian(PhaseTensor const& y_mb, PhaseVector const& u_m, PhaseVector const& u_b) {
+        PhaseTensor const m = u_m.asDiagonal() * y_mb.conjugate() * u_b.conjugate().asDiagonal();
+        Jacobian jac;
+        jac << m.imag(), m.real(), -m.real(), m.imag();
+        return jac;
+    }
+
+    // add the dependency via U_m to the jacobian of S_m w.r.t. the voltage at bus m
+    static void add_power_diag(Jacobian& jac, PhaseVector const& s_m) {
+        jac.template topLeftCorner<n_phase, n_phase>().diagonal() -= s_m.imag();
+        jac.template topRightCorner<n_phase, n_phase>().diagonal() += s_m.real();
+        jac.template bottomLeftCorner<n_phase, n_phase>().diagonal() += s_m.real();
+        jac.template bottomRightCorner<n_phase, n_phase>().diagonal() += s_m.imag();
+    }
+
+    static PowerResidual power_residual(ComplexValue<sym> const& measured, ComplexValue<sym> const& calculated) {
+        PhaseVector const del_s = to_phase(measured) - to_phase(calculated);
+        PowerResidual residual;
+        residual << del_s.real(), del_s.imag();
+        return residual;
+    }
+
+    // linearize all branch and shunt flow measurements around the current voltage
+    void linearize_flow_measurements(YBus<sym> const& y_bus, MeasuredValues<sym> const& measured_value,
+                                     ComplexValueVector<sym> const& u) {
+        MathModelParam<sym> const& param = y_bus.math_model_param();
+        std::vector<BranchIdx> const& branch_bus_idx = math_topo_->branch_bus_idx;
+        auto const branch_flow = y_bus.template calculate_branch_flow<BranchMathOutput<sym>>(u);
+        auto const shunt_flow = y_bus.template calculate_shunt_flow<ApplianceMathOutput<sym>>(u);
+
+        for (Idx branch = 0; branch != math_topo_->n_branch(); ++branch) {
+            std::array<ComplexValue<sym>, 2> const s_calc{branch_flow[branch].s_f, branch_flow[branch].s_t};
+            // measured at from-side: 0, to-side: 1
+            for (IntS const measured_side : std::array<IntS, 2>{0, 1}) {
+                FlowMeasurement& measurement = branch_measurement_[branch][measured_side];
+                if (!std::invoke(has_branch_[measured_side], measured_value, branch)) {
+                    measurement.weight = 0.0;
+                    continue;
+                }
+                SensorCalcParam<sym> const& m = std::invoke(branch_power_[measured_side], measured_value, branch);
+                Idx const measured_bus = branch_bus_idx[branch][measured_side];
+                PhaseVector const u_m = to_phase(u[measured_bus]);
+                for (IntS const b : std::array<IntS, 2>{0, 1}) {
+                    Idx const bus = branch_bus_idx[branch][b];
+                    if (bus == -1) {
+                        measurement.jac[b] = Jacobian::Zero();
+                        continue;
+                    }
+                    PhaseTensor const y_mb = to_phase_tensor(param.branch_param[branch].value[measured_side * 2 + b]);
+                    measurement.jac[b] = power_jacobian(y_mb, u_m, to_phase(u[bus]));
+                }
+                add_power_diag(measurement.jac[measured_side], to_phase(s_calc[measured_side]));
+                measurement.residual = power_residual(m.value, s_calc[measured_side]);
+                measurement.weight = 1.0 / m.variance;
+            }
+        }
+
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            for (Idx shunt = math_topo_->shunt_bus_indptr[bus]; shunt != math_topo_->shunt_bus_indptr[bus + 1];
+                 ++shunt) {
+                FlowMeasurement& measurement = shunt_measurement_[shunt];
+                if (!measured_value.has_shunt(shunt)) {
+                    measurement.weight = 0.0;
+                    continue;
+                }
+                SensorCalcParam<sym> const& m = measured_value.shunt_power(shunt);
+                PhaseVector const u_bus = to_phase(u[bus]);
+                // NOTE: the negative sign for injection direction!
+                measurement.jac[0] = power_jacobian(-to_phase_tensor(param.shunt_param[shunt]), u_bus, u_bus);
+                add_power_diag(measurement.jac[0], to_phase(shunt_flow[shunt].s));
+                measurement.residual = power_residual(m.value, shunt_flow[shunt].s);
+                measurement.weight = 1.0 / m.variance;
+            }
+        }
+    }
+
+    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, MeasuredValues<sym> const& measured_value,
+                                ComplexValueVector<sym> const& u) {
+        IdxVector const& row_indptr = y_bus.row_indptr_lu();
+        IdxVector const& col_indices = y_bus.col_indices_lu();
+        ComplexValueVector<sym> const s_calc = y_bus.calculate_injection(u);
+        ComplexValueVector<sym> const u_measured = measured_value.voltage(u);
+
+        linearize_flow_measurements(y_bus, measured_value, u);
+
+        // loop data index, all rows and columns
+        for (Idx row = 0; row != n_bus_; ++row) {
+            for (Idx data_idx_lu = row_indptr[row]; data_idx_lu != row_indptr[row + 1]; ++data_idx_lu) {
+                Idx const col = col_indices[data_idx_lu];
+                // get a reference and reset block to zero
+                NRSEGainBlock<sym>& block = data_gain_[data_idx_lu];
+                block = NRSEGainBlock<sym>{};
+                // get data idx of y bus,
+                // skip for a fill-in
+                Idx const data_idx = y_bus.map_lu_y_bus()[data_idx_lu];
+                if (data_idx == -1) {
+                    continue;
+                }
+                // fill block with voltage measurement, only diagonal
+                if (row == col) {
+                    add_voltage_measurement(block, measured_value, row, to_phase(u[row]));
+                }
+                // fill block with branch, shunt measurement
+                for (Idx element_idx = y_bus.y_bus_entry_indptr()[data_idx];
+                     element_idx != y_bus.y_bus_entry_indptr()[data_idx + 1]; ++element_idx) {
+                    Idx const obj = y_bus.y_bus_element()[element_idx].idx;
+                    YBusElementType const type = y_bus.y_bus_element()[element_idx].element_type;
+                    // shunt
+                    if (type == YBusElementType::shunt) {
+                        if (measured_value.has_shunt(obj)) {
+                            FlowMeasurement const& measurement = shunt_measurement_[obj];
+                            // G += H^T * H / variance
+                            block.g() +=
+                                (measurement.jac[0].transpose() * measurement.jac[0] * measurement.weight).array();
+                        }
+                    }
+                    // branch
+                    else {
+                        // branch from- and to-side index at 0, and 1 position
+                        IntS const b0 = static_cast<IntS>(type) / 2;
+                        IntS const b1 = static_cast<IntS>(type) % 2;
+                        // measured at from-side: 0, to-side: 1
+                        for (IntS const measured_side : std::array<IntS, 2>{0, 1}) {
+                            // has measurement
+                            if (std::invoke(has_branch_[measured_side], measured_value, obj)) {
+                                FlowMeasurement const& measurement = branch_measurement_[obj][measured_side];
+                                // G += H{side, b0}^T * H{side, b1} / variance
+                                block.g() += (measurement.jac[b0].transpose() * measurement.jac[b1] *
+                                              measurement.weight)
+                                                 .array();
+                            }
+                        }
+                    }
+                }
+                // fill block with injection measurement
+                // injection measurement exist
+                if (measured_value.has_bus_injection(row)) {
+                    // Q_ij = dS_i/dx_j
+                    Jacobian jac = power_jacobian(to_phase_tensor(y_bus.admittance()[data_idx]), to_phase(u[row]),
+                                                  to_phase(u[col]));
+                    // R_ii = -variance, only diagonal
+                    if (row == col) {
+                        add_power_diag(jac, to_phase(s_calc[row]));
+                        block.r() = -Jacobian::Identity().array() * measured_value.bus_injection(row).variance;
+                    }
+                    block.q() = jac.array();
+                }
+                // injection measurement not exist
+                else {
+                    // Q_ij = 0
+                    // R_ii = -1.0, only diagonal
+                    if (row == col) {
+                        block.r() = -Jacobian::Identity().array();
+                    }
+                }
+                // fix the angle reference at the slack bus, if there is no angle measurement
+                if (row == col && row == math_topo_->slack_bus_ && !measured_value.has_angle_measurement()) {
+                    block.g().template topLeftCorner<n_phase, n_phase>() +=
+                        Eigen::Matrix<double, n_phase, n_phase>::Identity().array();
+                }
+            }
+        }
+
+        // loop all transpose entry for QT
+        // assign the transpose of the transpose entry of Q
+        for (Idx data_idx_lu = 0; data_idx_lu != y_bus.nnz_lu(); ++data_idx_lu) {
+            // skip for fill-in
+            if (y_bus.map_lu_y_bus()[data_idx_lu] == -1) {
+                continue;
+            }
+            Idx const data_idx_tranpose = y_bus.lu_transpose_entry()[data_idx_lu];
+            data_gain_[data_idx_lu].qt() = data_gain_[data_idx_tranpose].q().transpose();
+        }
+
+        prepare_rhs(measured_value, u, s_calc, u_measured);
+    }
+
+    // voltage magnitude and angle measurement
+    // the deviation in angle is weighted with the magnitude, as if the phasor is measured
+    static void add_voltage_measurement(NRSEGainBlock<sym>& block, MeasuredValues<sym> const& measured_value, Idx bus,
+                                        PhaseVector const& u) {
+        if (!measured_value.has_voltage(bus)) {
+            return;
+        }
+        Eigen::Array<double, n_phase, 1> const weight = u.cwiseAbs2().array() / measured_value.voltage_var(bus);
+        // G_vv += V^2 / variance
+        block.g().template bottomRightCorner<n_phase, n_phase>().matrix().diagonal() += weight.matrix();
+        if (measured_value.has_angle_measurement(bus)) {
+            // G_theta_theta += V^2 / variance
+            block.g().template topLeftCorner<n_phase, n_phase>().matrix().diagonal() += weight.matrix();
+        }
+    }
+
+    void prepare_rhs(MeasuredValues<sym> const& measured_value, ComplexValueVector<sym> const& u,
+                     ComplexValueVector<sym> const& s_calc, ComplexValueVector<sym> const& u_measured) {
+        std::vector<BranchIdx> const& branch_bus_idx = math_topo_->branch_bus_idx;
+
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            // reset rhs block to fill values
+            NRSERhs<sym>& rhs_block = x_rhs_[bus];
+            rhs_block = NRSERhs<sym>{};
+            // fill block with voltage measurement
+            if (measured_value.has_voltage(bus)) {
+                PhaseVector const u_bus = to_phase(u[bus]);
+                PhaseVector const u_m = to_phase(u_measured[bus]);
+                Eigen::Array<double, n_phase, 1> const v = u_bus.cwiseAbs().array();
+                double const variance = measured_value.voltage_var(bus);
+                // v part += V * (V_measured - V) / variance
+                rhs_block.eta().template tail<n_phase>() += v * (u_m.cwiseAbs().array() - v) / variance;
+                if (measured_value.has_angle_measurement(bus)) {
+                    // theta part += V^2 * (theta_measured - theta) / variance
+                    rhs_block.eta().template head<n_phase>() +=
+                        v * v * (u_m.array() * u_bus.conjugate().array()).arg() / variance;
+                }
+            }
+            // fill block with shunt measurement
+            for (Idx shunt = math_topo_->shunt_bus_indptr[bus]; shunt != math_topo_->shunt_bus_indptr[bus + 1];
+                 ++shunt) {
+                FlowMeasurement const& measurement = shunt_measurement_[shunt];
+                // x += H^T * (z - h(x)) / variance
+                rhs_block.eta() +=
+                    (measurement.jac[0].transpose() * measurement.residual * measurement.weight).array();
+            }
+            // fill block with injection measurement
+            if (measured_value.has_bus_injection(bus)) {
+                rhs_block.tau() = power_residual(measured_value.bus_injection(bus).value, s_calc[bus]).array();
+            }
+        }
+
+        // fill block with branch measurement, at both sides of the branch
+        for (Idx branch = 0; branch != math_topo_->n_branch(); ++branch) {
+            for (IntS const b : std::array<IntS, 2>{0, 1}) {
+                Idx const bus = branch_bus_idx[branch][b];
+                if (bus == -1) {
+                    continue;
+                }
+                for (FlowMeasurement const& measurement : branch_measurement_[branch]) {
+                    // x += H{side, b}^T * (z - h(x)) / variance
+                    x_rhs_[bus].eta() +=
+                        (measurement.jac[b].transpose() * measurement.residual * measurement.weight).array();
+                }
+            }
+        }
+    }
+
+    double iterate_unknown(ComplexValueVector<sym>& u) {
+        double max_dev = 0.0;
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            auto const del_x = x_rhs_[bus].del_x();
+            RealValue<sym> const del_theta = to_value(del_x.template head<n_phase>());
+            RealValue<sym> const del_v = to_value(del_x.template tail<n_phase>());
+            // U = V * (1 + del_V / V) * exp(1i * (theta + del_theta))
+            ComplexValue<sym> const u_tmp = u[bus] * (1.0 + del_v) * exp(1.0i * del_theta);
+            // get dev of last iteration, get max
+            double const dev = max_val(cabs(u_tmp - u[bus]));
+            max_dev = std::max(dev, max_dev);
+            // assign
+            u[bus] = u_tmp;
+        }
+        return max_dev;
+    }
+
+    void calculate_result(YBus<sym> const& y_bus, MeasuredValues<sym> const& measured_value, MathOutput<sym>& output) {
+        // call y bus
+        output.branch = y_bus.template calculate_branch_flow<BranchMathOutput<sym>>(output.u);
+        output.shunt = y_bus.template calculate_shunt_flow<ApplianceMathOutput<sym>>(output.u);
+        output.bus_injection = y_bus.calculate_injection(output.u);
+        std::tie(output.load_gen, output.source) =
+            measured_value.calculate_load_gen_source(output.u, output.bus_injection);
+    }
+};
+
+template class NewtonRaphsonSESolver<true>;
+template class NewtonRaphsonSESolver<false>;
+
+} // namespace math_model_impl
+
+template <bool sym> using NewtonRaphsonSESolver = math_model_impl::NewtonRaphsonSESolver<sym>;
+
+} // namespace power_grid_model
+
+#endif
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_MATH_SOLVER_OBSERVABILITY_HPP
+#define POWER_GRID_MODEL_MATH_SOLVER_OBSERVABILITY_HPP
+
+/*
+necessary observability check for state estimation
+
+The state estimation has one unknown voltage phasor per bus (per phase).
+Every valid measurement gives at most one complex equation:
+    voltage (magnitude only or phasor) of a bus,
+    power flow at one side of a branch, power flow of a shunt,
+    power injection of a bus (including zero injection of a bus without connected appliances).
+The gain matrix is singular, i.e. the system is not observable, if
+    - the number of measurements is smaller than the number of buses; or
+    - a bus does not appear in any measurement equation:
+        the bus has no voltage measurement, no measured shunt,
+        no measured flow at any side of a branch connected to the bus,
+        and no injection measurement at the bus itself or at a neighbouring bus.
+The conditions are only necessary: passing the check does not guarantee that the system is observable.
+
+The check only depends on which quantities are measured, not on the measured values.
+The result is cached for the last measurement pattern, so a batch with the same sensor status pattern only pays once.
+*/
+
+#include "measured_values.hpp"
+
+#include "../calculation_parameters.hpp"
+#include "../exception.hpp"
+#include "../power_grid_model.hpp"
+
+namespace power_grid_model {
+
+// hide implementation in inside namespace
+namespace math_model_impl {
+
+template <bool sym> class ObservabilityCheck {
+  public:
+    // throw NotObservableError if the measurements cannot make the system observable
+    void check(MeasuredValues<sym> const& measured_values, MathModelTopology const& topo) {
+        std::vector<bool> pattern = measurement_pattern(measured_values, topo);
+        if (!has_result_ || pattern != pattern_) {
+            error_msg_ = check_pattern(pattern, topo);
+            pattern_ = std::move(pattern);
+            has_result_ = true;
+        }
+        if (!error_msg_.empty()) {
+            throw NotObservableError{error_msg_};
+        }
+    }
+
+  private:
+    bool has_result_{false};
+    std::vector<bool> pattern_;
+    // empty if the check passed
+    std::string error_msg_;
+
+    // pattern of valid measurements
+    // [voltage of bus, injection of bus]... [from-side of branch, to-side of branch]... [shunt]...
+    static std::vector<bool> measurement_pattern(MeasuredValues<sym> const& measured_values,
+                                                 MathModelTopology const& topo) {
+        std::vector<bool> pattern;
+        pattern.reserve(2 * (topo.n_bus() + topo.n_branch()) + topo.n_shunt());
+        for (Idx bus = 0; bus != topo.n_bus(); ++bus) {
+            pattern.push_back(measured_values.has_voltage(bus));
+            pattern.push_back(measured_values.has_bus_injection(bus));
+        }
+        // a flow measurement can be present with infinite variance, it is then not a valid measurement
+        // NOTE: if all measurements have infinite variance, the normalized variance is NaN
+        for (Idx branch = 0; branch != topo.n_branch(); ++branch) {
+            pattern.push_back(measured_values.has_branch_from(branch) &&
+                              std::isfinite(measured_values.branch_from_power(branch).variance));
+            pattern.push_back(measured_values.has_branch_to(branch) &&
+                              std::isfinite(measured_values.branch_to_power(branch).variance));
+        }
+        for (Idx shunt = 0; shunt != topo.n_shunt(); ++shunt) {
+            pattern.push_back(measured_values.has_shunt(shunt) &&
+                              std::isfinite(measured_values.shunt_power(shunt).variance));
+        }
+        return pattern;
+    }
+
+    static std::string check_pattern(std::vector<bool> const& pattern, MathModelTopology const& topo) {
+        Idx const n_bus = topo.n_bus();
+        Idx const n_branch = topo.n_branch();
+        auto const has_voltage = [&pattern](Idx bus) { return pattern[2 * bus]; };
+        auto const has_injection = [&pattern](Idx bus) { return pattern[2 * bus + 1]; };
+        auto const has_branch_flow = [&pattern, n_bus](Idx branch, Idx side) {
+            return pattern[2 * n_bus + 2 * branch + side];
+        };
+        auto const has_shunt = [&pattern, n_bus, n_branch](Idx shunt) {
+            return pattern[2 * (n_bus + n_branch) + shunt];
+        };
+
+        // count check
+        auto const n_measurement = static_cast<Idx>(std::count(pattern.cbegin(), pattern.cend(), true));
+        if (n_measurement < n_bus) {
+            return "There are " + std::to_string(n_measurement) + " valid measurements for " +
+                   std::to_string(n_bus) + " buses.\n";
+        }
+
+        // every bus should appear in at least one measurement equation
+        std::vector<bool> covered(n_bus, false);
+        for (Idx bus = 0; bus != n_bus; ++bus) {
+            if (has_voltage(bus) || has_injection(bus)) {
+                covered[bus] = true;
+            }
+            for (Idx shunt = topo.shunt_bus_indptr[bus]; shunt != topo.shunt_bus_indptr[bus + 1]; ++shunt) {
+                if (has_shunt(shunt)) {
+                    covered[bus] = true;
+                }
+            }
+        }
+        for (Idx branch = 0; branch != n_branch; ++branch) {
+            auto const [bus_from, bus_to] = topo.branch_bus_idx[branch];
+            // a flow measurement depends on the voltage at both sides
+            bool const flow_measured = has_branch_flow(branch, 0) || has_branch_flow(branch, 1);
+            // an injection measurement depends on the voltage of the neighbouring buses
+            if (bus_from != -1) {
+                covered[bus_from] = covered[bus_from] || flow_measured || (bus_to != -1 && has_injection(bus_to));
+            }
+            if (bus_to != -1) {
+                covered[bus_to] = covered[bus_to] || flow_measured || (bus_from != -1 && has_injection(bus_from));
+            }
+        }
+        if (auto const n_uncovered = static_cast<Idx>(std::count(covered.cbegin(), covered.cend(), false));
+            n_uncovered > 0) {
+            return std::to_string(n_uncovered) +
+                   " bus(es) without any voltage, flow or injection measurement at or next to the bus.\n";
+        }
+        return {};
+    }
+};
+
+template class ObservabilityCheck<true>;
+template class ObservabilityCheck<false>;
+
+} // namespace math_model_impl
+
+} // namespace power_grid_model
+
+#endif
@@ -14,6 +14,8 @@
 #include "../enum.hpp"
 #include "../exception.hpp"
 
+#include <span>
+
 namespace power_grid_model {
 
 // hide implementation in inside namespace
@@ -31,9 +33,22 @@ template <bool sym> class ShortCircuitSolver {
           source_bus_indptr_{topo_ptr, &topo_ptr->source_bus_indptr},
           mat_data_(y_bus.nnz_lu()),
           sparse_solver_{y_bus.shared_indptr_lu(), y_bus.shared_indices_lu(), y_bus.shared_diag_lu()},
-          perm_{static_cast<BlockPermArray>(n_bus_)} {}
+          perm_{static_cast<BlockPermArray>(n_bus_)},
+          pre_fault_perm_{static_cast<BlockPermArray>(n_bus_)} {}
+
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
 
     ShortCircuitMathOutput<sym> run_short_circuit(YBus<sym> const& y_bus, ShortCircuitInput const& input) {
+        return std::move(run_short_circuit(y_bus, std::span{&input, 1}).front());
+    }
+
+    // calculate several cases which only differ in the source voltages, e.g. the maximum and minimum voltage scaling
+    // the faults are taken from the first input, all the cases are solved with the same factorization
+    std::vector<ShortCircuitMathOutput<sym>> run_short_circuit(YBus<sym> const& y_bus,
+                                                               std::span<ShortCircuitInput const> inputs) {
+        assert(!inputs.empty());
+        ShortCircuitInput const& input = inputs.front();
         check_input_valid(input);
 
         auto const [fault_type, fault_phase] = extract_fault_type_phase(input.faults);
@@ -41,25 +56,42 @@ template <bool sym> class ShortCircuitSolver {
         // set phase 1 and 2 index for single and two phase faults
         auto const [phase_1, phase_2] = set_phase_index(fault_phase);
 
+        // a single fault does not need a new factorization, e.g. in a sweep of the fault location over the buses
+        if (is_single_fault(input)) {
+            return run_single_fault(y_bus, inputs);
+        }
+
         // output
-        ShortCircuitMathOutput<sym> output;
-        output.u_bus.resize(n_bus_);
-        output.fault.resize(input.faults.size());
-        output.source.resize(n_source_);
+        auto const n_case = static_cast<Idx>(inputs.size());
+        std::vector<ShortCircuitMathOutput<sym>> outputs(n_case);
+        for (auto& output : outputs) {
+            output.u_bus.resize(n_bus_);
+            output.fault.resize(input.faults.size());
+            output.source.resize(n_source_);
+        }
 
         IdxVector infinite_admittance_fault_counter(n_bus_);
 
         common_solver_functions::copy_y_bus<sym>(y_bus, mat_data_);
 
-        prepare_matrix_and_rhs(y_bus, input, output, infinite_admittance_fault_counter, fault_type, phase_1, phase_2);
+        // rhs of all cases, interleaved per bus
+        ComplexValueVector<sym> rhs(n_bus_ * n_case);
+        prepare_matrix_and_rhs(y_bus, inputs, rhs, infinite_admittance_fault_counter, fault_type, phase_1, phase_2);
 
         // solve matrix
-        sparse_solver_.prefactorize_and_solve(mat_data_, perm_, output.u_bus, output.u_bus);
+        sparse_solver_.prefactorize(mat_data_, perm_);
+        sparse_solver_.solve_with_prefactorized_matrix(mat_data_, perm_, n_case, rhs, rhs);
 
         // post processing
-        calculate_result(y_bus, input, output, infinite_admittance_fault_counter, fault_type, phase_1, phase_2);
+        for (Idx k = 0; k != n_case; ++k) {
+            for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
+                outputs[k].u_bus[bus_number] = rhs[bus_number * n_case + k];
+            }
+            calculate_result(y_bus, inputs[k], outputs[k], infinite_admittance_fault_counter, fault_type, phase_1,
+                             phase_2);
+        }
 
-        return output;
+        return outputs;
     }
 
   private:
@@ -73,21 +105,238 @@ template <bool sym> class ShortCircuitSolver {
     // sparse solver
     SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> sparse_solver_;
     BlockPermArray perm_;
+    // factorization of the pre-fault network, i.e. Y bus with source admittances
+    ComplexTensorVector<sym> pre_fault_mat_data_;
+    BlockPermArray pre_fault_perm_;
+    std::uint64_t pre_fault_y_data_version_{};
+
+    static constexpr Idx block_size = sym ? 1 : 3;
+
+    // exactly one fault in this math model, which can be calculated from the pre-fault network
+    static bool is_single_fault(ShortCircuitInput const& input) {
+        if (input.fault_bus_indptr.empty() || input.fault_bus_indptr.back() != 1) {
+            return false;
+        }
+        // the symmetric calculation only handles three phase faults
+        return !sym || input.faults[0].fault_type == FaultType::three_phase;
+    }
+
+    void prefactorize_pre_fault(YBus<sym> const& y_bus) {
+        if (pre_fault_y_data_version_ == y_bus.admittance_version()) {
+            return;
+        }
+        IdxVector const& bus_entry = y_bus.lu_diag();
+        IdxVector const& source_bus_indptr = *source_bus_indptr_;
+        pre_fault_mat_data_.resize(y_bus.nnz_lu());
+        common_solver_functions::copy_y_bus<sym>(y_bus, pre_fault_mat_data_);
+        for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
+            for (Idx source_number = source_bus_indptr[bus_number];
+                 source_number != source_bus_indptr[bus_number + 1]; ++source_number) {
+                pre_fault_mat_data_[bus_entry[bus_number]] += y_bus.math_model_param().source_param[source_number];
+            }
+        }
+        pre_fault_perm_ = static_cast<BlockPermArray>(n_bus_);
+        sparse_solver_.prefactorize(pre_fault_mat_data_, pre_fault_perm_);
+        pre_fault_y_data_version_ = y_bus.admittance_version();
+    }
+
+    /*
+    calculate a single fault with the Thevenin equivalent of the pre-fault network at the faulted bus f
+
+    The pre-fault network does not depend on the fault, so its factorization is re-used as long as the Y bus is the
+        same. One solve with n_case + block_size right-hand sides gives
+        u_pre: the pre-fault voltage of each case, rhs are the source injections
+        z_f: the columns of the impedance matrix of the faulted bus, rhs are the unit injections at bus f
+    The fault current drawn from bus f is written as i_f = D * c, in which the columns of D are the fault paths.
+    The fault conditions are D^T * u_f = W * c, with W = 0 for a fault with infinite admittance.
+    Together with u_f = u_pre_f - z_ff * i_f, this gives
+        c = (D^T * z_ff * D + W)^-1 * D^T * u_pre_f
+        u = u_pre - z_f * i_f
+    */
+    std::vector<ShortCircuitMathOutput<sym>> run_single_fault(YBus<sym> const& y_bus,
+                                                              std::span<ShortCircuitInput const> inputs) {
+        prefactorize_pre_fault(y_bus);
+
+        ShortCircuitInput const& input = inputs.front();
+        auto const n_case = static_cast<Idx>(inputs.size());
+        IdxVector const& fault_bus_indptr = input.fault_bus_indptr;
+        IdxVector const& source_bus_indptr = *source_bus_indptr_;
+        // the first bus with a fault
+        Idx const fault_bus =
+            std::distance(fault_bus_indptr.cbegin(), std::ranges::upper_bound(fault_bus_indptr, Idx{0})) - 1;
+        Idx const fault_number = fault_bus_indptr[fault_bus];
+        FaultCalcParam const& fault = input.faults[fault_number];
+
+        // rhs 0 to n_case - 1: source injections of each case
+        // rhs n_case to n_case + block_size - 1: unit injections at the faulted bus
+        Idx const n_rhs = n_case + block_size;
+        ComplexValueVector<sym> x(n_bus_ * n_rhs);
+        for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
+            for (Idx source_number = source_bus_indptr[bus_number];
+                 source_number != source_bus_indptr[bus_number + 1]; ++source_number) {
+                ComplexTensor<sym> const y_source = y_bus.math_model_param().source_param[source_number];
+                for (Idx k = 0; k != n_case; ++k) {
+                    x[bus_number * n_rhs + k] += dot(y_source, ComplexValue<sym>{inputs[k].source[source_number]});
+                }
+            }
+        }
+        for (Idx phase = 0; phase != block_size; ++phase) {
+            set_phase(x[fault_bus * n_rhs + n_case + phase], phase, 1.0);
+        }
+        sparse_solver_.solve_with_prefactorized_matrix(pre_fault_mat_data_, pre_fault_perm_, n_rhs, x, x);
+
+        Eigen::MatrixXcd z_ff(block_size, block_size);
+        for (Idx phase = 0; phase != block_size; ++phase) {
+            for (Idx col = 0; col != block_size; ++col) {
+                z_ff(phase, col) = get_phase(x[fault_bus * n_rhs + n_case + col], phase);
+            }
+        }
+
+        std::vector<ShortCircuitMathOutput<sym>> outputs(n_case);
+        for (Idx k = 0; k != n_case; ++k) {
+            ShortCircuitMathOutput<sym>& output = outputs[k];
+            output.u_bus.resize(n_bus_);
+            output.fault.resize(input.faults.size());
+            output.source.resize(n_source_);
+
+            // fault current
+            Eigen::VectorXcd u_pre_f(block_size);
+            for (Idx phase = 0; phase != block_size; ++phase) {
+                u_pre_f(phase) = get_phase(x[fault_bus * n_rhs + k], phase);
+            }
+            Eigen::VectorXcd const i_f = calculate_fault_current(fault, z_ff, u_pre_f);
+            for (Idx phase = 0; phase != block_size; ++phase) {
+                set_phase(output.fault[fault_number].i_fault, phase, i_f(phase));
+            }
+
+            // post-fault voltage
+            for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
+                ComplexValue<sym>& u = output.u_bus[bus_number];
+                u = x[bus_number * n_rhs + k];
+                for (Idx col = 0; col != block_size; ++col) {
+                    u -= x[bus_number * n_rhs + n_case + col] * i_f(col);
+                }
+            }
 
-    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, ShortCircuitInput const& input,
-                                ShortCircuitMathOutput<sym>& output, IdxVector& infinite_admittance_fault_counter,
+            // source current
+            for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
+                for (Idx source_number = source_bus_indptr[bus_number];
+                     source_number != source_bus_indptr[bus_number + 1]; ++source_number) {
+                    ComplexTensor<sym> const y_source = y_bus.math_model_param().source_param[source_number];
+                    output.source[source_number].i =
+                        dot(y_source, ComplexValue<sym>{inputs[k].source[source_number]} - output.u_bus[bus_number]);
+                }
+            }
+
+            output.branch = y_bus.template calculate_branch_flow<BranchShortCircuitMathOutput<sym>>(output.u_bus);
+            output.shunt = y_bus.template calculate_shunt_flow<ApplianceShortCircuitMathOutput<sym>>(output.u_bus);
+        }
+        return outputs;
+    }
+
+    // fault current drawn from the faulted bus, given the impedance matrix z_ff and pre-fault voltage of the bus
+    static Eigen::VectorXcd calculate_fault_current(FaultCalcParam const& fault, Eigen::MatrixXcd const& z_ff,
+                                                    Eigen::VectorXcd const& u_pre_f) {
+        DoubleComplex const y_fault = fault.y_fault;
+        // an open fault draws no current, except for a two phase to ground fault, of which the phases stay connected
+        bool const open_fault = y_fault == DoubleComplex{0.0};
+        if (open_fault && fault.fault_type != FaultType::two_phase_to_ground) {
+            return Eigen::VectorXcd::Zero(block_size);
+        }
+        auto const [phase_1, phase_2] = set_phase_index(fault.fault_phase);
+
+        // fault paths
+        Eigen::MatrixXcd d;
+        switch (fault.fault_type) {
+            using enum FaultType;
+
+        case three_phase:
+            d = Eigen::MatrixXcd::Identity(block_size, block_size);
+            break;
+        case single_phase_to_ground:
+            d = Eigen::MatrixXcd::Zero(block_size, 1);
+            d(phase_1, 0) = 1.0;
+            break;
+        case two_phase:
+            d = Eigen::MatrixXcd::Zero(block_size, 1);
+            d(phase_1, 0) = 1.0;
+            d(phase_2, 0) = -1.0;
+            break;
+        case two_phase_to_ground:
+            if (open_fault) {
+                // solid connection between the phases, as for a two phase fault
+                d = Eigen::MatrixXcd::Zero(block_size, 1);
+                d(phase_1, 0) = 1.0;
+                d(phase_2, 0) = -1.0;
+                break;
+            }
+            d = Eigen::MatrixXcd::Zero(block_size, 2);
+            d(phase_1, 0) = 1.0;
+            d(phase_2, 1) = 1.0;
+            break;
+        default:
+            throw InvalidShortCircuitPhaseOrType{};
+        }
+
+        // fault impedance in the fault paths
+        auto const n_path = d.cols();
+        Eigen::MatrixXcd w = Eigen::MatrixXcd::Zero(n_path, n_path);
+        if (!std::isinf(y_fault.real()) && !open_fault) {
+            if (fault.fault_type == FaultType::two_phase_to_ground) {
+                // both phases are connected to the ground via the same fault impedance
+                w.setConstant(1.0 / y_fault);
+            } else {
+                w.diagonal().setConstant(1.0 / y_fault);
+            }
+        }
+
+        Eigen::MatrixXcd const mat = d.transpose() * z_ff * d + w;
+        return d * mat.partialPivLu().solve(d.transpose() * u_pre_f);
+    }
+
+    static DoubleComplex get_phase(ComplexValue<sym> const& value, Idx phase) {
+        if constexpr (sym) {
+            assert(phase == 0);
+            return value;
+        } else {
+            return value(phase);
+        }
+    }
+
+    static void set_phase(ComplexValue<sym>& value, Idx phase, DoubleComplex const& x) {
+        if constexpr (sym) {
+            assert(phase == 0);
+            value = x;
+        } else {
+            value(phase) = x;
+        }
+    }
+
+    void prepare_matrix_and_rhs(YBus<sym> const& y_bus, std::span<ShortCircuitInput const> inputs,
+                                ComplexValueVector<sym>& rhs, IdxVector& infinite_admittance_fault_counter,
                                 FaultType const& fault_type, IntS const& phase_1, IntS const& phase_2) {
         // getter
         IdxVector const& bus_entry = y_bus.lu_diag();
         IdxVector const& source_bus_indptr = *source_bus_indptr_;
+        ShortCircuitInput const& input = inputs.front();
+        auto const n_case = static_cast<Idx>(inputs.size());
         // loop through all buses
         for (Idx bus_number = 0; bus_number != n_bus_; ++bus_number) {
             Idx const diagonal_position = bus_entry[bus_number];
             auto& diagonal_element = mat_data_[diagonal_position];
-            auto& u_bus = output.u_bus[bus_number];
-
-            common_solver_functions::add_sources<sym>(source_bus_indptr, bus_number, y_bus, input.source,
-                                                      diagonal_element, u_bus);
+            // rhs of this bus for all the cases
+            std::span<ComplexValue<sym>> const u_bus{rhs.data() + bus_number * n_case,
+                                                     static_cast<size_t>(n_case)};
+
+            for (Idx source_number = source_bus_indptr[bus_number];
+                 source_number != source_bus_indptr[bus_number + 1]; ++source_number) {
+                ComplexTensor<sym> const y_source = y_bus.math_model_param().source_param[source_number];
+                diagonal_element += y_source; // add y_source to the diagonal of Ybus
+                for (Idx k = 0; k != n_case; ++k) {
+                    // rhs += Y_source * U_source
+                    u_bus[k] += dot(y_source, ComplexValue<sym>{inputs[k].source[source_number]});
+                }
+            }
 
             // skip if no fault
             if (!input.faults.empty()) {
@@ -98,7 +347,7 @@ template <bool sym> class ShortCircuitSolver {
     }
 
     void add_faults(Idx const& bus_number, YBus<sym> const& y_bus, ShortCircuitInput const& input,
-                    ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus,
+                    ComplexTensor<sym>& diagonal_element, std::span<ComplexValue<sym>> u_bus,
                     IdxVector& infinite_admittance_fault_counter, FaultType const& fault_type, IntS const& phase_1,
                     IntS const& phase_2) {
         IdxVector const& fault_bus_indptr = input.fault_bus_indptr;
@@ -121,7 +370,7 @@ template <bool sym> class ShortCircuitSolver {
     }
 
     void add_fault_with_infinite_impedance(Idx const& bus_number, YBus<sym> const& y_bus,
-                                           ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus,
+                                           ComplexTensor<sym>& diagonal_element, std::span<ComplexValue<sym>> u_bus,
                                            FaultType const& fault_type, IntS const& phase_1, IntS const& phase_2) {
         if (fault_type == FaultType::three_phase) { // three phase fault
             for (Idx data_index = y_bus.row_indptr_lu()[bus_number];
@@ -132,7 +381,7 @@ template <bool sym> class ShortCircuitSolver {
             }
             // mat_data[bus,bus] = -1
             diagonal_element = ComplexTensor<sym>{-1};
-            u_bus = ComplexValue<sym>{0}; // update rhs
+            std::ranges::fill(u_bus, ComplexValue<sym>{0}); // update rhs
         }
         if constexpr (!sym) {
             if (fault_type == FaultType::single_phase_to_ground) {
@@ -144,7 +393,9 @@ template <bool sym> class ShortCircuitSolver {
                 }
                 // mat_data[bus,bus][phase_1, phase_1] = -1
                 diagonal_element(phase_1, phase_1) = -1;
-                u_bus(phase_1) = 0; // update rhs
+                for (auto& u : u_bus) {
+                    u(phase_1) = 0; // update rhs
+                }
             } else if (fault_type == FaultType::two_phase) {
                 for (Idx data_index = y_bus.row_indptr_lu()[bus_number];
                      data_index != y_bus.row_indptr_lu()[bus_number + 1]; ++data_index) {
@@ -159,8 +410,10 @@ template <bool sym> class ShortCircuitSolver {
                 diagonal_element(phase_1, phase_2) = -1;
                 diagonal_element(phase_2, phase_2) = 1;
                 // update rhs
-                u_bus(phase_2) += u_bus(phase_1);
-                u_bus(phase_1) = 0;
+                for (auto& u : u_bus) {
+                    u(phase_2) += u(phase_1);
+                    u(phase_1) = 0;
+                }
             } else if (fault_type == FaultType::two_phase_to_ground) {
                 for (Idx data_index = y_bus.row_indptr_lu()[bus_number];
                      data_index != y_bus.row_indptr_lu()[bus_number + 1]; ++data_index) {
@@ -175,8 +428,10 @@ template <bool sym> class ShortCircuitSolver {
                 diagonal_element(phase_1, phase_1) = -1;
                 diagonal_element(phase_2, phase_2) = -1;
                 // update rhs
-                u_bus(phase_1) = 0;
-                u_bus(phase_2) = 0;
+                for (auto& u : u_bus) {
+                    u(phase_1) = 0;
+                    u(phase_2) = 0;
+                }
             } else {
                 assert((fault_type == FaultType::three_phase));
             }
@@ -184,8 +439,8 @@ template <bool sym> class ShortCircuitSolver {
     }
 
     void add_fault(DoubleComplex const& y_fault, Idx const& bus_number, YBus<sym> const& y_bus,
-                   ComplexTensor<sym>& diagonal_element, ComplexValue<sym>& u_bus, FaultType const& fault_type,
-                   IntS const& phase_1, IntS const& phase_2) {
+                   ComplexTensor<sym>& diagonal_element, std::span<ComplexValue<sym>> u_bus,
+                   FaultType const& fault_type, IntS const& phase_1, IntS const& phase_2) {
         if (fault_type == FaultType::three_phase) { // three phase fault
             // mat_data[bus,bus] += y_fault
             diagonal_element += ComplexTensor<sym>{y_fault};
@@ -219,8 +474,10 @@ template <bool sym> class ShortCircuitSolver {
                 diagonal_element(phase_2, phase_2) = 1;
                 diagonal_element(phase_2, phase_1) += y_fault;
                 // update rhs
-                u_bus(phase_2) += u_bus(phase_1);
-                u_bus(phase_1) = 0;
+                for (auto& u : u_bus) {
+                    u(phase_2) += u(phase_1);
+                    u(phase_1) = 0;
+                }
             } else {
                 assert((fault_type == FaultType::three_phase));
             }
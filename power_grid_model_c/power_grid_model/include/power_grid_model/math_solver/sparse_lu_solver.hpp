@@ -10,7 +10,12 @@
 #include "../power_grid_model.hpp"
 #include "../three_phase_tensor.hpp"
 
+#include <atomic>
+#include <barrier>
+#include <exception>
 #include <memory>
+#include <numeric>
+#include <thread>
 
 namespace power_grid_model {
 
@@ -67,6 +72,212 @@ struct sparse_lu_entry_trait<Tensor, RHSVector, XVector> {
     using BlockPermArray = std::vector<BlockPerm>;
 };
 
+// Parallel schedule of the rows of the sparse LU factorization and substitution.
+//
+// The LU structure (including fill-ins) is symmetric, so it defines an elimination tree:
+//     the parent of a row is the first column at the right of the diagonal in that row.
+// The factorization and forward substitution of a row only depend on the rows of its descendants,
+//     the backward substitution of a row only depends on the rows of its ancestors.
+// The tree is split in
+//     independent subtrees at the bottom, the subtrees are distributed over the threads;
+//     the remaining rows at the top, these are processed level by level, where a level only depends on lower levels.
+// The minimum degree ordering of the topology keeps the top of the tree (the separators) small.
+struct SparseLUSchedule {
+    // a thread should at least have this amount of rows, otherwise the synchronization is not worth it
+    static constexpr Idx min_rows_per_thread = 1000;
+
+    Idx n_thread{1};
+    // rows of the subtrees per thread in ascending order
+    IdxVector subtree_thread_indptr;
+    IdxVector subtree_rows;
+    // rows at the top per level
+    IdxVector top_level_indptr;
+    IdxVector top_rows;
+
+    SparseLUSchedule(IdxVector const& row_indptr, IdxVector const& col_indices, IdxVector const& diag_lu,
+                     Idx n_thread_max, Idx min_rows = min_rows_per_thread) {
+        auto const size = static_cast<Idx>(diag_lu.size());
+        n_thread = std::max(Idx{1}, std::min(n_thread_max, size / std::max(min_rows, Idx{1})));
+
+        // elimination tree, parent is always larger than the child
+        IdxVector parent(size);
+        // estimated work per row is the number of entries in the row,
+        //    accumulated to the work of the whole subtree
+        IdxVector subtree_weight(size);
+        IdxVector n_children(size + 1, 0);
+        for (Idx row = 0; row != size; ++row) {
+            Idx const first_u_idx = diag_lu[row] + 1;
+            parent[row] = first_u_idx < row_indptr[row + 1] ? col_indices[first_u_idx] : -1;
+            subtree_weight[row] += row_indptr[row + 1] - row_indptr[row];
+            if (parent[row] != -1) {
+                assert(parent[row] > row);
+                subtree_weight[parent[row]] += subtree_weight[row];
+                ++n_children[parent[row] + 1];
+            }
+        }
+        IdxVector children_indptr(size + 1);
+        std::partial_sum(n_children.cbegin(), n_children.cend(), children_indptr.begin());
+        IdxVector children(children_indptr.back());
+        {
+            IdxVector child_pos(children_indptr.cbegin(), children_indptr.cend() - 1);
+            for (Idx row = 0; row != size; ++row) {
+                if (parent[row] != -1) {
+                    children[child_pos[parent[row]]++] = row;
+                }
+            }
+        }
+
+        // split the largest subtree until all subtrees are small enough to be balanced over the threads
+        // stop if the top gets too large, e.g. for a chain
+        Idx const total_weight = row_indptr.back();
+        Idx const max_subtree_weight = total_weight / n_thread;
+        Idx top_weight = 0;
+        // thread of each row, -1 for the top rows
+        IdxVector row_thread(size, -1);
+        std::vector<std::pair<Idx, Idx>> subtree_roots; // max heap of (weight, root)
+        for (Idx row = 0; row != size; ++row) {
+            if (parent[row] == -1) {
+                subtree_roots.emplace_back(subtree_weight[row], row);
+            }
+        }
+        std::make_heap(subtree_roots.begin(), subtree_roots.end());
+        while (!subtree_roots.empty() && subtree_roots.front().first > max_subtree_weight &&
+               top_weight * 2 < total_weight) {
+            std::pop_heap(subtree_roots.begin(), subtree_roots.end());
+            Idx const root = subtree_roots.back().second;
+            subtree_roots.pop_back();
+            top_weight += row_indptr[root + 1] - row_indptr[root];
+            for (Idx child_idx = children_indptr[root]; child_idx != children_indptr[root + 1]; ++child_idx) {
+                Idx const child = children[child_idx];
+                subtree_roots.emplace_back(subtree_weight[child], child);
+                std::push_heap(subtree_roots.begin(), subtree_roots.end());
+            }
+        }
+
+        // distribute the subtrees, largest first to the thread with the least work
+        std::sort(subtree_roots.begin(), subtree_roots.end(), std::greater{});
+        IdxVector thread_weight(n_thread, 0);
+        IdxVector stack;
+        for (auto const& [weight, root] : subtree_roots) {
+            auto const thread = static_cast<Idx>(
+                std::distance(thread_weight.cbegin(), std::min_element(thread_weight.cbegin(), thread_weight.cend())));
+            thread_weight[thread] += weight;
+            stack.push_back(root);
+            while (!stack.empty()) {
+                Idx const row = stack.back();
+                stack.pop_back();
+                row_thread[row] = thread;
+                stack.insert(stack.end(), children.cbegin() + children_indptr[row],
+                             children.cbegin() + children_indptr[row + 1]);
+            }
+        }
+
+        // level of the top rows, one higher than the highest level of the children in the top
+        // all ancestors of a top row are also in the top
+        IdxVector top_level(size, 0);
+        Idx n_level = 0;
+        for (Idx row = 0; row != size; ++row) {
+            if (row_thread[row] != -1) {
+                continue;
+            }
+            n_level = std::max(n_level, top_level[row] + 1);
+            if (parent[row] != -1) {
+                assert(row_thread[parent[row]] == -1);
+                top_level[parent[row]] = std::max(top_level[parent[row]], top_level[row] + 1);
+            }
+        }
+
+        // counting sort of the rows per thread and per level, the ascending order is kept
+        subtree_thread_indptr.assign(n_thread + 1, 0);
+        top_level_indptr.assign(n_level + 1, 0);
+        for (Idx row = 0; row != size; ++row) {
+            if (row_thread[row] == -1) {
+                ++top_level_indptr[top_level[row] + 1];
+            } else {
+                ++subtree_thread_indptr[row_thread[row] + 1];
+            }
+        }
+        std::partial_sum(subtree_thread_indptr.cbegin(), subtree_thread_indptr.cend(), subtree_thread_indptr.begin());
+        std::partial_sum(top_level_indptr.cbegin(), top_level_indptr.cend(), top_level_indptr.begin());
+        subtree_rows.resize(subtree_thread_indptr.back());
+        top_rows.resize(top_level_indptr.back());
+        IdxVector subtree_pos(subtree_thread_indptr.cbegin(), subtree_thread_indptr.cend() - 1);
+        IdxVector top_pos(top_level_indptr.cbegin(), top_level_indptr.cend() - 1);
+        for (Idx row = 0; row != size; ++row) {
+            if (row_thread[row] == -1) {
+                top_rows[top_pos[top_level[row]]++] = row;
+            } else {
+                subtree_rows[subtree_pos[row_thread[row]]++] = row;
+            }
+        }
+    }
+
+    // call row_fn(row) for all rows in parallel
+    // if reverse is false, a row is processed after all its descendants
+    // if reverse is true, a row is processed after all its ancestors
+    // an exception in one of the rows stops the processing and is re-thrown in the calling thread
+    template <bool reverse, class RowFn> void run(RowFn const& row_fn) const {
+        std::barrier sync{n_thread};
+        std::atomic<bool> failed{false};
+        std::vector<std::exception_ptr> exceptions(n_thread);
+
+        auto const worker = [this, &row_fn, &sync, &failed, &exceptions](Idx thread) {
+            auto const process_row = [&row_fn, &failed, &exceptions, thread](Idx row) {
+                if (failed.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                try {
+                    row_fn(row);
+                } catch (...) {
+                    exceptions[thread] = std::current_exception();
+                    failed = true;
+                }
+            };
+            // rows of a level are distributed round robin over the threads
+            auto const process_level = [this, &process_row, thread](Idx level) {
+                for (Idx idx = top_level_indptr[level] + thread; idx < top_level_indptr[level + 1]; idx += n_thread) {
+                    process_row(top_rows[idx]);
+                }
+            };
+            auto const n_level = static_cast<Idx>(top_level_indptr.size()) - 1;
+            if constexpr (reverse) {
+                for (Idx level = n_level - 1; level != -1; --level) {
+                    process_level(level);
+                    sync.arrive_and_wait();
+                }
+                for (Idx idx = subtree_thread_indptr[thread + 1] - 1; idx != subtree_thread_indptr[thread] - 1;
+                     --idx) {
+                    process_row(subtree_rows[idx]);
+                }
+            } else {
+                for (Idx idx = subtree_thread_indptr[thread]; idx != subtree_thread_indptr[thread + 1]; ++idx) {
+                    process_row(subtree_rows[idx]);
+                }
+                for (Idx level = 0; level != n_level; ++level) {
+                    sync.arrive_and_wait();
+                    process_level(level);
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(n_thread - 1);
+        for (Idx thread = 1; thread != n_thread; ++thread) {
+            threads.emplace_back(worker, thread);
+        }
+        // calling thread is the first thread
+        worker(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (auto const& ex : exceptions) {
+            if (ex) {
+                std::rethrow_exception(ex);
+            }
+        }
+    }
+};
+
 template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
   public:
     using entry_trait = sparse_lu_entry_trait<Tensor, RHSVector, XVector>;
@@ -90,8 +301,10 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     void
     prefactorize_and_solve(std::vector<Tensor>& data,        // matrix data, factorize in-place
                            BlockPermArray& block_perm_array, // pre-allocated permutation array, will be overwritten
-                           std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
-        prefactorize(data, block_perm_array);
+                           std::vector<RHSVector> const& rhs, std::vector<XVector>& x,
+                           bool use_block_perm_array = false // re-use permutation of previous factorization
+    ) {
+        prefactorize(data, block_perm_array, use_block_perm_array);
         // call solve with const method
         solve_with_prefactorized_matrix((std::vector<Tensor> const&)data, block_perm_array, rhs, x);
     }
@@ -101,19 +314,34 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     solve_with_prefactorized_matrix(std::vector<Tensor> const& data,        // pre-factoirzed data, const ref
                                     BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
                                     std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
+        solve_with_prefactorized_matrix(data, block_perm_array, 1, rhs, x);
+    }
+
+    // solve multiple right-hand sides at once with existing pre-factorization
+    // rhs and x contain n_rhs vectors interleaved per row, i.e. rhs[row * n_rhs + k] is row of the k-th rhs
+    // in this way the LU data is only traversed once for all the right-hand sides
+    void
+    solve_with_prefactorized_matrix(std::vector<Tensor> const& data,        // pre-factoirzed data, const ref
+                                    BlockPermArray const& block_perm_array, // pre-calculated permutation, const ref
+                                    Idx n_rhs, std::vector<RHSVector> const& rhs, std::vector<XVector>& x) {
         // local reference
         auto const& row_indptr = *row_indptr_;
         auto const& col_indices = *col_indices_;
         auto const& diag_lu = *diag_lu_;
         auto const& lu_matrix = data;
+        assert(static_cast<Idx>(rhs.size()) == size_ * n_rhs);
+        assert(static_cast<Idx>(x.size()) == size_ * n_rhs);
 
         // forward substitution with L
-        for (Idx row = 0; row != size_; ++row) {
+        for_each_row<false>([&](Idx row) {
+            Idx const row_begin = row * n_rhs;
             // permutation if needed
-            if constexpr (is_block) {
-                x[row] = (block_perm_array[row].p * rhs[row].matrix()).array();
-            } else {
-                x[row] = rhs[row];
+            for (Idx k = 0; k != n_rhs; ++k) {
+                if constexpr (is_block) {
+                    x[row_begin + k] = (block_perm_array[row].p * rhs[row_begin + k].matrix()).array();
+                } else {
+                    x[row_begin + k] = rhs[row_begin + k];
+                }
             }
 
             // loop all columns until diagonal
@@ -122,49 +350,62 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
                 // never overshoot
                 assert(col < row);
                 // forward subtract
-                x[row] -= dot(lu_matrix[l_idx], x[col]);
+                Tensor const& l = lu_matrix[l_idx];
+                for (Idx k = 0; k != n_rhs; ++k) {
+                    x[row_begin + k] -= dot(l, x[col * n_rhs + k]);
+                }
             }
             // forward substitution inside block, for block matrix
             if constexpr (is_block) {
-                XVector& xb = x[row];
                 Tensor const& pivot = lu_matrix[diag_lu[row]];
-                for (Idx br = 0; br < block_size; ++br) {
-                    for (Idx bc = 0; bc < br; ++bc) {
-                        xb(br) -= pivot(br, bc) * xb(bc);
+                for (Idx k = 0; k != n_rhs; ++k) {
+                    XVector& xb = x[row_begin + k];
+                    for (Idx br = 0; br < block_size; ++br) {
+                        for (Idx bc = 0; bc < br; ++bc) {
+                            xb(br) -= pivot(br, bc) * xb(bc);
+                        }
                     }
                 }
             }
-        }
+        });
 
         // backward substitution with U
-        for (Idx row = size_ - 1; row != -1; --row) {
+        for_each_row<true>([&](Idx row) {
+            Idx const row_begin = row * n_rhs;
             // loop all columns from diagonal
             for (Idx u_idx = row_indptr[row + 1] - 1; u_idx > diag_lu[row]; --u_idx) {
                 Idx const col = col_indices[u_idx];
                 // always in upper diagonal
                 assert(col > row);
                 // backward subtract
-                x[row] -= dot(lu_matrix[u_idx], x[col]);
+                Tensor const& u = lu_matrix[u_idx];
+                for (Idx k = 0; k != n_rhs; ++k) {
+                    x[row_begin + k] -= dot(u, x[col * n_rhs + k]);
+                }
             }
             // solve the diagonal pivot
-            if constexpr (is_block) {
-                // backward substitution inside block
-                XVector& xb = x[row];
-                Tensor const& pivot = lu_matrix[diag_lu[row]];
-                for (Idx br = block_size - 1; br != -1; --br) {
-                    for (Idx bc = block_size - 1; bc > br; --bc) {
-                        xb(br) -= pivot(br, bc) * xb(bc);
+            Tensor const& pivot = lu_matrix[diag_lu[row]];
+            for (Idx k = 0; k != n_rhs; ++k) {
+                if constexpr (is_block) {
+                    // backward substitution inside block
+                    XVector& xb = x[row_begin + k];
+                    for (Idx br = block_size - 1; br != -1; --br) {
+                        for (Idx bc = block_size - 1; bc > br; --bc) {
+                            xb(br) -= pivot(br, bc) * xb(bc);
+                        }
+                        xb(br) = xb(br) / pivot(br, br);
                     }
-                    xb(br) = xb(br) / pivot(br, br);
+                } else {
+                    x[row_begin + k] = x[row_begin + k] / pivot;
                 }
-            } else {
-                x[row] = x[row] / lu_matrix[diag_lu[row]];
             }
-        }
+        });
         // restore permutation for block matrix
         if constexpr (is_block) {
             for (Idx row = 0; row != size_; ++row) {
-                x[row] = (block_perm_array[row].q * x[row].matrix()).array();
+                for (Idx k = 0; k != n_rhs; ++k) {
+                    x[row * n_rhs + k] = (block_perm_array[row].q * x[row * n_rhs + k].matrix()).array();
+                }
             }
         }
     }
@@ -175,163 +416,249 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
     // diagonals of U have values
     // fill-ins should be pre-allocated with zero
     // block permutation array should be pre-allocated
-    void prefactorize(std::vector<Tensor>& data, BlockPermArray& block_perm_array) {
+    // if use_block_perm_array is true, the block permutation array should contain the permutations of a previous
+    //    factorization with the same structure. The pivot blocks are then factorized with these permutations as
+    //    static pivots. Full pivoting is only done again for a pivot block whose static pivot degrades.
+    //
+    // the factorization is done row by row, a row only depends on the rows of its descendants in the elimination tree
+    //    so the rows can be factorized in parallel, see SparseLUSchedule
+    void prefactorize(std::vector<Tensor>& data, BlockPermArray& block_perm_array, bool use_block_perm_array = false) {
+        // column position idx per row for the U part of LU matrix
+        // it is the position of the next column to be permuted, the columns are visited in ascending order
+        //    because the rows of these columns are all ancestors of the row
+        IdxVector col_position_idx(diag_lu_->cbegin(), diag_lu_->cend());
+        for (Idx& idx : col_position_idx) {
+            ++idx;
+        }
+
+        for_each_row<false>([&](Idx row) {
+            factorize_row(row, data, block_perm_array, use_block_perm_array, col_position_idx);
+        });
+    }
+
+    // set number of threads used for the factorization and substitution
+    // the rows are only processed in parallel if the matrix is large enough
+    void set_threading(Idx n_thread) {
+        n_thread = std::max(Idx{1}, n_thread);
+        if (n_thread == n_thread_) {
+            return;
+        }
+        n_thread_ = n_thread;
+        schedule_.reset();
+        if (n_thread_ > 1) {
+            auto schedule = std::make_shared<SparseLUSchedule const>(*row_indptr_, *col_indices_, *diag_lu_, n_thread_);
+            if (schedule->n_thread > 1) {
+                schedule_ = std::move(schedule);
+            }
+        }
+    }
+  private:
+    // a static pivot is considered degraded if its magnitude is smaller than this ratio
+    //     of the largest magnitude in the remaining sub-block, which full pivoting would have chosen
+    static constexpr double static_pivot_threshold = 0.1;
+
+    Idx size_;
+    Idx nnz_; // number of non zeroes (in block)
+    std::shared_ptr<IdxVector const> row_indptr_;
+    std::shared_ptr<IdxVector const> col_indices_;
+    std::shared_ptr<IdxVector const> diag_lu_;
+    Idx n_thread_{1};
+    std::shared_ptr<SparseLUSchedule const> schedule_;
+
+    // call row_fn(row) for all rows, sequentially in (reverse) order or in parallel with the schedule
+    template <bool reverse, class RowFn> void for_each_row(RowFn const& row_fn) const {
+        if (schedule_) {
+            schedule_->template run<reverse>(row_fn);
+        } else if constexpr (reverse) {
+            for (Idx row = size_ - 1; row != -1; --row) {
+                row_fn(row);
+            }
+        } else {
+            for (Idx row = 0; row != size_; ++row) {
+                row_fn(row);
+            }
+        }
+    }
+
+    // factorize one row of the matrix in-place
+    // all the rows of the descendants of this row should be factorized already
+    // the row only modifies its own entries, and the entries U_k,row above the pivot
+    void factorize_row(Idx row, std::vector<Tensor>& lu_matrix, BlockPermArray& block_perm_array,
+                       bool use_block_perm_array, IdxVector& col_position_idx) const {
         // local reference
         auto const& row_indptr = *row_indptr_;
         auto const& col_indices = *col_indices_;
         auto const& diag_lu = *diag_lu_;
-        // lu matrix inplace
-        std::vector<Tensor>& lu_matrix = data;
+        Idx const pivot_idx = diag_lu[row];
 
-        // column position idx per row for LU matrix
-        IdxVector col_position_idx(row_indptr.cbegin(), row_indptr.cend() - 1);
-
-        // start pivoting, it is always the diagonal
-        for (Idx pivot_row_col = 0; pivot_row_col != size_; ++pivot_row_col) {
-            Idx const pivot_idx = diag_lu[pivot_row_col];
+        // for block matrix
+        // permute columns of A's in the left of the pivot
+        // A_row,k = A_row,k * Q_k    k < row
+        // this has to be done before the elimination,
+        //    because the U_k,j above the pivots j < row are already permuted with Q_j
+        if constexpr (is_block) {
+            for (Idx l_idx = row_indptr[row]; l_idx < pivot_idx; ++l_idx) {
+                lu_matrix[l_idx] = (lu_matrix[l_idx].matrix() * block_perm_array[col_indices[l_idx]].q).array();
+            }
+        }
 
-            // Dense LU factorize pivot for block matrix in-place
-            // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot * Q_pivot^-1
-            // return reference to pivot permutation
-            BlockPerm const& block_perm = [&]() -> std::conditional_t<is_block, BlockPerm const&, BlockPerm> {
-                if constexpr (is_block) {
-                    LUFactor lu_factor(lu_matrix[pivot_idx]);
-                    // set a low threshold, because state estimation can have large differences in eigen values
-                    lu_factor.setThreshold(1e-100);
-                    if (lu_factor.rank() < block_size) {
-                        throw SparseMatrixError{};
-                    }
-                    // record block permutation
-                    block_perm_array[pivot_row_col] = {lu_factor.permutationP(), lu_factor.permutationQ()};
-                    return block_perm_array[pivot_row_col];
-                } else {
-                    if (lu_matrix[pivot_idx] == 0.0) {
-                        throw SparseMatrixError{};
+        // calculate L in the left of the pivot, from left to right
+        // and eliminate it from the rest of the row
+        for (Idx l_idx = row_indptr[row]; l_idx < pivot_idx; ++l_idx) {
+            Idx const l_col = col_indices[l_idx];
+            Idx const l_col_pivot_idx = diag_lu[l_col];
+            Tensor const& l_col_pivot = lu_matrix[l_col_pivot_idx];
+            // calculating l at (row, l_col)
+            if constexpr (is_block) {
+                // for block matrix
+                // calculate L blocks in-place
+                // L_row,k * U_k = A_row,k * Q_k    k < row
+                Tensor& l = lu_matrix[l_idx];
+                // forward substitution, per column in l
+                // l0 = [l00, l10]^T
+                // l1 = [l01, l11]^T
+                // l = [l0, l1]
+                // a = [a0, a1]
+                // u = [[u00, u01]
+                //      [0  , u11]]
+                // l * u = a
+                // l0 * u00 = a0
+                // l0 * u01 + l1 * u11 = a1
+                for (Idx block_col = 0; block_col < block_size; ++block_col) {
+                    for (Idx block_row = 0; block_row < block_col; ++block_row) {
+                        l.col(block_col) -= l_col_pivot(block_row, block_col) * l.col(block_row);
                     }
-                    return {};
+                    // divide diagonal
+                    l.col(block_col) = l.col(block_col) / l_col_pivot(block_col, block_col);
+                }
+            } else {
+                // for scalar matrix, just divide
+                // L_row,k = A_row,k / U_k    k < row
+                lu_matrix[l_idx] = lu_matrix[l_idx] / l_col_pivot;
+            }
+            Tensor const& l = lu_matrix[l_idx];
+
+            // for all entries in the right of (row, l_col)
+            //       A(row, u_col) = A(row, u_col) - l * U(l_col, u_col),
+            //          for u_col > l_col
+            // it can create fill-ins, but the fill-ins are pre-allocated
+            // it is garanteed to have an entry at (row, u_col), if (l_col, u_col) is non-zero
+            // starting A index from (row, l_col)
+            Idx a_idx = l_idx;
+            // loop all columns in the right of (l_col, l_col), at l_col
+            for (Idx u_idx = l_col_pivot_idx + 1; u_idx < row_indptr[l_col + 1]; ++u_idx) {
+                Idx const u_col = col_indices[u_idx];
+                assert(u_col > l_col);
+                // search the a_idx to the u_col,
+                auto const found =
+                    std::lower_bound(col_indices.cbegin() + a_idx, col_indices.cbegin() + row_indptr[row + 1], u_col);
+                // should always found
+                assert(found != col_indices.cbegin() + row_indptr[row + 1]);
+                assert(*found == u_col);
+                a_idx = (Idx)std::distance(col_indices.cbegin(), found);
+                // subtract
+                lu_matrix[a_idx] -= dot(l, lu_matrix[u_idx]);
+            }
+        }
+
+        // Dense LU factorize pivot for block matrix in-place
+        // A_pivot,pivot, becomes P_pivot^-1 * L_pivot * U_pivot * Q_pivot^-1
+        // return reference to pivot permutation
+        BlockPerm const& block_perm = [&]() -> std::conditional_t<is_block, BlockPerm const&, BlockPerm> {
+            if constexpr (is_block) {
+                // try static pivoting with the permutation of the previous factorization
+                if (use_block_perm_array && factorize_block_static_pivot(lu_matrix[pivot_idx], block_perm_array[row])) {
+                    return block_perm_array[row];
                 }
-            }();
+                LUFactor lu_factor(lu_matrix[pivot_idx]);
+                // set a low threshold, because state estimation can have large differences in eigen values
+                lu_factor.setThreshold(1e-100);
+                if (lu_factor.rank() < block_size) {
+                    throw SparseMatrixError{};
+                }
+                // record block permutation
+                block_perm_array[row] = {lu_factor.permutationP(), lu_factor.permutationQ()};
+                return block_perm_array[row];
+            } else {
+                if (lu_matrix[pivot_idx] == 0.0) {
+                    throw SparseMatrixError{};
+                }
+                return {};
+            }
+        }();
+
+        if constexpr (is_block) {
             // reference to pivot
             Tensor const& pivot = lu_matrix[pivot_idx];
 
             // for block matrix
             // permute rows of L's in the left of the pivot
-            // L_k,pivot = P_pivot * L_k,pivot    k < pivot
+            // L_pivot,k = P_pivot * L_pivot,k    k < pivot
             // permute columns of U's above the pivot
-            // U_pivot,k = U_pivot,k * Q_pivot    k < pivot
-            if constexpr (is_block) {
-                // loop rows and columns at the same time
-                // since the matrix is symmetric
-                for (Idx l_idx = row_indptr[pivot_row_col]; l_idx < pivot_idx; ++l_idx) {
-                    // permute rows of L_k,pivot
-                    lu_matrix[l_idx] = (block_perm.p * lu_matrix[l_idx].matrix()).array();
-                    // get row and idx of u
-                    Idx const u_row = col_indices[l_idx];
-                    Idx const u_idx = col_position_idx[u_row];
-                    // we should exactly find the current column
-                    assert(col_indices[u_idx] == pivot_row_col);
-                    // permute columns of U_pivot,k
-                    lu_matrix[u_idx] = (lu_matrix[u_idx].matrix() * block_perm.q).array();
-                    // increment column position
-                    ++col_position_idx[u_row];
-                }
+            // U_k,pivot = U_k,pivot * Q_pivot    k < pivot
+            // loop rows and columns at the same time
+            // since the matrix is symmetric
+            for (Idx l_idx = row_indptr[row]; l_idx < pivot_idx; ++l_idx) {
+                // permute rows of L_pivot,k
+                lu_matrix[l_idx] = (block_perm.p * lu_matrix[l_idx].matrix()).array();
+                // get row and idx of u
+                Idx const u_row = col_indices[l_idx];
+                Idx const u_idx = col_position_idx[u_row];
+                // we should exactly find the current column
+                assert(col_indices[u_idx] == row);
+                // permute columns of U_k,pivot
+                lu_matrix[u_idx] = (lu_matrix[u_idx].matrix() * block_perm.q).array();
+                // increment column position
+                ++col_position_idx[u_row];
             }
 
             // for block matrix
             // calculate U blocks in the right of the pivot, in-place
             // L_pivot * U_pivot,k = P_pivot * A_pivot,k       k > pivot
-            if constexpr (is_block) {
-                for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
-                    Tensor& u = lu_matrix[u_idx];
-                    // permutation
-                    u = (block_perm.p * u.matrix()).array();
-                    // forward substitution, per row in u
-                    for (Idx block_row = 0; block_row < block_size; ++block_row) {
-                        for (Idx block_col = 0; block_col < block_row; ++block_col) {
-                            // forward substract
-                            u.row(block_row) -= pivot(block_row, block_col) * u.row(block_col);
-                        }
+            for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[row + 1]; ++u_idx) {
+                Tensor& u = lu_matrix[u_idx];
+                // permutation
+                u = (block_perm.p * u.matrix()).array();
+                // forward substitution, per row in u
+                for (Idx block_row = 0; block_row < block_size; ++block_row) {
+                    for (Idx block_col = 0; block_col < block_row; ++block_col) {
+                        // forward substract
+                        u.row(block_row) -= pivot(block_row, block_col) * u.row(block_col);
                     }
                 }
             }
+        } else {
+            // no permutation and U is already final for scalar matrix
+            (void)block_perm;
+            (void)col_position_idx;
+        }
+    }
 
-            // start to calculate L below the pivot and U at the right of the pivot column
-            // because the matrix is symmetric,
-            //    looking for col_indices at pivot_row_col, starting from the diagonal (pivot_row_col, pivot_row_col)
-            //    we get also the non-zero row indices under the pivot
-            for (Idx l_ref_idx = pivot_idx + 1; l_ref_idx < row_indptr[pivot_row_col + 1]; ++l_ref_idx) {
-                // find index of l in corresponding row
-                Idx const l_row = col_indices[l_ref_idx];
-                Idx const l_idx = col_position_idx[l_row];
-                // we should exactly find the current column
-                assert(col_indices[l_idx] == pivot_row_col);
-                // calculating l at (l_row, pivot_row_col)
-                if constexpr (is_block) {
-                    // for block matrix
-                    // calculate L blocks below the pivot, in-place
-                    // L_k,pivot * U_pivot = A_k_pivot * Q_pivot    k > pivot
-                    Tensor& l = lu_matrix[l_idx];
-                    // permutation
-                    l = (l.matrix() * block_perm.q).array();
-                    // forward substitution, per column in l
-                    // l0 = [l00, l10]^T
-                    // l1 = [l01, l11]^T
-                    // l = [l0, l1]
-                    // a = [a0, a1]
-                    // u = [[u00, u01]
-                    //      [0  , u11]]
-                    // l * u = a
-                    // l0 * u00 = a0
-                    // l0 * u01 + l1 * u11 = a1
-                    for (Idx block_col = 0; block_col < block_size; ++block_col) {
-                        for (Idx block_row = 0; block_row < block_col; ++block_row) {
-                            l.col(block_col) -= pivot(block_row, block_col) * l.col(block_row);
-                        }
-                        // divide diagonal
-                        l.col(block_col) = l.col(block_col) / pivot(block_col, block_col);
-                    }
-                } else {
-                    // for scalar matrix, just divide
-                    // L_k,pivot = A_k,pivot / U_pivot    k > pivot
-                    lu_matrix[l_idx] = lu_matrix[l_idx] / pivot;
-                }
-                Tensor const& l = lu_matrix[l_idx];
-
-                // for all entries in the right of (l_row, u_col)
-                //       A(l_row, u_col) = A(l_row, u_col) - l * U(pivot_row_col, u_col),
-                //          for u_col > pivot_row_col
-                // it can create fill-ins, but the fill-ins are pre-allocated
-                // it is garanteed to have an entry at (l_row, u_col), if (pivot_row_col, u_col) is non-zero
-                // starting A index from (l_row, pivot_row_col)
-                Idx a_idx = l_idx;
-                // loop all columns in the right of (pivot_row_col, pivot_row_col), at pivot_row
-                for (Idx u_idx = pivot_idx + 1; u_idx < row_indptr[pivot_row_col + 1]; ++u_idx) {
-                    Idx const u_col = col_indices[u_idx];
-                    assert(u_col > pivot_row_col);
-                    // search the a_idx to the u_col,
-                    auto const found = std::lower_bound(col_indices.cbegin() + a_idx,
-                                                        col_indices.cbegin() + row_indptr[l_row + 1], u_col);
-                    // should always found
-                    assert(found != col_indices.cbegin() + row_indptr[l_row + 1]);
-                    assert(*found == u_col);
-                    a_idx = (Idx)std::distance(col_indices.cbegin(), found);
-                    // subtract
-                    lu_matrix[a_idx] -= dot(l, lu_matrix[u_idx]);
-                }
-                // iterate column position
-                ++col_position_idx[l_row];
+    // Dense LU factorize pivot block in-place with a given permutation, without pivoting
+    // P_pivot * A_pivot,pivot * Q_pivot = L_pivot * U_pivot, stored in the same way as in LUFactor
+    // return false if the static pivot degrades, the pivot block is then not modified
+    static bool factorize_block_static_pivot(Tensor& pivot, BlockPerm const& block_perm)
+        requires is_block
+    {
+        using Matrix = typename entry_trait::Matrix;
+        Matrix block = block_perm.p * pivot.matrix() * block_perm.q;
+        for (Idx k = 0; k != block_size; ++k) {
+            Idx const n_remaining = block_size - k - 1;
+            double const max_remaining =
+                block.bottomRightCorner(n_remaining + 1, n_remaining + 1).cwiseAbs().maxCoeff();
+            // also catches zero and nan
+            if (!(std::abs(block(k, k)) >= static_pivot_threshold * max_remaining && max_remaining > 0.0)) {
+                return false;
             }
-            // iterate column position for the pivot
-            ++col_position_idx[pivot_row_col];
+            // column of L
+            block.col(k).tail(n_remaining) /= block(k, k);
+            // update remaining sub-block
+            block.bottomRightCorner(n_remaining, n_remaining) -=
+                block.col(k).tail(n_remaining) * block.row(k).tail(n_remaining);
         }
+        pivot = block.array();
+        return true;
     }
-
-  private:
-    Idx size_;
-    Idx nnz_; // number of non zeroes (in block)
-    std::shared_ptr<IdxVector const> row_indptr_;
-    std::shared_ptr<IdxVector const> col_indices_;
-    std::shared_ptr<IdxVector const> diag_lu_;
 };
 
 } // namespace math_model_impl
@@ -339,6 +666,8 @@ template <class Tensor, class RHSVector, class XVector> class SparseLUSolver {
 template <class Tensor, class RHSVector, class XVector>
 using SparseLUSolver = math_model_impl::SparseLUSolver<Tensor, RHSVector, XVector>;
 
+using SparseLUSchedule = math_model_impl::SparseLUSchedule;
+
 } // namespace power_grid_model
 
 #endif
@@ -0,0 +1,272 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+#ifndef POWER_GRID_MODEL_MATH_SOLVER_WOODBURY_LU_SOLVER_HPP
+#define POWER_GRID_MODEL_MATH_SOLVER_WOODBURY_LU_SOLVER_HPP
+
+/*
+Sparse LU solver which keeps the factorization of a base case matrix A0,
+    and solves matrices which only differ from A0 in a few buses via the Woodbury identity.
+
+The difference is limited to the buses S:
+    A = A0 + U C U^T
+    U is the selection of the buses in S, C is the dense difference on S
+Then the solution of A x = b is
+    x = x0 - Z (I + C Z_S)^-1 C x0_S
+    x0 = A0^-1 b
+    Z = A0^-1 U
+    Z_S, x0_S are the rows of Z, x0 at the buses S
+This costs (size of S) * (block size) extra solves with the base case factorization, instead of a new factorization.
+It is typically the case for a (N-1) contingency, where a branch outage only changes the entries of two buses.
+
+The first factorized matrix is used as the base case.
+If the difference is too large, or the update is numerically singular, the matrix is factorized as usual.
+*/
+
+#include "sparse_lu_solver.hpp"
+
+#include "../exception.hpp"
+#include "../power_grid_model.hpp"
+#include "../three_phase_tensor.hpp"
+
+namespace power_grid_model {
+
+// hide implementation in inside namespace
+namespace math_model_impl {
+
+template <bool sym> class WoodburyLUSolver {
+  public:
+    using SparseSolver = SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>;
+    using BlockPermArray = typename SparseSolver::BlockPermArray;
+    static constexpr Idx block_size = sym ? 1 : 3;
+    // maximum number of changed buses to use the low-rank update
+    static constexpr Idx max_changed_bus = 4;
+
+    WoodburyLUSolver(std::shared_ptr<IdxVector const> const& row_indptr, // indptr including fill-ins
+                     std::shared_ptr<IdxVector const> const& col_indices, // indices including fill-ins
+                     std::shared_ptr<IdxVector const> const& diag_lu)
+        : n_bus_{static_cast<Idx>(row_indptr->size()) - 1},
+          row_indptr_{row_indptr},
+          col_indices_{col_indices},
+          sparse_solver_{row_indptr, col_indices, diag_lu},
+          perm_(n_bus_) {}
+
+    // set number of threads for the sparse LU factorization
+    void set_threading(Idx n_thread) { sparse_solver_.set_threading(n_thread); }
+
+    // prefactorize the matrix, or prepare the low-rank update on the base case
+    // the data is used as factorization storage if it needs its own factorization
+    void prefactorize(ComplexTensorVector<sym>& data) {
+        if (!base_) {
+            factorize_base(data);
+            return;
+        }
+        find_changed_bus(data);
+        if (changed_bus_.empty()) {
+            mode_ = Mode::base;
+            return;
+        }
+        if (static_cast<Idx>(changed_bus_.size()) <= max_changed_bus && prepare_low_rank_update(data)) {
+            mode_ = Mode::low_rank;
+            return;
+        }
+        sparse_solver_.prefactorize(data, perm_);
+        mode_ = Mode::own;
+    }
+
+    // solve with the prefactorized matrix
+    // data should be the same as in prefactorize()
+    void solve_with_prefactorized_matrix(ComplexTensorVector<sym> const& data, ComplexValueVector<sym> const& rhs,
+                                         ComplexValueVector<sym>& x) {
+        solve_with_prefactorized_matrix(data, 1, rhs, x);
+    }
+
+    // solve multiple right-hand sides at once, interleaved per row as in SparseLUSolver
+    void solve_with_prefactorized_matrix(ComplexTensorVector<sym> const& data, Idx n_rhs,
+                                         ComplexValueVector<sym> const& rhs, ComplexValueVector<sym>& x) {
+        switch (mode_) {
+        case Mode::own:
+            sparse_solver_.solve_with_prefactorized_matrix(data, perm_, n_rhs, rhs, x);
+            return;
+        case Mode::base:
+            sparse_solver_.solve_with_prefactorized_matrix(base_->lu, base_->perm, n_rhs, rhs, x);
+            return;
+        case Mode::low_rank:
+            sparse_solver_.solve_with_prefactorized_matrix(base_->lu, base_->perm, n_rhs, rhs, x);
+            apply_low_rank_update(n_rhs, x);
+            return;
+        default:
+            throw MissingCaseForEnumError{"Woodbury LU solver", mode_};
+        }
+    }
+
+    void prefactorize_and_solve(ComplexTensorVector<sym>& data, ComplexValueVector<sym> const& rhs,
+                                ComplexValueVector<sym>& x) {
+        prefactorize(data);
+        solve_with_prefactorized_matrix(data, rhs, x);
+    }
+
+    // whether the last prefactorization re-used the base case
+    bool is_base_case_reused() const { return mode_ == Mode::base || mode_ == Mode::low_rank; }
+
+  private:
+    enum class Mode : IntS { own = 0, base = 1, low_rank = 2 };
+
+    // base case, shared between copies of the solver
+    struct BaseCase {
+        ComplexTensorVector<sym> matrix;
+        ComplexTensorVector<sym> lu;
+        BlockPermArray perm;
+    };
+
+    Idx n_bus_;
+    std::shared_ptr<IdxVector const> row_indptr_;
+    std::shared_ptr<IdxVector const> col_indices_;
+    SparseSolver sparse_solver_;
+    BlockPermArray perm_;
+    std::shared_ptr<BaseCase const> base_;
+    Mode mode_{Mode::own};
+    // low-rank update
+    IdxVector changed_bus_;
+    Eigen::MatrixXcd z_;      // A0^-1 U
+    Eigen::MatrixXcd update_; // (I + C Z_S)^-1 C
+
+    static DoubleComplex& element(ComplexValue<sym>& value, Idx i) {
+        if constexpr (sym) {
+            (void)i;
+            return value;
+        } else {
+            return value(i);
+        }
+    }
+    static DoubleComplex element(ComplexTensor<sym> const& tensor, Idx i, Idx j) {
+        if constexpr (sym) {
+            (void)i;
+            (void)j;
+            return tensor;
+        } else {
+            return tensor(i, j);
+        }
+    }
+    static bool is_equal(ComplexTensor<sym> const& x, ComplexTensor<sym> const& y) {
+        if constexpr (sym) {
+            return x == y;
+        } else {
+            return (x == y).all();
+        }
+    }
+
+    void factorize_base(ComplexTensorVector<sym>& data) {
+        auto base = std::make_shared<BaseCase>();
+        base->matrix = data;
+        base->perm = BlockPermArray(n_bus_);
+        sparse_solver_.prefactorize(data, base->perm);
+        base->lu = data;
+        base_ = std::move(base);
+        mode_ = Mode::base;
+    }
+
+    void find_changed_bus(ComplexTensorVector<sym> const& data) {
+        IdxVector const& row_indptr = *row_indptr_;
+        IdxVector const& col_indices = *col_indices_;
+        changed_bus_.clear();
+        for (Idx row = 0; row != n_bus_; ++row) {
+            for (Idx k = row_indptr[row]; k != row_indptr[row + 1]; ++k) {
+                if (!is_equal(data[k], base_->matrix[k])) {
+                    changed_bus_.push_back(row);
+                    changed_bus_.push_back(col_indices[k]);
+                }
+            }
+        }
+        std::sort(changed_bus_.begin(), changed_bus_.end());
+        changed_bus_.erase(std::unique(changed_bus_.begin(), changed_bus_.end()), changed_bus_.end());
+    }
+
+    // calculate Z and (I + C Z_S)^-1 C, return false if the update is numerically singular
+    bool prepare_low_rank_update(ComplexTensorVector<sym> const& data) {
+        IdxVector const& row_indptr = *row_indptr_;
+        IdxVector const& col_indices = *col_indices_;
+        auto const n_changed = static_cast<Idx>(changed_bus_.size());
+        Idx const rank = n_changed * block_size;
+
+        // Z = A0^-1 U, all columns at once as multiple right-hand sides
+        // column (s, i) is the unit vector of the element i of the changed bus s
+        Idx const n_col = n_changed * block_size;
+        ComplexValueVector<sym> unit(n_bus_ * n_col, ComplexValue<sym>{0.0});
+        ComplexValueVector<sym> z_cols(n_bus_ * n_col);
+        for (Idx s = 0; s != n_changed; ++s) {
+            for (Idx i = 0; i != block_size; ++i) {
+                element(unit[changed_bus_[s] * n_col + s * block_size + i], i) = 1.0;
+            }
+        }
+        sparse_solver_.solve_with_prefactorized_matrix(base_->lu, base_->perm, n_col, unit, z_cols);
+        z_.resize(n_bus_ * block_size, rank);
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            for (Idx col = 0; col != n_col; ++col) {
+                for (Idx j = 0; j != block_size; ++j) {
+                    z_(bus * block_size + j, col) = element(z_cols[bus * n_col + col], j);
+                }
+            }
+        }
+
+        // C, the difference on the changed buses, and Z_S
+        Eigen::MatrixXcd c = Eigen::MatrixXcd::Zero(rank, rank);
+        Eigen::MatrixXcd z_s(rank, rank);
+        for (Idx s = 0; s != n_changed; ++s) {
+            Idx const row = changed_bus_[s];
+            z_s.middleRows(s * block_size, block_size) = z_.middleRows(row * block_size, block_size);
+            for (Idx k = row_indptr[row]; k != row_indptr[row + 1]; ++k) {
+                auto const found = std::lower_bound(changed_bus_.cbegin(), changed_bus_.cend(), col_indices[k]);
+                if (found == changed_bus_.cend() || *found != col_indices[k]) {
+                    continue;
+                }
+                auto const t = static_cast<Idx>(std::distance(changed_bus_.cbegin(), found));
+                for (Idx i = 0; i != block_size; ++i) {
+                    for (Idx j = 0; j != block_size; ++j) {
+                        c(s * block_size + i, t * block_size + j) =
+                            element(data[k], i, j) - element(base_->matrix[k], i, j);
+                    }
+                }
+            }
+        }
+
+        // (I + C Z_S)^-1 C
+        Eigen::FullPivLU<Eigen::MatrixXcd> const lu{Eigen::MatrixXcd::Identity(rank, rank) + c * z_s};
+        if (!lu.isInvertible()) {
+            return false;
+        }
+        update_ = lu.solve(c);
+        return true;
+    }
+
+    // x = x0 - Z (I + C Z_S)^-1 C x0_S, for each of the n_rhs interleaved solutions
+    void apply_low_rank_update(Idx n_rhs, ComplexValueVector<sym>& x) const {
+        auto const n_changed = static_cast<Idx>(changed_bus_.size());
+        Eigen::MatrixXcd x_s(n_changed * block_size, n_rhs);
+        for (Idx s = 0; s != n_changed; ++s) {
+            for (Idx k = 0; k != n_rhs; ++k) {
+                for (Idx i = 0; i != block_size; ++i) {
+                    x_s(s * block_size + i, k) = element(x[changed_bus_[s] * n_rhs + k], i);
+                }
+            }
+        }
+        Eigen::MatrixXcd const dx = z_ * (update_ * x_s);
+        for (Idx bus = 0; bus != n_bus_; ++bus) {
+            for (Idx k = 0; k != n_rhs; ++k) {
+                for (Idx j = 0; j != block_size; ++j) {
+                    element(x[bus * n_rhs + k], j) -= dx(bus * block_size + j, k);
+                }
+            }
+        }
+    }
+};
+
+} // namespace math_model_impl
+
+template <bool sym> using WoodburyLUSolver = math_model_impl::WoodburyLUSolver<sym>;
+
+} // namespace power_grid_model
+
+#endif
@@ -11,6 +11,8 @@
 #include "../sparse_mapping.hpp"
 #include "../three_phase_tensor.hpp"
 
+#include <atomic>
+
 namespace power_grid_model {
 
 // hide implementation in inside namespace
@@ -299,7 +301,9 @@ template <bool sym> class YBus {
     std::vector<YBusElement> const& y_bus_element() const { return y_bus_struct_->y_bus_element; }
     IdxVector const& y_bus_entry_indptr() const { return y_bus_struct_->y_bus_entry_indptr; }
     MathModelTopology const& math_topology() const { return *math_topology_; }
-    MathModelParam<sym> const& math_model_param() const { return *math_model_param_; }
+    MathModelParam<sym> const& math_model_param() const {
+        return owned_math_model_param_ ? *owned_math_model_param_ : *math_model_param_;
+    }
 
     ComplexTensorVector<sym> const& admittance() const { return *admittance_; }
     IdxVector const& bus_entry() const { return y_bus_struct_->bus_entry; }
@@ -319,35 +323,74 @@ template <bool sym> class YBus {
 
     constexpr auto& get_y_bus_structure() const { return y_bus_struct_; }
 
+    // version of the admittance data, unique over all Y bus objects
+    // it changes on each update, so the solvers can check whether their cached matrices are still valid
+    std::uint64_t admittance_version() const { return admittance_version_; }
+
     void update_admittance(std::shared_ptr<MathModelParam<sym> const> const& math_model_param) {
-        // overwrite the old cached parameters
+        // overwrite the old cached parameters, they are shared with the caller
         math_model_param_ = math_model_param;
+        owned_math_model_param_.reset();
         // construct admittance data
-        ComplexTensorVector<sym> admittance(nnz());
-        auto const& branch_param = math_model_param_->branch_param;
-        auto const& shunt_param = math_model_param_->shunt_param;
-        auto const& y_bus_element = y_bus_struct_->y_bus_element;
-        auto const& y_bus_entry_indptr = y_bus_struct_->y_bus_entry_indptr;
+        auto admittance = std::make_shared<ComplexTensorVector<sym>>(nnz());
         // loop for each y bus position
         for (Idx entry = 0; entry != nnz(); ++entry) {
-            // start admittance accumulation with zero
-            ComplexTensor<sym> entry_admittance{0.0};
-            // loop over all entries of this position
-            for (Idx element = y_bus_entry_indptr[entry]; element != y_bus_entry_indptr[entry + 1]; ++element) {
-                if (y_bus_element[element].element_type == YBusElementType::shunt) {
-                    // shunt
-                    entry_admittance += shunt_param[y_bus_element[element].idx];
-                } else {
-                    // branch
-                    entry_admittance += branch_param[y_bus_element[element].idx]
-                                            .value[static_cast<Idx>(y_bus_element[element].element_type)];
-                }
-            }
-            // assign
-            admittance[entry] = entry_admittance;
+            (*admittance)[entry] = calculate_admittance_entry(entry);
         }
         // move to shared ownership
-        admittance_ = std::make_shared<ComplexTensorVector<sym> const>(std::move(admittance));
+        admittance_ = std::move(admittance);
+        admittance_version_ = next_admittance_version();
+    }
+
+    // update the parameters of some branches and shunts
+    // only the admittance entries in the positions of these branches and shunts are re-calculated
+    // the parameters and admittance are modified in place if they are not shared with other Y bus objects
+    void update_admittance_increment(MathModelParamIncrement<sym> const& increment) {
+        // copy on write, the parameters of the caller are never modified
+        if (owned_math_model_param_.use_count() != 1) {
+            owned_math_model_param_ = std::make_shared<MathModelParam<sym>>(math_model_param());
+            math_model_param_.reset();
+        }
+        MathModelParam<sym>& param = *owned_math_model_param_;
+        if (admittance_.use_count() != 1) {
+            admittance_ = std::make_shared<ComplexTensorVector<sym>>(*admittance_);
+        }
+        auto const& branch_bus_idx = math_topology_->branch_bus_idx;
+        auto const& shunt_bus_indptr = math_topology_->shunt_bus_indptr;
+        // patch parameters and find the affected entries
+        IdxVector affected_entries;
+        for (size_t i = 0; i != increment.branch_param_to_change.size(); ++i) {
+            Idx const branch = increment.branch_param_to_change[i];
+            param.branch_param[branch] = increment.branch_param[i];
+            auto const [f, t] = branch_bus_idx[branch];
+            if (f != -1) {
+                affected_entries.push_back(bus_entry()[f]);
+            }
+            if (t != -1) {
+                affected_entries.push_back(bus_entry()[t]);
+            }
+            if (f != -1 && t != -1) {
+                affected_entries.push_back(find_entry(f, t));
+                affected_entries.push_back(find_entry(t, f));
+            }
+        }
+        for (size_t i = 0; i != increment.shunt_param_to_change.size(); ++i) {
+            Idx const shunt = increment.shunt_param_to_change[i];
+            param.shunt_param[shunt] = increment.shunt_param[i];
+            auto const bus = static_cast<Idx>(
+                std::distance(shunt_bus_indptr.cbegin(),
+                              std::upper_bound(shunt_bus_indptr.cbegin(), shunt_bus_indptr.cend(), shunt)) -
+                1);
+            affected_entries.push_back(bus_entry()[bus]);
+        }
+        // re-calculate the affected entries
+        std::ranges::sort(affected_entries);
+        auto const [unique_end, end] = std::ranges::unique(affected_entries);
+        affected_entries.erase(unique_end, end);
+        for (Idx const entry : affected_entries) {
+            (*admittance_)[entry] = calculate_admittance_entry(entry);
+        }
+        admittance_version_ = next_admittance_version();
     }
 
     ComplexValue<sym> calculate_injection(ComplexValueVector<sym> const& u, Idx bus_number) const {
@@ -372,7 +415,7 @@ template <bool sym> class YBus {
     std::vector<T> calculate_branch_flow(ComplexValueVector<sym> const& u) const {
         std::vector<T> branch_flow(math_topology_->branch_bus_idx.size());
         std::transform(math_topology_->branch_bus_idx.cbegin(), math_topology_->branch_bus_idx.cend(),
-                       math_model_param_->branch_param.cbegin(), branch_flow.begin(),
+                       math_model_param().branch_param.cbegin(), branch_flow.begin(),
                        [&u](BranchIdx branch_idx, BranchCalcParam<sym> const& param) {
                            auto const [f, t] = branch_idx;
                            // if one side is disconnected, use zero voltage at that side
@@ -407,7 +450,7 @@ template <bool sym> class YBus {
                  ++shunt) {
                 // See "Branch/Shunt Power Flow" in "State Estimation Alliander"
                 // NOTE: the negative sign for injection direction!
-                shunt_flow[shunt].i = -dot(math_model_param_->shunt_param[shunt], u[bus]);
+                shunt_flow[shunt].i = -dot(math_model_param().shunt_param[shunt], u[bus]);
 
                 if constexpr (std::same_as<MathOutputType, ApplianceMathOutput<sym>>) {
                     // See "Branch/Shunt Power Flow" in "State Estimation Alliander"
@@ -422,14 +465,53 @@ template <bool sym> class YBus {
     // csr structure
     std::shared_ptr<YBusStructure const> y_bus_struct_;
 
-    // admittance
-    std::shared_ptr<ComplexTensorVector<sym> const> admittance_;
+    // admittance, shared between copies until modified
+    std::shared_ptr<ComplexTensorVector<sym>> admittance_;
+    std::uint64_t admittance_version_{};
 
     // cache math topology
     std::shared_ptr<MathModelTopology const> math_topology_;
 
-    // cache the math parameters
+    // cache the math parameters, either shared with the caller after a full update
+    // or a copy owned by the Y bus after an incremental update, shared between copies until modified
     std::shared_ptr<MathModelParam<sym> const> math_model_param_;
+    std::shared_ptr<MathModelParam<sym>> owned_math_model_param_;
+
+    static std::uint64_t next_admittance_version() {
+        static std::atomic<std::uint64_t> version{0};
+        return ++version;
+    }
+
+    // sum of all the elements in one y bus position
+    ComplexTensor<sym> calculate_admittance_entry(Idx entry) const {
+        auto const& branch_param = math_model_param().branch_param;
+        auto const& shunt_param = math_model_param().shunt_param;
+        auto const& y_bus_element = y_bus_struct_->y_bus_element;
+        auto const& y_bus_entry_indptr = y_bus_struct_->y_bus_entry_indptr;
+        // start admittance accumulation with zero
+        ComplexTensor<sym> entry_admittance{0.0};
+        // loop over all entries of this position
+        for (Idx element = y_bus_entry_indptr[entry]; element != y_bus_entry_indptr[entry + 1]; ++element) {
+            if (y_bus_element[element].element_type == YBusElementType::shunt) {
+                // shunt
+                entry_admittance += shunt_param[y_bus_element[element].idx];
+            } else {
+                // branch
+                entry_admittance += branch_param[y_bus_element[element].idx]
+                                        .value[static_cast<Idx>(y_bus_element[element].element_type)];
+            }
+        }
+        return entry_admittance;
+    }
+
+    // find the entry of position (row, col), which should exist in the y bus
+    Idx find_entry(Idx row, Idx col) const {
+        auto const row_begin = col_indices().cbegin() + row_indptr()[row];
+        auto const row_end = col_indices().cbegin() + row_indptr()[row + 1];
+        auto const found = std::lower_bound(row_begin, row_end, col);
+        assert(found != row_end && *found == col);
+        return static_cast<Idx>(std::distance(col_indices().cbegin(), found));
+    }
 };
 
 template class YBus<true>;
@@ -113,6 +113,14 @@ template <class... T> struct ComponentList {};
 // batch parameter
 struct BatchParameter {};
 
+// statistics per scenario of a calculation, each array which is not null is filled
+// the arrays have the length of the batch size, a single calculation is one scenario
+struct ScenarioStatistics {
+    Idx* n_iterations{nullptr};     // maximum number of iterations of all math models, 0 if not iterative
+    double* max_deviation{nullptr}; // maximum final deviation of all math models, nan if not iterative
+    double* wall_time{nullptr};     // wall time of the scenario in seconds
+};
+
 } // namespace power_grid_model
 
 #endif
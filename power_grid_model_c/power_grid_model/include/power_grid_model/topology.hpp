@@ -18,6 +18,8 @@
 #include <boost/graph/iteration_macros.hpp>
 #include <boost/graph/minimum_degree_ordering.hpp>
 
+#include <numeric>
+
 // build topology of the grid
 // divide grid into several math models
 // start search from a source
@@ -136,6 +138,78 @@ class Topology {
         return pair;
     }
 
+    // patch a previously built topology for new connections, without rebuilding it
+    // this is possible if the only changes are 2-way branch sides being opened,
+    //     and all buses in the math models stay connected to their source(s)
+    // the math topology (and hence the Y bus structure) is kept as it is,
+    //     the opened sides are represented by the zero admittance in the branch parameters
+    // fully opened branches are decoupled from the math model
+    // return nullptr if the topology needs to be rebuilt from scratch
+    static std::shared_ptr<TopologicalComponentToMathCoupling const>
+    patch_topology(ComponentTopology const& comp_topo, ComponentConnections const& built_conn,
+                   ComponentConnections const& comp_conn,
+                   std::vector<std::shared_ptr<MathModelTopology const>> const& math_topology,
+                   std::shared_ptr<TopologicalComponentToMathCoupling const> const& built_coup) {
+        if (comp_conn.source_connected != built_conn.source_connected ||
+            comp_conn.branch3_connected != built_conn.branch3_connected ||
+            comp_conn.branch_phase_shift != built_conn.branch_phase_shift ||
+            comp_conn.branch3_phase_shift != built_conn.branch3_phase_shift) {
+            return nullptr;
+        }
+
+        std::shared_ptr<TopologicalComponentToMathCoupling> patched_coup;
+        IntSVector branch_changed(comp_topo.branch_node_idx.size(), 0);
+        // per math model, opened branches, only allocated for affected math models
+        std::vector<IntSVector> math_branch_opened(math_topology.size());
+        for (Idx k = 0; k != static_cast<Idx>(comp_topo.branch_node_idx.size()); ++k) {
+            BranchConnected const& built = built_conn.branch_connected[k];
+            BranchConnected const& connected = comp_conn.branch_connected[k];
+            if (connected == built) {
+                continue;
+            }
+            // closing a side needs a new entry in the math topology
+            if (connected[0] > built[0] || connected[1] > built[1]) {
+                return nullptr;
+            }
+            branch_changed[k] = 1;
+            Idx2D const math_idx = built_coup->branch[k];
+            // branch was already isolated
+            if (math_idx.group == -1) {
+                continue;
+            }
+            auto& opened = math_branch_opened[math_idx.group];
+            if (opened.empty()) {
+                opened.resize(math_topology[math_idx.group]->n_branch(), 0);
+            }
+            opened[math_idx.pos] = 1;
+            if (connected[0] == 0 && connected[1] == 0) {
+                if (!patched_coup) {
+                    patched_coup = std::make_shared<TopologicalComponentToMathCoupling>(*built_coup);
+                }
+                patched_coup->branch[k] = Idx2D{-1, -1};
+            }
+        }
+        // measurements on a switched branch are coupled differently
+        for (Idx k = 0; k != static_cast<Idx>(comp_topo.power_sensor_object_idx.size()); ++k) {
+            MeasuredTerminalType const terminal_type = comp_topo.power_sensor_terminal_type[k];
+            if ((terminal_type == MeasuredTerminalType::branch_from ||
+                 terminal_type == MeasuredTerminalType::branch_to) &&
+                branch_changed[comp_topo.power_sensor_object_idx[k]] != 0) {
+                return nullptr;
+            }
+        }
+        for (Idx group = 0; group != static_cast<Idx>(math_topology.size()); ++group) {
+            if (!math_branch_opened[group].empty() &&
+                !is_fully_connected(*math_topology[group], math_branch_opened[group])) {
+                return nullptr;
+            }
+        }
+        if (!patched_coup) {
+            return built_coup;
+        }
+        return patched_coup;
+    }
+
   private:
     // input
     ComponentTopology const& comp_topo_;
@@ -153,6 +227,34 @@ class Topology {
     std::vector<MathModelTopology> math_topology_;
     TopologicalComponentToMathCoupling comp_coup_;
 
+    // check if all buses are still connected to the slack bus, without the opened branches
+    static bool is_fully_connected(MathModelTopology const& math_topo, IntSVector const& branch_opened) {
+        // union-find with path halving
+        IdxVector parent(math_topo.n_bus());
+        std::iota(parent.begin(), parent.end(), Idx{0});
+        auto const find_root = [&parent](Idx bus) {
+            while (parent[bus] != bus) {
+                parent[bus] = parent[parent[bus]];
+                bus = parent[bus];
+            }
+            return bus;
+        };
+        for (Idx branch = 0; branch != math_topo.n_branch(); ++branch) {
+            auto const [i, j] = math_topo.branch_bus_idx[branch];
+            if (branch_opened[branch] != 0 || i == -1 || j == -1) {
+                continue;
+            }
+            parent[find_root(i)] = find_root(j);
+        }
+        Idx const slack_root = find_root(math_topo.slack_bus_);
+        for (Idx bus = 0; bus != math_topo.n_bus(); ++bus) {
+            if (find_root(bus) != slack_root) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     void reset_topology() {
         comp_coup_.node.resize(comp_topo_.n_node_total(), Idx2D{-1, -1});
         comp_coup_.branch.resize(comp_topo_.branch_node_idx.size(), Idx2D{-1, -1});
@@ -159,11 +159,12 @@ enum PGM_CalculationType {
 enum PGM_CalculationMethod {
     PGM_default_method = -128, /**< the default method for each calculation type, e.g. Newton-Raphson for power flow */
     PGM_linear = 0,            /**< linear constant impedance method for power flow */
-    PGM_newton_raphson = 1,    /**< Newton-Raphson method for power flow */
+    PGM_newton_raphson = 1,    /**< Newton-Raphson method for power flow or state estimation */
     PGM_iterative_linear = 2,  /**< iterative linear method for state estimation */
     PGM_iterative_current = 3, /**< linear current method for power flow */
     PGM_linear_current = 4,    /**< iterative constant impedance method for power flow */
-    PGM_iec60909 = 5           /**< fault analysis for short circuits using the iec60909 standard */
+    PGM_iec60909 = 5,          /**< fault analysis for short circuits using the iec60909 standard */
+    PGM_fast_decoupled = 6     /**< fast decoupled method for power flow */
 };
 
 /**
@@ -206,6 +207,24 @@ enum PGM_ShortCircuitVoltageScaling {
     PGM_short_circuit_voltage_scaling_maximum = 1, /**< voltage scaling for maximum short circuit currents */
 };
 
+/**
+ * @brief Enumeration of the initialization of iterative power flow calculations
+ *
+ */
+enum PGM_PowerFlowInitialization {
+    PGM_flat_start = 0,        /**< start from the average source voltage */
+    PGM_previous_solution = 1, /**< start from the solution of the previous calculation, fall back to flat start */
+};
+
+/**
+ * @brief Enumeration of the distribution of batch scenarios over the threads
+ *
+ */
+enum PGM_BatchPartitioning {
+    PGM_work_stealing = 0, /**< threads that finish early take over scenarios from busy threads */
+    PGM_contiguous = 1,    /**< each thread calculates one contiguous block of scenarios in order */
+};
+
 #ifdef __cplusplus
 }
 #endif
@@ -108,10 +108,103 @@ PGM_API void PGM_get_indexer(PGM_Handle* handle, PGM_PowerGridModel const* model
  *   Or NULL for single calculation.
  *   The dataset should have is_batch == true. The type of the dataset should be "update".
  * @return
+ *
+ * The timings of the calculation can be retrieved by PGM_get_calculation_info().
+ * The statistics of each scenario can be retrieved by PGM_set_scenario_statistics() in the options.
  */
 PGM_API void PGM_calculate(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
                            PGM_MutableDataset const* output_dataset, PGM_ConstDataset const* batch_dataset);
 
+/**
+ * @brief Execute a one-time or batch short circuit calculation for both voltage scaling cases at once.
+ *
+ * The calculation type in the options should be #PGM_short_circuit.
+ * The maximum and minimum voltage scaling cases only differ in the source voltages.
+ * Both cases are calculated with the same matrix factorization,
+ * which is about half the cost of two calls to PGM_calculate().
+ *
+ * The results for the voltage scaling set in the options are written to output_dataset.
+ * The results for the opposite voltage scaling are written to paired_output_dataset.
+ *
+ * Use PGM_error_code() and PGM_error_message() to check the error.
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @param opt A pointer to options, see PGM_calculate().
+ * @param output_dataset A pointer to an instance of PGM_MutableDataset for the results of the voltage scaling
+ *   in the options. See PGM_calculate().
+ * @param paired_output_dataset A pointer to an instance of PGM_MutableDataset for the results of the opposite
+ *   voltage scaling. It should have the same type, batch size and components as output_dataset.
+ * @param batch_dataset A pointer to an instance of PGM_ConstDataset for batch calculation.
+ *   Or NULL for single calculation. See PGM_calculate().
+ * @return
+ */
+PGM_API void PGM_calculate_short_circuit_paired(PGM_Handle* handle, PGM_PowerGridModel* model,
+                                                PGM_Options const* opt, PGM_MutableDataset const* output_dataset,
+                                                PGM_MutableDataset const* paired_output_dataset,
+                                                PGM_ConstDataset const* batch_dataset);
+
+/**
+ * @brief Get the calculation info of the last calculation on the model.
+ *
+ * The calculation info consists of the timings of the calculation steps in seconds,
+ * summed over all threads and scenarios for a batch calculation,
+ * and the maximum number of iterations and the maximum final deviation.
+ * Each entry has a key like "2220.\t\t\tMath solver", with the code of the step and its name.
+ * The number of tabs reflects the nesting of the steps.
+ *
+ * This function takes a snapshot of the calculation info in the model,
+ * which can then be retrieved by PGM_calculation_info_keys() and PGM_calculation_info_values().
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @return The number of entries in the calculation info.
+ */
+PGM_API PGM_Idx PGM_get_calculation_info(PGM_Handle* handle, PGM_PowerGridModel* model);
+
+/**
+ * @brief Get the keys of the calculation info snapshot taken by PGM_get_calculation_info().
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @return A pointer to a char const* array with the length returned by PGM_get_calculation_info().
+ * Each entry is a zero terminated string.
+ * The pointer is not valid after the next call of PGM_get_calculation_info() on the same model.
+ * You need to copy the array (and the strings) in your own data.
+ */
+PGM_API char const** PGM_calculation_info_keys(PGM_Handle* handle, PGM_PowerGridModel* model);
+
+/**
+ * @brief Get the values of the calculation info snapshot taken by PGM_get_calculation_info().
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @return A pointer to a double array with the length returned by PGM_get_calculation_info(),
+ * in the same order as PGM_calculation_info_keys().
+ * The pointer is not valid after the next call of PGM_get_calculation_info() on the same model.
+ * You need to copy the array in your own data.
+ */
+PGM_API double const* PGM_calculation_info_values(PGM_Handle* handle, PGM_PowerGridModel const* model);
+
+/**
+ * @brief Get the trace of the last calculation on the model, if it was enabled by PGM_set_tracing().
+ *
+ * The trace is a JSON document in the Chrome trace event format,
+ * which can be opened with chrome://tracing or https://ui.perfetto.dev.
+ * It contains a complete event ("ph": "X") for each calculation step, with the timer code and the name of the step.
+ * The thread id of the event is the index of the thread in the batch calculation.
+ * The code and the scenario of the event are in the "args".
+ * The scenario is -1 for steps which do not belong to one scenario, e.g. copying the model into a thread.
+ * The timestamps are in microseconds since the start of the calculation.
+ *
+ * @param handle
+ * @param model A pointer to an existing model.
+ * @return A pointer to a zero terminated string.
+ * The pointer is not valid after the next call of PGM_get_trace() on the same model.
+ * You need to copy the string in your own data, or write it to a file.
+ */
+PGM_API char const* PGM_get_trace(PGM_Handle* handle, PGM_PowerGridModel* model);
+
 /**
  * @brief Destroy the model returned by PGM_create_model() or PGM_copy_model().
  *
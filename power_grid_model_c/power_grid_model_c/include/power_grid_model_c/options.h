@@ -28,6 +28,9 @@ extern "C" {
  *   - err_tol: 1e-8
  *   - max_iter: 20
  *   - threading: -1
+ *   - batch_partitioning: PGM_work_stealing
+ *   - short_circuit_voltage_scaling: PGM_short_circuit_voltage_scaling_maximum
+ *   - power_flow_initialization: PGM_flat_start
  *
  * @param handle
  * @return The pointer to the option instance. Should be freed by PGM_destroy_options().
@@ -89,7 +92,10 @@ PGM_API void PGM_set_err_tol(PGM_Handle* handle, PGM_Options* opt, double err_to
 PGM_API void PGM_set_max_iter(PGM_Handle* handle, PGM_Options* opt, PGM_Idx max_iter);
 
 /**
- * @brief Specify the multi-threading strategy. Only applicable for batch calculation.
+ * @brief Specify the multi-threading strategy.
+ *
+ * For a batch calculation, the scenarios are calculated in parallel.
+ * For a single calculation, the sparse matrix factorization of a very large grid is parallelized.
  *
  * @param handle
  * @param opt The pointer to the option instance.
@@ -100,6 +106,21 @@ PGM_API void PGM_set_max_iter(PGM_Handle* handle, PGM_Options* opt, PGM_Idx max_
  */
 PGM_API void PGM_set_threading(PGM_Handle* handle, PGM_Options* opt, PGM_Idx threading);
 
+/**
+ * @brief Specify how the scenarios of a batch calculation are distributed over the threads.
+ *
+ * With PGM_work_stealing, each thread starts with a contiguous block of scenarios,
+ * and threads that finish early take over scenarios of busy threads.
+ * With PGM_contiguous, each thread calculates exactly one contiguous block of scenarios in order.
+ * The solver state then carries over between consecutive scenarios, which is beneficial for time series.
+ * Combine it with PGM_previous_solution, see PGM_set_power_flow_initialization().
+ *
+ * @param handle
+ * @param opt The pointer to the option instance.
+ * @param batch_partitioning See #PGM_BatchPartitioning
+ */
+PGM_API void PGM_set_batch_partitioning(PGM_Handle* handle, PGM_Options* opt, PGM_Idx batch_partitioning);
+
 /**
  * @brief Specify the voltage scaling min/max for short circuit calculations
  *
@@ -110,6 +131,52 @@ PGM_API void PGM_set_threading(PGM_Handle* handle, PGM_Options* opt, PGM_Idx thr
 PGM_API void PGM_set_short_circuit_voltage_scaling(PGM_Handle* handle, PGM_Options* opt,
                                                    PGM_Idx short_circuit_voltage_scaling);
 
+/**
+ * @brief Specify the start voltage of iterative power flow calculations.
+ *
+ * With PGM_previous_solution, the calculation starts from the solution of the previous calculation on the same model.
+ * In a batch calculation, every scenario starts from the solution of the previous scenario in the same thread.
+ * This reduces the number of iterations if consecutive scenarios are similar, e.g. in a time series.
+ * If the calculation does not converge from the previous solution, it is repeated with a flat start.
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param power_flow_initialization See #PGM_PowerFlowInitialization
+ */
+PGM_API void PGM_set_power_flow_initialization(PGM_Handle* handle, PGM_Options* opt,
+                                               PGM_Idx power_flow_initialization);
+
+/**
+ * @brief Specify arrays to be filled with statistics of each scenario of a calculation.
+ *
+ * This can be used to find the scenarios which take a long time in a batch calculation.
+ * Each array which is not NULL should be pre-allocated with the length of the batch size,
+ * or 1 for a single calculation. The arrays are filled by every PGM_calculate() with these options,
+ * also for failed scenarios. Set all arrays to NULL to disable the statistics, which is the default.
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param n_iterations A pointer to a #PGM_Idx array, or NULL.
+ *   The maximum number of iterations over all sub-graphs of the scenario, 0 for non-iterative methods.
+ * @param max_deviation A pointer to a double array, or NULL.
+ *   The maximum final deviation over all sub-graphs of the scenario, NaN for non-iterative methods.
+ * @param wall_time A pointer to a double array, or NULL. The wall time of the scenario in seconds.
+ *   If several scenarios are solved at once, they share the wall time equally.
+ */
+PGM_API void PGM_set_scenario_statistics(PGM_Handle* handle, PGM_Options* opt, PGM_Idx* n_iterations,
+                                         double* max_deviation, double* wall_time);
+
+/**
+ * @brief Specify if the begin and end of the calculation steps should be recorded, per thread and scenario.
+ *
+ * The trace of the last calculation can be retrieved by PGM_get_trace().
+ *
+ * @param handle
+ * @param opt pointer to option instance
+ * @param tracing 1 to record the trace, 0 (default) to disable it
+ */
+PGM_API void PGM_set_tracing(PGM_Handle* handle, PGM_Options* opt, PGM_Idx tracing);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,11 +17,43 @@
 
 namespace {
 using namespace power_grid_model;
+
+// the paired output dataset should have the same layout as the output dataset
+bool is_same_output_layout(PGM_MutableDataset const& output_dataset, PGM_MutableDataset const& paired_output_dataset) {
+    if (output_dataset.is_batch() != paired_output_dataset.is_batch() ||
+        output_dataset.batch_size() != paired_output_dataset.batch_size() ||
+        output_dataset.n_components() != paired_output_dataset.n_components()) {
+        return false;
+    }
+    for (Idx i{}; i != output_dataset.n_components(); ++i) {
+        auto const& component_info = output_dataset.get_component_info(i);
+        Idx const paired_idx = paired_output_dataset.find_component(component_info.component->name);
+        if (paired_idx < 0) {
+            return false;
+        }
+        auto const& paired_component_info = paired_output_dataset.get_component_info(paired_idx);
+        if (component_info.elements_per_scenario != paired_component_info.elements_per_scenario ||
+            component_info.total_elements != paired_component_info.total_elements) {
+            return false;
+        }
+    }
+    return true;
+}
 } // namespace
 
 // aliases main class
 struct PGM_PowerGridModel : public MainModel {
     using MainModel::MainModel;
+
+    // the snapshot is not copied, the keys point into the snapshot of this instance
+    PGM_PowerGridModel(PGM_PowerGridModel const& other) : MainModel{other} {}
+
+    // snapshot of the calculation info, see PGM_get_calculation_info()
+    CalculationInfo calculation_info_snapshot;
+    std::vector<char const*> calculation_info_keys;
+    std::vector<double> calculation_info_values;
+    // trace of the last calculation, see PGM_get_trace()
+    std::string trace_json;
 };
 
 // create model
@@ -75,37 +107,43 @@ void PGM_calculate(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options co
         batch_dataset != nullptr ? batch_dataset->export_dataset<true>() : ConstDataset{};
 
     // call calculation
+    model->set_scenario_statistics(opt->scenario_statistics);
+    model->set_tracing(opt->tracing != 0);
     try {
         auto const calculation_method = static_cast<CalculationMethod>(opt->calculation_method);
+        auto const batch_partitioning = static_cast<BatchPartitioning>(opt->batch_partitioning);
         switch (opt->calculation_type) {
-        case PGM_power_flow:
+        case PGM_power_flow: {
+            auto const power_flow_initialization =
+                static_cast<PowerFlowInitialization>(opt->power_flow_initialization);
             if (opt->symmetric != 0) {
-                handle->batch_parameter =
-                    model->calculate_power_flow<true>(opt->err_tol, opt->max_iter, calculation_method,
-                                                      exported_output_dataset, exported_update_dataset, opt->threading);
+                handle->batch_parameter = model->calculate_power_flow<true>(
+                    opt->err_tol, opt->max_iter, calculation_method, exported_output_dataset, exported_update_dataset,
+                    opt->threading, power_flow_initialization, batch_partitioning);
             } else {
                 handle->batch_parameter = model->calculate_power_flow<false>(
                     opt->err_tol, opt->max_iter, calculation_method, exported_output_dataset, exported_update_dataset,
-                    opt->threading);
+                    opt->threading, power_flow_initialization, batch_partitioning);
             }
             break;
+        }
         case PGM_state_estimation:
             if (opt->symmetric != 0) {
                 handle->batch_parameter = model->calculate_state_estimation<true>(
                     opt->err_tol, opt->max_iter, calculation_method, exported_output_dataset, exported_update_dataset,
-                    opt->threading);
+                    opt->threading, batch_partitioning);
             } else {
                 handle->batch_parameter = model->calculate_state_estimation<false>(
                     opt->err_tol, opt->max_iter, calculation_method, exported_output_dataset, exported_update_dataset,
-                    opt->threading);
+                    opt->threading, batch_partitioning);
             }
             break;
         case PGM_short_circuit: {
             auto const short_circuit_voltage_scaling =
                 static_cast<ShortCircuitVoltageScaling>(opt->short_circuit_voltage_scaling);
-            handle->batch_parameter =
-                model->calculate_short_circuit(short_circuit_voltage_scaling, calculation_method,
-                                               exported_output_dataset, exported_update_dataset, opt->threading);
+            handle->batch_parameter = model->calculate_short_circuit(
+                short_circuit_voltage_scaling, calculation_method, exported_output_dataset, exported_update_dataset,
+                opt->threading, batch_partitioning);
             break;
         }
         default:
@@ -123,6 +161,100 @@ void PGM_calculate(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options co
         handle->err_code = PGM_regular_error;
         handle->err_msg = "Unknown error!\n";
     }
+    model->set_scenario_statistics({});
+    model->set_tracing(false);
+}
+
+// run short circuit calculation of both voltage scaling cases
+void PGM_calculate_short_circuit_paired(PGM_Handle* handle, PGM_PowerGridModel* model, PGM_Options const* opt,
+                                        PGM_MutableDataset const* output_dataset,
+                                        PGM_MutableDataset const* paired_output_dataset,
+                                        PGM_ConstDataset const* batch_dataset) {
+    PGM_clear_error(handle);
+    // check options and dataset integrity
+    if (opt->calculation_type != PGM_short_circuit) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = "The paired calculation is only available for short circuit calculations!\n";
+        return;
+    }
+    if ((batch_dataset != nullptr) &&
+        (!batch_dataset->is_batch() || !output_dataset->is_batch() || !paired_output_dataset->is_batch())) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = "If batch_dataset is provided. The batch_dataset, output_dataset and paired_output_dataset "
+                          "should all be a batch!\n";
+        return;
+    }
+    if (!is_same_output_layout(*output_dataset, *paired_output_dataset)) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = "The output_dataset and paired_output_dataset should have the same batch size and "
+                          "components!\n";
+        return;
+    }
+
+    Dataset const exported_output_dataset = output_dataset->export_dataset<false>();
+    Dataset const exported_paired_output_dataset = paired_output_dataset->export_dataset<false>();
+    auto const exported_update_dataset =
+        batch_dataset != nullptr ? batch_dataset->export_dataset<true>() : ConstDataset{};
+
+    // call calculation
+    model->set_scenario_statistics(opt->scenario_statistics);
+    model->set_tracing(opt->tracing != 0);
+    try {
+        auto const calculation_method = static_cast<CalculationMethod>(opt->calculation_method);
+        auto const batch_partitioning = static_cast<BatchPartitioning>(opt->batch_partitioning);
+        auto const short_circuit_voltage_scaling =
+            static_cast<ShortCircuitVoltageScaling>(opt->short_circuit_voltage_scaling);
+        handle->batch_parameter = model->calculate_short_circuit_paired(
+            short_circuit_voltage_scaling, calculation_method, exported_output_dataset, exported_paired_output_dataset,
+            exported_update_dataset, opt->threading, batch_partitioning);
+    } catch (BatchCalculationError& e) {
+        handle->err_code = PGM_batch_error;
+        handle->err_msg = e.what();
+        handle->failed_scenarios = e.failed_scenarios();
+        handle->batch_errs = e.err_msgs();
+    } catch (std::exception& e) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = e.what();
+    } catch (...) {
+        handle->err_code = PGM_regular_error;
+        handle->err_msg = "Unknown error!\n";
+    }
+    model->set_scenario_statistics({});
+    model->set_tracing(false);
+}
+
+// calculation info
+PGM_Idx PGM_get_calculation_info(PGM_Handle* handle, PGM_PowerGridModel* model) {
+    return call_with_catch(
+        handle,
+        [model] {
+            model->calculation_info_snapshot = model->calculation_info();
+            model->calculation_info_keys.clear();
+            model->calculation_info_values.clear();
+            for (auto const& [key, value] : model->calculation_info_snapshot) {
+                model->calculation_info_keys.push_back(key.c_str());
+                model->calculation_info_values.push_back(value);
+            }
+            return static_cast<Idx>(model->calculation_info_snapshot.size());
+        },
+        PGM_regular_error);
+}
+char const** PGM_calculation_info_keys(PGM_Handle* /* handle */, PGM_PowerGridModel* model) {
+    return model->calculation_info_keys.data();
+}
+double const* PGM_calculation_info_values(PGM_Handle* /* handle */, PGM_PowerGridModel const* model) {
+    return model->calculation_info_values.data();
+}
+
+// trace
+char const* PGM_get_trace(PGM_Handle* handle, PGM_PowerGridModel* model) {
+    return call_with_catch(
+        handle,
+        [model] {
+            model->trace_json = to_chrome_trace(model->trace());
+            return model->trace_json.c_str();
+        },
+        PGM_regular_error);
 }
 
 // destroy model
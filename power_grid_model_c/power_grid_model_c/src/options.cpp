@@ -26,7 +26,19 @@ void PGM_set_symmetric(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx sym)
 void PGM_set_err_tol(PGM_Handle* /* handle */, PGM_Options* opt, double err_tol) { opt->err_tol = err_tol; }
 void PGM_set_max_iter(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx max_iter) { opt->max_iter = max_iter; }
 void PGM_set_threading(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx threading) { opt->threading = threading; }
+void PGM_set_batch_partitioning(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx batch_partitioning) {
+    opt->batch_partitioning = batch_partitioning;
+}
 void PGM_set_short_circuit_voltage_scaling(PGM_Handle* /* handle */, PGM_Options* opt,
                                            PGM_Idx short_circuit_voltage_scaling) {
     opt->short_circuit_voltage_scaling = short_circuit_voltage_scaling;
 }
+void PGM_set_power_flow_initialization(PGM_Handle* /* handle */, PGM_Options* opt,
+                                       PGM_Idx power_flow_initialization) {
+    opt->power_flow_initialization = power_flow_initialization;
+}
+void PGM_set_scenario_statistics(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx* n_iterations,
+                                 double* max_deviation, double* wall_time) {
+    opt->scenario_statistics = {n_iterations, max_deviation, wall_time};
+}
+void PGM_set_tracing(PGM_Handle* /* handle */, PGM_Options* opt, PGM_Idx tracing) { opt->tracing = tracing; }
@@ -25,7 +25,11 @@ struct PGM_Options {
     double err_tol{1e-8};
     Idx max_iter{20};
     Idx threading{-1};
+    Idx batch_partitioning{PGM_work_stealing};
     Idx short_circuit_voltage_scaling{PGM_short_circuit_voltage_scaling_maximum};
+    Idx power_flow_initialization{PGM_flat_start};
+    power_grid_model::ScenarioStatistics scenario_statistics{};
+    Idx tracing{0};
 };
 
 #endif
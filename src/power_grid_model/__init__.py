@@ -7,6 +7,7 @@
 from power_grid_model.core.power_grid_meta import initialize_array, power_grid_meta_data
 from power_grid_model.core.power_grid_model import PowerGridModel
 from power_grid_model.enum import (
+    BatchPartitioning,
     Branch3Side,
     BranchSide,
     CalculationMethod,
@@ -15,6 +16,7 @@ from power_grid_model.enum import (
     FaultType,
     LoadGenType,
     MeasuredTerminalType,
+    PowerFlowInitialization,
     ShortCircuitVoltageScaling,
     WindingType,
 )
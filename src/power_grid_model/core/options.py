@@ -42,7 +42,9 @@ class Options:
     error_tolerance = OptionSetter(pgc.set_err_tol)
     max_iterations = OptionSetter(pgc.set_max_iter)
     threading = OptionSetter(pgc.set_threading)
+    batch_partitioning = OptionSetter(pgc.set_batch_partitioning)
     short_circuit_voltage_scaling = OptionSetter(pgc.set_short_circuit_voltage_scaling)
+    power_flow_initialization = OptionSetter(pgc.set_power_flow_initialization)
 
     @property
     def opt(self) -> OptionsPtr:
@@ -327,6 +327,12 @@ class PowerGridCore:
     ) -> None:  # type: ignore[empty-body]
         pass  # pragma: no cover
 
+    @make_c_binding
+    def set_power_flow_initialization(
+        self, opt: OptionsPtr, power_flow_initialization: int
+    ) -> None:  # type: ignore[empty-body]
+        pass  # pragma: no cover
+
     @make_c_binding
     def set_symmetric(self, opt: OptionsPtr, sym: int) -> None:  # type: ignore[empty-body]
         pass  # pragma: no cover
@@ -343,6 +349,10 @@ class PowerGridCore:
     def set_threading(self, opt: OptionsPtr, threading: int) -> None:  # type: ignore[empty-body]
         pass  # pragma: no cover
 
+    @make_c_binding
+    def set_batch_partitioning(self, opt: OptionsPtr, batch_partitioning: int) -> None:  # type: ignore[empty-body]
+        pass  # pragma: no cover
+
     @make_c_binding
     def create_model(  # type: ignore[empty-body]
         self,
@@ -388,6 +398,17 @@ class PowerGridCore:
     ) -> None:
         pass  # pragma: no cover
 
+    @make_c_binding
+    def calculate_short_circuit_paired(  # type: ignore[empty-body]
+        self,
+        model: ModelPtr,
+        opt: OptionsPtr,
+        output_data: MutableDatasetPtr,  # type: ignore[valid-type]
+        paired_output_data: MutableDatasetPtr,  # type: ignore[valid-type]
+        update_data: ConstDatasetPtr,  # type: ignore[valid-type]
+    ) -> None:
+        pass  # pragma: no cover
+
     @make_c_binding
     def dataset_info_name(self, info: DatasetInfoPtr) -> str:  # type: ignore[empty-body]
         pass  # pragma: no cover
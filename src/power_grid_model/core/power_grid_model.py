@@ -7,7 +7,7 @@
 Main power grid model class
 """
 from enum import IntEnum
-from typing import Dict, List, Optional, Set, Type, Union
+from typing import Dict, List, Optional, Set, Tuple, Type, Union
 
 import numpy as np
 
@@ -23,7 +23,13 @@ from power_grid_model.core.index_integer import IdNp, IdxNp
 from power_grid_model.core.options import Options
 from power_grid_model.core.power_grid_core import ConstDatasetPtr, IDPtr, IdxPtr, ModelPtr
 from power_grid_model.core.power_grid_core import power_grid_core as pgc
-from power_grid_model.enum import CalculationMethod, CalculationType, ShortCircuitVoltageScaling
+from power_grid_model.enum import (
+    BatchPartitioning,
+    CalculationMethod,
+    CalculationType,
+    PowerFlowInitialization,
+    ShortCircuitVoltageScaling,
+)
 
 
 class PowerGridModel:
@@ -195,6 +201,8 @@ class PowerGridModel:
 
         as_enum_value("calculation_method", CalculationMethod)
         as_enum_value("short_circuit_voltage_scaling", ShortCircuitVoltageScaling)
+        as_enum_value("power_flow_initialization", PowerFlowInitialization)
+        as_enum_value("batch_partitioning", BatchPartitioning)
 
         opt = Options()
         for key, value in kwargs.items():
@@ -204,7 +212,7 @@ class PowerGridModel:
     def _handle_errors(self, continue_on_batch_error: bool, batch_size: int):
         self._batch_error = handle_errors(continue_on_batch_error=continue_on_batch_error, batch_size=batch_size)
 
-    # pylint: disable=too-many-arguments
+    # pylint: disable=too-many-arguments,too-many-locals
     def _calculate_impl(
         self,
         calculation_type: CalculationType,
@@ -213,6 +221,7 @@ class PowerGridModel:
         output_component_types: Optional[Union[Set[str], List[str]]],
         options: Options,
         continue_on_batch_error: bool,
+        paired: bool = False,
     ):
         """
         Core calculation routine
@@ -224,8 +233,10 @@ class PowerGridModel:
             output_component_types:
             options:
             continue_on_batch_error:
+            paired: Whether to calculate the short circuit of both voltage scaling cases at once.
 
         Returns:
+            The output data, or a tuple of the output data and the paired output data if paired is True.
         """
         self._batch_error = None
         is_batch = update_data is not None
@@ -245,22 +256,40 @@ class PowerGridModel:
             is_batch=is_batch,
             batch_size=batch_size,
         )
-        prepared_result = prepare_output_view(
-            output_data=output_data,
-            output_type=get_output_type(calculation_type=calculation_type, symmetric=symmetric),
-        )
+        output_type = get_output_type(calculation_type=calculation_type, symmetric=symmetric)
+        prepared_result = prepare_output_view(output_data=output_data, output_type=output_type)
 
         # run calculation
-        pgc.calculate(
-            # model and options
-            self._model,
-            options.opt,
-            output_data=prepared_result.get_dataset_ptr(),
-            update_data=update_ptr,
-        )
+        if paired:
+            paired_output_data = self._construct_output(
+                output_component_types=output_component_types,
+                calculation_type=calculation_type,
+                symmetric=symmetric,
+                is_batch=is_batch,
+                batch_size=batch_size,
+            )
+            prepared_paired_result = prepare_output_view(output_data=paired_output_data, output_type=output_type)
+            pgc.calculate_short_circuit_paired(
+                # model and options
+                self._model,
+                options.opt,
+                output_data=prepared_result.get_dataset_ptr(),
+                paired_output_data=prepared_paired_result.get_dataset_ptr(),
+                update_data=update_ptr,
+            )
+        else:
+            pgc.calculate(
+                # model and options
+                self._model,
+                options.opt,
+                output_data=prepared_result.get_dataset_ptr(),
+                update_data=update_ptr,
+            )
 
         self._handle_errors(continue_on_batch_error=continue_on_batch_error, batch_size=batch_size)
 
+        if paired:
+            return output_data, paired_output_data
         return output_data
 
     def calculate_power_flow(
@@ -272,8 +301,10 @@ class PowerGridModel:
         calculation_method: Union[CalculationMethod, str] = CalculationMethod.newton_raphson,
         update_data: Optional[Dict[str, Union[np.ndarray, Dict[str, np.ndarray]]]] = None,
         threading: int = -1,
+        batch_partitioning: Union[BatchPartitioning, str] = BatchPartitioning.work_stealing,
         output_component_types: Optional[Union[Set[str], List[str]]] = None,
         continue_on_batch_error: bool = False,
+        power_flow_initialization: Union[PowerFlowInitialization, str] = PowerFlowInitialization.flat_start,
     ) -> Dict[str, np.ndarray]:
         """
         Calculate power flow once with the current model attributes.
@@ -292,6 +323,7 @@ class PowerGridModel:
 
                 - newton_raphson: Use Newton-Raphson iterative method (default).
                 - linear: Use linear method.
+                - fast_decoupled: Use fast decoupled iterative method.
             update_data (dict, optional):
                 None: Calculate power flow once with the current model attributes.
                 Or a dictionary for batch calculation with batch update.
@@ -310,15 +342,29 @@ class PowerGridModel:
                               compressed sparse structure.
                               https://docs.scipy.org/doc/scipy/reference/generated/scipy.sparse.csr_matrix.html
                             - data: 1D numpy structured array in flat.
-            threading (int, optional): Applicable only for batch calculation.
+            threading (int, optional): For batch calculation, the scenarios are calculated in parallel.
+                For a single calculation on a very large grid, the sparse matrix factorization is parallelized.
 
                 - < 0: Sequential
                 - = 0: Parallel, use number of hardware threads
                 - > 0: Specify number of parallel threads
+            batch_partitioning ({BatchPartitioning, str}, optional): For parallel batch calculation, how the
+                scenarios are distributed over the threads.
+
+                - work_stealing: Threads that finish early take over scenarios of busy threads (default).
+                - contiguous: Each thread calculates one contiguous block of scenarios in order. The solver state
+                  carries over between consecutive scenarios, e.g. in a time series.
             output_component_types ({set, list}, optional): List or set of component types you want to be present in
                 the output dict. By default, all component types will be in the output.
             continue_on_batch_error (bool, optional): If the program continues (instead of throwing error) if some
                 scenarios fail.
+            power_flow_initialization ({PowerFlowInitialization, str}, optional): The start voltage of the
+                iterative calculation methods.
+
+                - flat_start: Start from the average voltage of the sources (default).
+                - previous_solution: Start from the solution of the previous calculation on this model. In a batch
+                  calculation, each scenario starts from the solution of the previous scenario in the same thread.
+                  Falls back to flat start if the calculation does not converge.
 
         Returns:
             Dictionary of results of all components.
@@ -343,6 +389,8 @@ class PowerGridModel:
             max_iterations=max_iterations,
             calculation_method=calculation_method,
             threading=threading,
+            batch_partitioning=batch_partitioning,
+            power_flow_initialization=power_flow_initialization,
         )
         return self._calculate_impl(
             calculation_type=calculation_type,
@@ -362,6 +410,7 @@ class PowerGridModel:
         calculation_method: Union[CalculationMethod, str] = CalculationMethod.iterative_linear,
         update_data: Optional[Dict[str, Union[np.ndarray, Dict[str, np.ndarray]]]] = None,
         threading: int = -1,
+        batch_partitioning: Union[BatchPartitioning, str] = BatchPartitioning.work_stealing,
         output_component_types: Optional[Union[Set[str], List[str]]] = None,
         continue_on_batch_error: bool = False,
     ) -> Dict[str, np.ndarray]:
@@ -378,7 +427,10 @@ class PowerGridModel:
                 calculation method is iterative.
             max_iterations (int, optional): Maximum number of iterations, applicable only when the calculation method
                 is iterative.
-            calculation_method (an enumeration): Use iterative linear method.
+            calculation_method (an enumeration or string): The calculation method to use.
+
+                - iterative_linear: Use iterative linear method (default).
+                - newton_raphson: Use Newton-Raphson method.
             update_data (dict, optional):
                 None: Calculate state estimation once with the current model attributes.
                 Or a dictionary for batch calculation with batch update.
@@ -397,11 +449,18 @@ class PowerGridModel:
                               compressed sparse structure.
                               https://docs.scipy.org/doc/scipy/reference/generated/scipy.sparse.csr_matrix.html
                             - data: 1D numpy structured array in flat.
-            threading (int, optional): Applicable only for batch calculation.
+            threading (int, optional): For batch calculation, the scenarios are calculated in parallel.
+                For a single calculation on a very large grid, the sparse matrix factorization is parallelized.
 
                 - < 0: Sequential
                 - = 0: Parallel, use number of hardware threads
                 - > 0: Specify number of parallel threads
+            batch_partitioning ({BatchPartitioning, str}, optional): For parallel batch calculation, how the
+                scenarios are distributed over the threads.
+
+                - work_stealing: Threads that finish early take over scenarios of busy threads (default).
+                - contiguous: Each thread calculates one contiguous block of scenarios in order. The solver state
+                  carries over between consecutive scenarios, e.g. in a time series.
             output_component_types ({set, list}, optional): List or set of component types you want to be present in
                 the output dict. By default, all component types will be in the output.
             continue_on_batch_error (bool, optional): If the program continues (instead of throwing error) if some
@@ -430,6 +489,7 @@ class PowerGridModel:
             max_iterations=max_iterations,
             calculation_method=calculation_method,
             threading=threading,
+            batch_partitioning=batch_partitioning,
         )
         return self._calculate_impl(
             calculation_type=calculation_type,
@@ -446,6 +506,7 @@ class PowerGridModel:
         calculation_method: Union[CalculationMethod, str] = CalculationMethod.iec60909,
         update_data: Optional[Dict[str, Union[np.ndarray, Dict[str, np.ndarray]]]] = None,
         threading: int = -1,
+        batch_partitioning: Union[BatchPartitioning, str] = BatchPartitioning.work_stealing,
         output_component_types: Optional[Union[Set[str], List[str]]] = None,
         continue_on_batch_error: bool = False,
         short_circuit_voltage_scaling: Union[ShortCircuitVoltageScaling, str] = ShortCircuitVoltageScaling.maximum,
@@ -474,11 +535,18 @@ class PowerGridModel:
                               compressed sparse structure.
                               https://docs.scipy.org/doc/scipy/reference/generated/scipy.sparse.csr_matrix.html
                             - data: 1D numpy structured array in flat.
-            threading (int, optional): Applicable only for batch calculation.
+            threading (int, optional): For batch calculation, the scenarios are calculated in parallel.
+                For a single calculation on a very large grid, the sparse matrix factorization is parallelized.
 
                 - < 0: Sequential
                 - = 0: Parallel, use number of hardware threads
                 - > 0: Specify number of parallel threads
+            batch_partitioning ({BatchPartitioning, str}, optional): For parallel batch calculation, how the
+                scenarios are distributed over the threads.
+
+                - work_stealing: Threads that finish early take over scenarios of busy threads (default).
+                - contiguous: Each thread calculates one contiguous block of scenarios in order. The solver state
+                  carries over between consecutive scenarios, e.g. in a time series.
             output_component_types ({set, list}, optional):
                 List or set of component types you want to be present in the output dict.
                 By default, all component types will be in the output.
@@ -510,6 +578,57 @@ class PowerGridModel:
             symmetric=symmetric,
             calculation_method=calculation_method,
             threading=threading,
+            batch_partitioning=batch_partitioning,
+            short_circuit_voltage_scaling=short_circuit_voltage_scaling,
+        )
+        return self._calculate_impl(
+            calculation_type=calculation_type,
+            symmetric=symmetric,
+            update_data=update_data,
+            output_component_types=output_component_types,
+            options=options,
+            continue_on_batch_error=continue_on_batch_error,
+        )
+
+    def calculate_short_circuit_paired(
+        self,
+        *,
+        calculation_method: Union[CalculationMethod, str] = CalculationMethod.iec60909,
+        update_data: Optional[Dict[str, Union[np.ndarray, Dict[str, np.ndarray]]]] = None,
+        threading: int = -1,
+        batch_partitioning: Union[BatchPartitioning, str] = BatchPartitioning.work_stealing,
+        output_component_types: Optional[Union[Set[str], List[str]]] = None,
+        continue_on_batch_error: bool = False,
+        short_circuit_voltage_scaling: Union[ShortCircuitVoltageScaling, str] = ShortCircuitVoltageScaling.maximum,
+    ) -> Tuple[Dict[str, np.ndarray], Dict[str, np.ndarray]]:
+        """
+        Calculate a short circuit for both the maximum and minimum voltage scaling at once.
+        Both cases are calculated with the same matrix factorization,
+        which is about half the cost of two calls to calculate_short_circuit.
+
+        Args:
+            See calculate_short_circuit.
+            short_circuit_voltage_scaling ({ShortCircuitVoltageSaling, str}, optional):
+                The voltage scaling of the first result. The second result has the opposite voltage scaling.
+                By default, the first result is for the maximum voltage scaling.
+
+        Returns:
+            A tuple of two dictionaries of results of all components, see calculate_short_circuit.
+
+                - The results for short_circuit_voltage_scaling.
+                - The results for the opposite voltage scaling.
+        Raises:
+            Exception: In case an error in the core occurs, an exception will be thrown.
+        """
+        calculation_type = CalculationType.short_circuit
+        symmetric = False
+
+        options = self._options(
+            calculation_type=calculation_type,
+            symmetric=symmetric,
+            calculation_method=calculation_method,
+            threading=threading,
+            batch_partitioning=batch_partitioning,
             short_circuit_voltage_scaling=short_circuit_voltage_scaling,
         )
         return self._calculate_impl(
@@ -519,6 +638,7 @@ class PowerGridModel:
             output_component_types=output_component_types,
             options=options,
             continue_on_batch_error=continue_on_batch_error,
+            paired=True,
         )
 
     def __del__(self):
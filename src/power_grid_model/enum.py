@@ -65,6 +65,7 @@ class CalculationMethod(IntEnum):
     iterative_current = 3
     linear_current = 4
     iec60909 = 5
+    fast_decoupled = 6
 
 
 class MeasuredTerminalType(IntEnum):
@@ -171,3 +172,29 @@ class ShortCircuitVoltageScaling(IntEnum):
 
     minimum = 0
     maximum = 1
+
+
+class PowerFlowInitialization(IntEnum):
+    """Start voltage of iterative power flow calculations"""
+
+    flat_start = 0
+    """
+    Start from the average voltage of the sources
+    """
+    previous_solution = 1
+    """
+    Start from the solution of the previous calculation, fall back to flat start if that does not converge
+    """
+
+
+class BatchPartitioning(IntEnum):
+    """Distribution of the scenarios of a batch calculation over the threads"""
+
+    work_stealing = 0
+    """
+    Threads that finish early take over scenarios of busy threads
+    """
+    contiguous = 1
+    """
+    Each thread calculates one contiguous block of scenarios in order
+    """
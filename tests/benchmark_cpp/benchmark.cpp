@@ -2,142 +2,665 @@
 //
 // SPDX-License-Identifier: MPL-2.0
 
+#include "benchmark_suite.hpp"
 #include "fictional_grid_generator.hpp"
 
+#include <power_grid_model/auxiliary/dataset_handler.hpp>
+#include <power_grid_model/auxiliary/serialization/deserializer.hpp>
+#include <power_grid_model/auxiliary/serialization/serializer.hpp>
+#include <power_grid_model/id_index.hpp>
 #include <power_grid_model/main_model.hpp>
-#include <power_grid_model/timer.hpp>
 
+#include <array>
+#include <charconv>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <random>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+Benchmark suite of the power grid model core.
+
+Every case is run once for warm-up and then a number of times, and the min, median, p95 and mean wall time
+of the repetitions are reported. The cases are parameterized by grid size, grid type, symmetry, calculation method
+and number of threads. The grid types are radial, meshed (mv and lv rings) and transmission (meshed, with a meshed
+hv grid between the substations and three winding transformers). The results can be written to a JSON file, and
+compared with the JSON file of an earlier run.
+
+Usage: power_grid_model_benchmark_cpp [options]
+    --repeat N              number of measured repetitions per case (default 5)
+    --warmup N              number of warm-up runs per case (default 1)
+    --filter TEXT           only run the cases of which the name contains TEXT
+    --n-node N[,N...]       (rough) number of nodes of the generated grids, e.g. 1000000 for a large scale workload
+    --grid TYPE[,TYPE...]   grid types: radial, meshed and/or transmission (default all)
+    --threads N[,N...]      number of threads of the batch calculations, 0 for the number of hardware threads
+    --batch-size N          number of scenarios of the batch calculations
+    --output FILE           write the results as JSON to FILE
+    --baseline FILE         compare the results with the results in FILE, written by --output of an earlier run
+    --statistic NAME        statistic to compare with the baseline: min, median (default), p95 or mean
+    --tolerance X           relative slow down above which a case is a regression (default 0.1)
+Cases which fail are listed under "failures" in the JSON file. A case of the baseline which is selected by the filter,
+but failed or no longer exists, is a regression.
+The program returns 1 if any case regressed compared to the baseline.
+*/
 
 namespace power_grid_model::benchmark {
+namespace {
+
+constexpr double system_frequency = 50.0;
+
+enum class GridType { radial, meshed, transmission };
+
+std::string grid_name(GridType grid_type) {
+    switch (grid_type) {
+    case GridType::radial:
+        return "radial";
+    case GridType::meshed:
+        return "meshed";
+    default:
+        return "transmission";
+    }
+}
 
-struct PowerGridBenchmark {
-    PowerGridBenchmark() : main_model{std::make_unique<MainModel>(50.0)} {}
+struct SuiteOptions {
+    SuiteSettings settings;
+#ifndef NDEBUG
+    std::vector<Idx> n_nodes{200};
+    std::vector<Idx> threads{1, 2};
+    Idx batch_size{10};
+#else
+    std::vector<Idx> n_nodes{1500, 15000};
+    std::vector<Idx> threads{1, 2, 4, 8};
+    Idx batch_size{100};
+#endif
+    std::vector<GridType> grid_types{GridType::radial, GridType::meshed, GridType::transmission};
+    std::string output_file;
+    std::string baseline_file;
+    std::string statistic{"median"};
+    double tolerance{0.1};
+};
+
+std::string method_name(CalculationMethod calculation_method) {
+    using enum CalculationMethod;
+    switch (calculation_method) {
+    case linear:
+        return "linear";
+    case newton_raphson:
+        return "newton_raphson";
+    case iterative_linear:
+        return "iterative_linear";
+    case iterative_current:
+        return "iterative_current";
+    case linear_current:
+        return "linear_current";
+    case iec60909:
+        return "iec60909";
+    case fast_decoupled:
+        return "fast_decoupled";
+    default:
+        return "default";
+    }
+}
 
-    template <bool sym>
-    void run_pf(CalculationMethod calculation_method, CalculationInfo& info, Idx batch_size = -1, Idx threading = -1) {
-        if (!main_model) {
-            std::cout << "\nNo main model available: skipping benchmark.\n";
-            return;
+Option grid_option(Idx n_node, GridType grid_type) {
+    Option option{};
+    option.n_node_total_specified = n_node;
+#ifndef NDEBUG
+    option.n_mv_feeder = 3;
+    option.n_node_per_mv_feeder = 6;
+    option.n_lv_feeder = 2;
+    option.n_connection_per_lv_feeder = 4;
+#else
+    // about 75 nodes per mv feeder, including the lv grids
+    option.n_mv_feeder = std::max(n_node / 75, Idx{1});
+    option.n_node_per_mv_feeder = 10;
+    option.n_lv_feeder = 10;
+    option.n_connection_per_lv_feeder = 40;
+#endif
+    option.has_mv_ring = grid_type != GridType::radial;
+    option.has_lv_ring = grid_type != GridType::radial;
+    if (grid_type == GridType::transmission) {
+#ifndef NDEBUG
+        option.n_mv_feeder_per_substation = 1;
+#else
+        option.n_mv_feeder_per_substation = 4;
+#endif
+        option.has_hv_ring = true;
+        option.hv_mesh_span = 2;
+        option.n_substation_per_hv_source = 2;
+        option.use_three_winding_transformer = true;
+    } else {
+        // a single source cannot supply much more than 20 mv feeders, larger grids are split into separate substations
+        option.n_mv_feeder_per_substation = 20;
+        option.n_substation_per_hv_source = 1;
+    }
+    return option;
+}
+
+meta_data::ConstDatasetHandler input_dataset_handler(InputData const& input) {
+    meta_data::ConstDatasetHandler handler{false, 1, "input"};
+    auto const add = [&handler](std::string_view component, auto const& data) {
+        auto const size = static_cast<Idx>(data.size());
+        handler.add_buffer(component, size, size, nullptr, data.data());
+    };
+    add("node", input.node);
+    add("transformer", input.transformer);
+    add("three_winding_transformer", input.three_winding_transformer);
+    add("line", input.line);
+    add("source", input.source);
+    add("sym_load", input.sym_load);
+    add("asym_load", input.asym_load);
+    add("shunt", input.shunt);
+    return handler;
+}
+
+// parse the serialized data into newly allocated buffers, which are freed afterwards
+void deserialize(meta_data::Deserializer& deserializer) {
+    struct BufferDeleter {
+        meta_data::MetaComponent const* component;
+        void operator()(void* buffer) const { component->destroy_buffer(buffer); }
+    };
+    meta_data::WritableDatasetHandler& info = deserializer.get_dataset_info();
+    std::vector<std::unique_ptr<void, BufferDeleter>> buffers;
+    for (Idx i = 0; i != info.n_components(); ++i) {
+        meta_data::ComponentInfo const& component_info = info.get_component_info(i);
+        auto& buffer = buffers.emplace_back(component_info.component->create_buffer(component_info.total_elements),
+                                            BufferDeleter{component_info.component});
+        info.set_buffer(component_info.component->name, nullptr, buffer.get());
+    }
+    deserializer.parse();
+}
+
+class SuiteRunner {
+  public:
+    explicit SuiteRunner(SuiteOptions const& options) : options_{options}, suite_{options.settings} {}
+
+    void run() {
+        for (Idx const n_node : options_.n_nodes) {
+            for (GridType const grid_type : options_.grid_types) {
+                Parameters const grid{{"n_node", std::to_string(n_node)}, {"grid", grid_name(grid_type)}};
+                generator_.generate_grid(grid_option(n_node, grid_type), 0);
+                run_construction(grid);
+                run_serialization(grid);
+                run_power_flow<true>(grid);
+                run_power_flow<false>(grid);
+                run_power_flow_batch(grid);
+                if (generate_sensors()) {
+                    run_state_estimation<true>(grid);
+                    run_state_estimation<false>(grid);
+                }
+                run_short_circuit(grid);
+            }
+        }
+        run_unbalanced_batch();
+        run_n_minus_1();
+        run_contingency();
+        run_parallel_factorization();
+        run_id_index();
+        run_dependent_update();
+    }
+
+    BenchmarkSuite const& suite() const { return suite_; }
+
+  private:
+    SuiteOptions options_;
+    BenchmarkSuite suite_;
+    FictionalGridGenerator generator_;
+    std::unique_ptr<MainModel> main_model_;
+
+    static Parameters with(Parameters parameters, Parameters const& extra) {
+        parameters.insert(extra.cbegin(), extra.cend());
+        return parameters;
+    }
+
+    void build_model() {
+        main_model_ = std::make_unique<MainModel>(system_frequency, generator_.input_data().get_dataset());
+    }
+
+    // run the calculation on a newly constructed model (cold), and on an already calculated model (warm)
+    template <class Calculate> void run_cold_and_warm(std::string const& name, Parameters const& parameters,
+                                                      Calculate const& calculate) {
+        suite_.run(
+            name, with(parameters, {{"cache", "cold"}}), [this] { build_model(); }, calculate);
+        build_model();
+        suite_.run(name, with(parameters, {{"cache", "warm"}}), calculate);
+    }
+
+    void run_construction(Parameters const& grid) {
+        suite_.run(
+            "construction", grid, [this] { main_model_.reset(); }, [this] { build_model(); });
+    }
+
+    void run_serialization(Parameters const& grid) {
+        for (auto const format : {SerializationFormat::json, SerializationFormat::msgpack}) {
+            Parameters const parameters =
+                with(grid, {{"format", format == SerializationFormat::json ? "json" : "msgpack"}});
+            meta_data::ConstDatasetHandler const handler = input_dataset_handler(generator_.input_data());
+            std::vector<char> serialized;
+            suite_.run("serialization", parameters, [&handler, &serialized, format] {
+                meta_data::Serializer serializer{handler, format};
+                auto const buffer = serializer.get_binary_buffer(true);
+                serialized.assign(buffer.begin(), buffer.end());
+            });
+            if (serialized.empty()) {
+                continue;
+            }
+            suite_.run("deserialization", parameters, [&serialized, format] {
+                meta_data::Deserializer deserializer{meta_data::from_buffer, serialized, format};
+                deserialize(deserializer);
+            });
         }
+    }
+
+    template <bool sym> void run_power_flow(Parameters const& grid) {
+        using enum CalculationMethod;
+        std::vector<CalculationMethod> methods{newton_raphson, fast_decoupled, linear, linear_current};
+        if constexpr (sym) {
+            methods.push_back(iterative_current);
+        }
+        OutputData<sym> output = generator_.generate_output_data<sym>();
+        for (CalculationMethod const method : methods) {
+            Idx const max_iter = method == newton_raphson ? 20 : 100;
+            run_cold_and_warm("power_flow",
+                              with(grid, {{"sym", sym ? "1" : "0"}, {"method", method_name(method)}}),
+                              [this, &output, method, max_iter] {
+                                  main_model_->calculate_power_flow<sym>(1e-8, max_iter, method, output.get_dataset());
+                              });
+        }
+    }
 
-        OutputData<sym> output = generator.generate_output_data<sym>(batch_size);
-        BatchData const batch_data = generator.generate_batch_input(batch_size, 0);
-        std::cout << "Number of nodes: " << generator.input_data().node.size() << '\n';
-        Idx const max_iter = (calculation_method == CalculationMethod::iterative_current) ? 100 : 20;
+    // scaling of a time series batch (15 minute steps) with the number of threads
+    void run_power_flow_batch(Parameters const& grid) {
+        using enum CalculationMethod;
+        OutputData<true> output = generator_.generate_output_data<true>(options_.batch_size);
+        BatchData const batch_data = generator_.generate_time_series_batch_input(options_.batch_size, 96, 0);
+        build_model();
+        for (CalculationMethod const method : {newton_raphson, linear_current}) {
+            for (Idx const threads : options_.threads) {
+                suite_.run("power_flow_batch",
+                           with(grid, {{"method", method_name(method)},
+                                       {"threads", std::to_string(threads)},
+                                       {"batch_size", std::to_string(options_.batch_size)}}),
+                           [this, &output, &batch_data, method, threads] {
+                               main_model_->calculate_power_flow<true>(1e-8, 20, method, output.get_dataset(),
+                                                                       batch_data.get_dataset(), threads);
+                           });
+            }
+        }
+    }
+
+    // measurements with noise, derived from the power flow result
+    // all loads and sources, 10% of the nodes and 20% of the branches are measured
+    bool generate_sensors() {
+        build_model();
+        OutputData<true> reference = generator_.generate_output_data<true>();
         try {
-            // calculate
-            main_model->calculate_power_flow<sym>(1e-8, max_iter, calculation_method, output.get_dataset(),
-                                                  batch_data.get_dataset(), threading);
-            CalculationInfo info_extra = main_model->calculation_info();
-            info.merge(info_extra);
+            main_model_->calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson,
+                                                    reference.get_dataset());
         } catch (std::exception const& e) {
-            std::cout << "\nAn exception was raised during execution: " << e.what() << '\n';
+            std::cout << "No state estimation, the reference power flow failed: " << e.what() << '\n';
+            return false;
         }
+        generator_.generate_sensors({.voltage_coverage = 0.1,
+                                     .appliance_coverage = 1.0,
+                                     .branch_coverage = 0.2,
+                                     .voltage_noise = 1e-3,
+                                     .power_noise = 0.02},
+                                    reference, 0);
+        return true;
     }
 
-    template <bool sym>
-    void run_benchmark(Option const& option, CalculationMethod calculation_method, Idx batch_size = -1,
-                       Idx threading = -1) {
-        CalculationInfo info;
-        generator.generate_grid(option, 0);
-        InputData const& input = generator.input_data();
-
-        std::string title = "Benchmark case: ";
-        title += option.has_mv_ring ? "meshed grid, " : "radial grid, ";
-        title += sym ? "symmetric, " : "asymmetric, ";
-        if (calculation_method == CalculationMethod::newton_raphson) {
-            title += "Newton-Raphson method";
-        } else if (calculation_method == CalculationMethod::linear) {
-            title += "Linear method";
-        } else {
-            title += "Iterative current method";
+    // the iterative linear method converges too slowly on the meshed hv grid of the transmission grid
+    template <bool sym> void run_state_estimation(Parameters const& grid) {
+        using enum CalculationMethod;
+        OutputData<sym> output = generator_.generate_output_data<sym>();
+        for (CalculationMethod const method : {iterative_linear, newton_raphson}) {
+            if (method == iterative_linear && grid.at("grid") == grid_name(GridType::transmission)) {
+                continue;
+            }
+            run_cold_and_warm("state_estimation",
+                              with(grid, {{"sym", sym ? "1" : "0"}, {"method", method_name(method)}}),
+                              [this, &output, method] {
+                                  main_model_->calculate_state_estimation<sym>(1e-8, 20, method, output.get_dataset());
+                              });
         }
-        std::cout << "=============" << title << "=============\n";
+    }
+
+    void run_short_circuit(Parameters const& grid) {
+        for (FaultType const fault_type : {FaultType::three_phase, FaultType::single_phase_to_ground}) {
+            Parameters const parameters =
+                with(grid, {{"fault_type", fault_type == FaultType::three_phase ? "three_phase" : "single_phase"}});
+            generator_.generate_fault(fault_type);
+            ShortCircuitOutputData output = generator_.generate_short_circuit_output_data();
+            run_cold_and_warm("short_circuit", parameters, [this, &output] {
+                main_model_->calculate_short_circuit(ShortCircuitVoltageScaling::maximum, CalculationMethod::iec60909,
+                                                     output.get_dataset());
+            });
 
-        {
-            std::cout << "*****Run with initialization*****\n";
-            Timer const t_total(info, 0000, "Total");
-            {
-                Timer const t_build(info, 1000, "Build model");
-                main_model = std::make_unique<MainModel>(50.0, input.get_dataset());
+            // the fault is moved over the mv nodes
+            ShortCircuitOutputData batch_output = generator_.generate_short_circuit_output_data(options_.batch_size);
+            BatchData const batch_data = generator_.generate_fault_sweep_batch_input(options_.batch_size);
+            build_model();
+            for (Idx const threads : options_.threads) {
+                suite_.run("short_circuit_batch",
+                           with(parameters, {{"threads", std::to_string(threads)},
+                                             {"batch_size", std::to_string(options_.batch_size)}}),
+                           [this, &batch_output, &batch_data, threads] {
+                               main_model_->calculate_short_circuit(
+                                   ShortCircuitVoltageScaling::maximum, CalculationMethod::iec60909,
+                                   batch_output.get_dataset(), batch_data.get_dataset(), threads);
+                           });
             }
-            run_pf<sym>(calculation_method, info);
         }
-        print(info);
-        info.clear();
-        {
-            std::cout << "\n*****Run without initialization*****\n";
-            Timer const t_total(info, 0000, "Total");
-            run_pf<sym>(calculation_method, info);
+    }
+
+    // batch in which part of the scenarios are islanded and finish fast
+    // the wall time shows how well the remaining expensive scenarios are spread over the threads
+    void run_unbalanced_batch() {
+        Idx const n_node = options_.n_nodes.front();
+        generator_.generate_grid(grid_option(n_node, GridType::meshed), 0);
+        OutputData<true> output = generator_.generate_output_data<true>(options_.batch_size);
+        BatchData const batch_data = generator_.generate_unbalanced_batch_input(options_.batch_size, 0, 0.5);
+        build_model();
+        for (Idx const threads : options_.threads) {
+            suite_.run("power_flow_batch_unbalanced",
+                       {{"n_node", std::to_string(n_node)},
+                        {"ratio_islanded", "0.5"},
+                        {"threads", std::to_string(threads)},
+                        {"batch_size", std::to_string(options_.batch_size)}},
+                       [this, &output, &batch_data, threads] {
+                           main_model_->calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson,
+                                                                   output.get_dataset(), batch_data.get_dataset(),
+                                                                   threads);
+                       });
+        }
+    }
+
+    // N-1 contingency batch, every scenario opens one line
+    // the linear method re-uses the base case factorization
+    void run_n_minus_1() {
+        Idx const n_node = options_.n_nodes.front();
+        generator_.generate_grid(grid_option(n_node, GridType::meshed), 0);
+        BatchData const batch_data = generator_.generate_n_minus_1_batch_input();
+        OutputData<true> output = generator_.generate_output_data<true>(batch_data.batch_size);
+        build_model();
+        for (Idx const threads : options_.threads) {
+            suite_.run("power_flow_n_minus_1",
+                       {{"n_node", std::to_string(n_node)},
+                        {"method", "linear"},
+                        {"threads", std::to_string(threads)},
+                        {"batch_size", std::to_string(batch_data.batch_size)}},
+                       [this, &output, &batch_data, threads] {
+                           main_model_->calculate_power_flow<true>(1e-8, 20, CalculationMethod::linear,
+                                                                   output.get_dataset(), batch_data.get_dataset(),
+                                                                   threads);
+                       });
         }
-        print(info);
+    }
 
-        if (batch_size > 0) {
-            info.clear();
-            std::cout << "\n*****Run with batch calculation*****\n";
-            Timer const t_total(info, 0000, "Total");
-            run_pf<sym>(calculation_method, info, batch_size, threading);
+    // contingency batch on the transmission grid, every scenario opens a random line or transformer
+    void run_contingency() {
+        Idx const n_node = options_.n_nodes.front();
+        generator_.generate_grid(grid_option(n_node, GridType::transmission), 0);
+        BatchData const batch_data = generator_.generate_contingency_batch_input(options_.batch_size, 0);
+        OutputData<true> output = generator_.generate_output_data<true>(batch_data.batch_size);
+        build_model();
+        for (Idx const threads : options_.threads) {
+            suite_.run("power_flow_contingency",
+                       {{"n_node", std::to_string(n_node)},
+                        {"grid", grid_name(GridType::transmission)},
+                        {"method", "newton_raphson"},
+                        {"threads", std::to_string(threads)},
+                        {"batch_size", std::to_string(batch_data.batch_size)}},
+                       [this, &output, &batch_data, threads] {
+                           main_model_->calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson,
+                                                                   output.get_dataset(), batch_data.get_dataset(),
+                                                                   threads);
+                       });
         }
-        print(info);
+    }
 
-        std::cout << "\n\n";
+    // single calculation on a large grid, with the sparse LU factorization parallelized over the threads
+    // the transmission grid is used, because it is a single connected grid
+    void run_parallel_factorization() {
+        Idx const n_node = options_.n_nodes.back() * 50;
+        generator_.generate_grid(grid_option(n_node, GridType::transmission), 0);
+        OutputData<true> output = generator_.generate_output_data<true>();
+        build_model();
+        for (Idx const threads : options_.threads) {
+            suite_.run("power_flow_parallel_factorization",
+                       {{"n_node", std::to_string(n_node)},
+                        {"grid", grid_name(GridType::transmission)},
+                        {"method", "linear"},
+                        {"threads", std::to_string(threads)}},
+                       [this, &output, threads] {
+                           main_model_->calculate_power_flow<true>(1e-8, 20, CalculationMethod::linear,
+                                                                   output.get_dataset(), ConstDataset{}, threads);
+                       });
+        }
     }
 
-    static void print(CalculationInfo const& info) {
-        for (auto const& [key, val] : info) {
-            std::cout << key << ": " << val << '\n';
+    // ID index of the component container versus std::unordered_map, insertion and lookup in random order
+    void run_id_index() {
+#ifndef NDEBUG
+        Idx constexpr n_component = 10'000;
+#else
+        Idx constexpr n_component = 1'000'000;
+#endif
+        for (bool const dense_ids : {true, false}) {
+            std::mt19937_64 gen{0};
+            std::vector<ID> ids(n_component);
+            if (dense_ids) {
+                std::iota(ids.begin(), ids.end(), ID{0});
+            } else {
+                std::uniform_int_distribution<ID> id_gen{0, std::numeric_limits<ID>::max()};
+                std::unordered_set<ID> id_set;
+                while (static_cast<Idx>(id_set.size()) < n_component) {
+                    id_set.insert(id_gen(gen));
+                }
+                std::copy(id_set.cbegin(), id_set.cend(), ids.begin());
+            }
+            std::shuffle(ids.begin(), ids.end(), gen);
+            std::vector<ID> lookup_ids = ids;
+            std::shuffle(lookup_ids.begin(), lookup_ids.end(), gen);
+
+            Parameters const parameters{{"n_component", std::to_string(n_component)},
+                                        {"ids", dense_ids ? "dense" : "sparse"}};
+            Idx map_checksum{0};
+            Idx index_checksum{0};
+
+            std::unordered_map<ID, Idx2D> map;
+            suite_.run(
+                "id_index_insert", with(parameters, {{"container", "unordered_map"}}), [&map] { map.clear(); },
+                [&map, &ids] {
+                    map.reserve(ids.size());
+                    for (Idx i = 0; i != static_cast<Idx>(ids.size()); ++i) {
+                        map[ids[i]] = Idx2D{0, i};
+                    }
+                });
+            suite_.run("id_index_lookup", with(parameters, {{"container", "unordered_map"}}),
+                       [&map, &lookup_ids, &map_checksum] {
+                           for (ID const id : lookup_ids) {
+                               map_checksum += map.find(id)->second.pos;
+                           }
+                       });
+
+            IdIndex index;
+            suite_.run(
+                "id_index_insert", with(parameters, {{"container", "IdIndex"}}), [&index] { index = IdIndex{}; },
+                [&index, &ids] {
+                    index.reserve(static_cast<Idx>(ids.size()));
+                    for (Idx i = 0; i != static_cast<Idx>(ids.size()); ++i) {
+                        index.insert(ids[i], Idx2D{0, i});
+                    }
+                    index.compact();
+                });
+            suite_.run("id_index_lookup", with(parameters, {{"container", "IdIndex"}}),
+                       [&index, &lookup_ids, &index_checksum] {
+                           for (ID const id : lookup_ids) {
+                               index_checksum += index.find(id)->pos;
+                           }
+                       });
+            // both lookups find the same positions, if both are run
+            if (map_checksum != 0 && index_checksum != 0 && map_checksum != index_checksum) {
+                std::cout << "The lookups of the ID index and std::unordered_map differ\n";
+            }
         }
     }
 
-    std::unique_ptr<MainModel> main_model;
-    FictionalGridGenerator generator;
+    // a batch of updates with IDs in a different order per scenario
+    // every update looks up the components by ID
+    void run_dependent_update() {
+        Idx const n_node = options_.n_nodes.back() * 10;
+        Option option = grid_option(options_.n_nodes.back(), GridType::meshed);
+        option.n_node_total_specified = n_node;
+        option.n_mv_feeder *= 10;
+        generator_.generate_grid(option, 0);
+        Idx constexpr batch_size = 10;
+        BatchData const batch_data = generator_.generate_dependent_batch_input(batch_size, 0);
+        ConstDataset const update_data = batch_data.get_dataset();
+        build_model();
+        suite_.run("update_dependent_batch",
+                   {{"n_node", std::to_string(n_node)}, {"batch_size", std::to_string(batch_size)}},
+                   [this, &update_data] {
+                       for (Idx batch = 0; batch != batch_size; ++batch) {
+                           main_model_->update_component<MainModel::cached_update_t>(update_data, batch);
+                           main_model_->restore_components();
+                       }
+                   });
+    }
 };
 
+std::vector<Idx> parse_list(std::string_view text) {
+    std::vector<Idx> values;
+    while (!text.empty()) {
+        auto const comma = text.find(',');
+        std::string_view const item = text.substr(0, comma);
+        Idx value{};
+        if (std::from_chars(item.data(), item.data() + item.size(), value).ec != std::errc{}) {
+            throw std::invalid_argument{"Invalid number: " + std::string{item}};
+        }
+        values.push_back(value);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+    }
+    if (values.empty()) {
+        throw std::invalid_argument{"Empty list"};
+    }
+    return values;
+}
+
+std::vector<GridType> parse_grid_types(std::string_view text) {
+    std::vector<GridType> grid_types;
+    while (!text.empty()) {
+        auto const comma = text.find(',');
+        std::string_view const item = text.substr(0, comma);
+        constexpr std::array all_grid_types{GridType::radial, GridType::meshed, GridType::transmission};
+        auto const grid_type =
+            std::ranges::find_if(all_grid_types, [item](GridType type) { return grid_name(type) == item; });
+        if (grid_type == all_grid_types.cend()) {
+            throw std::invalid_argument{"Invalid grid type: " + std::string{item}};
+        }
+        grid_types.push_back(*grid_type);
+        text = comma == std::string_view::npos ? std::string_view{} : text.substr(comma + 1);
+    }
+    if (grid_types.empty()) {
+        throw std::invalid_argument{"Empty list"};
+    }
+    return grid_types;
+}
+
+SuiteOptions parse_options(int argc, char** argv) {
+    SuiteOptions options{};
+    std::vector<std::string_view> const args(argv + 1, argv + argc);
+    for (auto it = args.cbegin(); it != args.cend(); ++it) {
+        std::string_view const arg = *it;
+        if (it + 1 == args.cend()) {
+            throw std::invalid_argument{"Missing value of argument: " + std::string{arg}};
+        }
+        std::string_view const value = *(++it);
+        if (arg == "--repeat") {
+            options.settings.n_repeat = std::max(parse_list(value).front(), Idx{1});
+        } else if (arg == "--warmup") {
+            options.settings.n_warmup = parse_list(value).front();
+        } else if (arg == "--filter") {
+            options.settings.filter = value;
+        } else if (arg == "--n-node") {
+            options.n_nodes = parse_list(value);
+        } else if (arg == "--grid") {
+            options.grid_types = parse_grid_types(value);
+        } else if (arg == "--threads") {
+            options.threads = parse_list(value);
+        } else if (arg == "--batch-size") {
+            options.batch_size = std::max(parse_list(value).front(), Idx{1});
+        } else if (arg == "--output") {
+            options.output_file = value;
+        } else if (arg == "--baseline") {
+            options.baseline_file = value;
+        } else if (arg == "--statistic") {
+            if (!is_statistic(value)) {
+                throw std::invalid_argument{"Unknown statistic: " + std::string{value}};
+            }
+            options.statistic = value;
+        } else if (arg == "--tolerance") {
+            options.tolerance = std::stod(std::string{value});
+        } else {
+            throw std::invalid_argument{"Unknown argument: " + std::string{arg}};
+        }
+    }
+    return options;
+}
+
+} // namespace
 } // namespace power_grid_model::benchmark
 
-int main(int /* argc */, char** /* argv */) {
-    using enum power_grid_model::CalculationMethod;
+int main(int argc, char** argv) {
+    using namespace power_grid_model::benchmark;
+
+    SuiteOptions options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (std::exception const& e) {
+        std::cerr << e.what() << "\nSee the top of benchmark.cpp for the usage.\n";
+        return 2;
+    }
 
-    power_grid_model::benchmark::PowerGridBenchmark benchmarker{};
-    power_grid_model::benchmark::Option option{};
+    SuiteRunner runner{options};
+    runner.run();
+    auto const& results = runner.suite().results();
+    auto const& failures = runner.suite().failures();
 
+    if (!options.output_file.empty()) {
 #ifndef NDEBUG
-    option.n_node_total_specified = 200;
-    option.n_mv_feeder = 3;
-    option.n_node_per_mv_feeder = 6;
-    option.n_lv_feeder = 2;
-    option.n_connection_per_lv_feeder = 4;
-    power_grid_model::Idx constexpr batch_size = 10;
+        bool constexpr debug = true;
 #else
-    option.n_node_total_specified = 1500;
-    option.n_mv_feeder = 20;
-    option.n_node_per_mv_feeder = 10;
-    option.n_lv_feeder = 10;
-    option.n_connection_per_lv_feeder = 40;
-    power_grid_model::Idx constexpr batch_size = 1000;
+        bool constexpr debug = false;
 #endif
+        nlohmann::json const context{{"debug", debug},
+                                     {"hardware_concurrency", std::thread::hardware_concurrency()},
+                                     {"n_repeat", options.settings.n_repeat},
+                                     {"n_warmup", options.settings.n_warmup}};
+        std::ofstream{options.output_file} << to_json(results, failures, context).dump(2) << '\n';
+    }
 
-    // radial
-    option.has_mv_ring = false;
-    option.has_lv_ring = false;
-    benchmarker.run_benchmark<true>(option, newton_raphson, batch_size);
-    benchmarker.run_benchmark<true>(option, newton_raphson, batch_size, 6);
-    benchmarker.run_benchmark<true>(option, linear);
-    benchmarker.run_benchmark<true>(option, iterative_current);
-    benchmarker.run_benchmark<false>(option, newton_raphson);
-    benchmarker.run_benchmark<false>(option, linear);
-    // benchmarker.run_benchmark<false>(option, iterative_current);
-
-    // with meshed ring
-    option.has_mv_ring = true;
-    option.has_lv_ring = true;
-    benchmarker.run_benchmark<true>(option, newton_raphson);
-    benchmarker.run_benchmark<true>(option, linear);
-    benchmarker.run_benchmark<true>(option, iterative_current);
-    benchmarker.run_benchmark<false>(option, newton_raphson);
-    benchmarker.run_benchmark<false>(option, linear);
-    // benchmarker.run_benchmark<false>(option, iterative_current);
+    if (!options.baseline_file.empty()) {
+        std::ifstream baseline_file{options.baseline_file};
+        if (!baseline_file) {
+            std::cerr << "Cannot open baseline: " << options.baseline_file << '\n';
+            return 2;
+        }
+        auto const comparisons =
+            compare(results, results_from_json(nlohmann::json::parse(baseline_file)), options.statistic,
+                    options.tolerance, [&runner](std::string const& name) { return runner.suite().selected(name); });
+        print_comparison(comparisons);
+        if (std::ranges::any_of(comparisons, &Comparison::regression)) {
+            return 1;
+        }
+    }
     return 0;
 }
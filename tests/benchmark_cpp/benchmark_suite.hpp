@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include <power_grid_model/power_grid_model.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace power_grid_model::benchmark {
+
+using Parameters = std::map<std::string, std::string>;
+
+// statistics which can be compared with a baseline
+constexpr std::array<std::string_view, 4> statistic_names{"min", "median", "p95", "mean"};
+
+inline bool is_statistic(std::string_view statistic) {
+    return std::ranges::find(statistic_names, statistic) != statistic_names.cend();
+}
+
+// wall time statistics of the repetitions of one benchmark case, in seconds
+struct BenchmarkResult {
+    std::string name; // name of the case, including the parameters
+    Parameters parameters;
+    Idx n_repeat{};
+    double min{};
+    double median{};
+    double p95{};
+    double mean{};
+
+    // statistic by name, for the comparison with a baseline
+    double get(std::string_view statistic) const {
+        if (statistic == "min") {
+            return min;
+        }
+        if (statistic == "p95") {
+            return p95;
+        }
+        if (statistic == "mean") {
+            return mean;
+        }
+        if (statistic == "median") {
+            return median;
+        }
+        throw std::invalid_argument{"Unknown statistic: " + std::string{statistic}};
+    }
+};
+
+// a case which threw during the setup or the body
+struct FailedCase {
+    std::string name; // name of the case, including the parameters
+    Parameters parameters;
+    std::string error;
+};
+
+// nearest rank percentile of sorted values, fraction in [0, 1]
+inline double percentile(std::vector<double> const& sorted, double fraction) {
+    assert(!sorted.empty());
+    auto const rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+    return sorted[std::clamp(rank, size_t{1}, sorted.size()) - 1];
+}
+
+inline BenchmarkResult summarize(std::string name, Parameters parameters, std::vector<double> times) {
+    std::ranges::sort(times);
+    auto const n = times.size();
+    return BenchmarkResult{
+        .name = std::move(name),
+        .parameters = std::move(parameters),
+        .n_repeat = static_cast<Idx>(n),
+        .min = times.front(),
+        .median = n % 2 == 1 ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]),
+        .p95 = percentile(times, 0.95),
+        .mean = std::reduce(times.cbegin(), times.cend()) / static_cast<double>(n),
+    };
+}
+
+// the name of a case is the base name followed by the parameters, e.g. power_flow[method=linear,sym=1]
+inline std::string case_name(std::string const& base_name, Parameters const& parameters) {
+    std::string name = base_name + "[";
+    for (auto it = parameters.cbegin(); it != parameters.cend(); ++it) {
+        if (it != parameters.cbegin()) {
+            name += ",";
+        }
+        name += it->first + "=" + it->second;
+    }
+    return name + "]";
+}
+
+struct SuiteSettings {
+    Idx n_repeat{5};
+    Idx n_warmup{1};
+    std::string filter; // only run the cases of which the name contains the filter
+};
+
+class BenchmarkSuite {
+  public:
+    explicit BenchmarkSuite(SuiteSettings settings) : settings_{std::move(settings)} {}
+
+    bool selected(std::string const& name) const {
+        return settings_.filter.empty() || name.find(settings_.filter) != std::string::npos;
+    }
+
+    // run the setup (not timed) and the body (timed), first for the warm-up and then for the measured repetitions
+    // a case which throws is recorded as failed, without timing results
+    template <class Setup, class Body>
+    void run(std::string const& base_name, Parameters parameters, Setup&& setup, Body&& body) {
+        std::string name = case_name(base_name, parameters);
+        if (!selected(name)) {
+            return;
+        }
+        std::cout << std::left << std::setw(100) << name << std::flush;
+        std::vector<double> times;
+        try {
+            for (Idx i = 0; i != settings_.n_warmup + settings_.n_repeat; ++i) {
+                setup();
+                auto const start = Clock::now();
+                body();
+                auto const duration = Duration(Clock::now() - start).count();
+                if (i >= settings_.n_warmup) {
+                    times.push_back(duration);
+                }
+            }
+        } catch (std::exception const& e) {
+            std::cout << "failed: " << e.what() << '\n';
+            failures_.push_back({.name = std::move(name), .parameters = std::move(parameters), .error = e.what()});
+            return;
+        }
+        results_.push_back(summarize(std::move(name), std::move(parameters), std::move(times)));
+        std::cout << "median " << std::scientific << std::setprecision(3) << results_.back().median << " s\n"
+                  << std::defaultfloat;
+    }
+
+    template <class Body> void run(std::string const& base_name, Parameters parameters, Body&& body) {
+        run(base_name, std::move(parameters), [] {}, std::forward<Body>(body));
+    }
+
+    std::vector<BenchmarkResult> const& results() const { return results_; }
+    std::vector<FailedCase> const& failures() const { return failures_; }
+
+  private:
+    SuiteSettings settings_;
+    std::vector<BenchmarkResult> results_;
+    std::vector<FailedCase> failures_;
+};
+
+inline nlohmann::json to_json(std::vector<BenchmarkResult> const& results, std::vector<FailedCase> const& failures,
+                              nlohmann::json context) {
+    nlohmann::json result_list = nlohmann::json::array();
+    for (BenchmarkResult const& result : results) {
+        result_list.push_back({{"name", result.name},
+                               {"parameters", result.parameters},
+                               {"n_repeat", result.n_repeat},
+                               {"min", result.min},
+                               {"median", result.median},
+                               {"p95", result.p95},
+                               {"mean", result.mean}});
+    }
+    nlohmann::json failure_list = nlohmann::json::array();
+    for (FailedCase const& failure : failures) {
+        failure_list.push_back(
+            {{"name", failure.name}, {"parameters", failure.parameters}, {"error", failure.error}});
+    }
+    return {{"context", std::move(context)},
+            {"unit", "s"},
+            {"results", std::move(result_list)},
+            {"failures", std::move(failure_list)}};
+}
+
+inline std::vector<BenchmarkResult> results_from_json(nlohmann::json const& json) {
+    std::vector<BenchmarkResult> results;
+    for (auto const& item : json.at("results")) {
+        results.push_back({.name = item.at("name").get<std::string>(),
+                           .parameters = item.at("parameters").get<Parameters>(),
+                           .n_repeat = item.at("n_repeat").get<Idx>(),
+                           .min = item.at("min").get<double>(),
+                           .median = item.at("median").get<double>(),
+                           .p95 = item.at("p95").get<double>(),
+                           .mean = item.at("mean").get<double>()});
+    }
+    return results;
+}
+
+// comparison of one case with the same case in the baseline
+// current and ratio are nan if the case is missing in the results
+struct Comparison {
+    std::string name;
+    double baseline;
+    double current;
+    double ratio;
+    bool regression;
+};
+
+// a case regresses if the statistic is more than the tolerance (relative) slower than in the baseline
+// a case of the baseline which is selected but missing in the results, because it failed or no longer exists,
+//     is also a regression
+// cases which are not in the baseline are not compared
+template <class Selected>
+std::vector<Comparison> compare(std::vector<BenchmarkResult> const& results,
+                                std::vector<BenchmarkResult> const& baseline, std::string_view statistic,
+                                double tolerance, Selected&& selected) {
+    std::map<std::string, BenchmarkResult const*, std::less<>> result_map;
+    for (BenchmarkResult const& result : results) {
+        result_map[result.name] = &result;
+    }
+    std::vector<Comparison> comparisons;
+    for (BenchmarkResult const& baseline_result : baseline) {
+        double const baseline_value = baseline_result.get(statistic);
+        auto const found = result_map.find(baseline_result.name);
+        if (found == result_map.cend()) {
+            if (selected(baseline_result.name)) {
+                double constexpr nan = std::numeric_limits<double>::quiet_NaN();
+                comparisons.push_back({baseline_result.name, baseline_value, nan, nan, true});
+            }
+            continue;
+        }
+        double const current_value = found->second->get(statistic);
+        double const ratio = current_value / baseline_value;
+        comparisons.push_back({baseline_result.name, baseline_value, current_value, ratio, ratio > 1.0 + tolerance});
+    }
+    return comparisons;
+}
+
+inline void print_comparison(std::vector<Comparison> const& comparisons) {
+    std::cout << "\n=============Comparison with baseline=============\n";
+    for (Comparison const& comparison : comparisons) {
+        std::cout << std::left << std::setw(100) << comparison.name << std::scientific << std::setprecision(3)
+                  << comparison.baseline << " s -> ";
+        if (std::isnan(comparison.current)) {
+            std::cout << "missing, failed or removed REGRESSION\n";
+            continue;
+        }
+        std::cout << comparison.current << " s (" << std::fixed << std::setprecision(2) << comparison.ratio << "x)"
+                  << (comparison.regression ? " REGRESSION" : "") << '\n'
+                  << std::defaultfloat;
+    }
+}
+
+} // namespace power_grid_model::benchmark
@@ -7,6 +7,7 @@
 #include <power_grid_model/main_model.hpp>
 
 #include <algorithm>
+#include <numbers>
 #include <random>
 
 namespace power_grid_model::benchmark {
@@ -22,26 +23,53 @@ struct Option {
     double ratio_lv_grid;             // ratio when lv grid will be generated
     bool has_mv_ring;
     bool has_lv_ring;
+    // hv grid: the mv feeders are spread over hv substations, which can be connected by a meshed hv grid
+    // there is a single substation if n_mv_feeder_per_substation is zero
+    Idx n_mv_feeder_per_substation;
+    bool has_hv_ring;                   // connect the substations in a ring, otherwise they are separate grids
+    Idx hv_mesh_span;                   // each substation is also connected to the substation hv_mesh_span further
+    Idx n_substation_per_hv_source;     // a source at every n_substation_per_hv_source substations, one if zero
+    bool use_three_winding_transformer; // hv/mv transformers with a tertiary winding to a compensation shunt
+    Idx n_hv_substation;                // will be calculated
+};
+
+// measurement configuration for state estimation
+struct SensorOption {
+    double voltage_coverage;   // ratio of the nodes with a voltage sensor, the source and hv nodes always have one
+    double appliance_coverage; // ratio of the loads, sources and shunts with a power sensor
+    double branch_coverage;    // ratio of the lines and transformers with a power sensor at the from side (side 1)
+    double voltage_noise;      // relative standard deviation of the error of the voltage measurements
+    double power_noise;        // relative standard deviation of the error of the power measurements
 };
 
 struct InputData {
     std::vector<NodeInput> node;
     std::vector<TransformerInput> transformer;
+    std::vector<ThreeWindingTransformerInput> three_winding_transformer;
     std::vector<LineInput> line;
     std::vector<SourceInput> source;
     std::vector<SymLoadGenInput> sym_load;
     std::vector<AsymLoadGenInput> asym_load;
     std::vector<ShuntInput> shunt;
+    std::vector<SymVoltageSensorInput> sym_voltage_sensor;
+    std::vector<SymPowerSensorInput> sym_power_sensor;
+    std::vector<FaultInput> fault;
 
     ConstDataset get_dataset() const {
         ConstDataset dataset;
         dataset.try_emplace("node", node.data(), static_cast<Idx>(node.size()));
         dataset.try_emplace("transformer", transformer.data(), static_cast<Idx>(transformer.size()));
+        dataset.try_emplace("three_winding_transformer", three_winding_transformer.data(),
+                            static_cast<Idx>(three_winding_transformer.size()));
         dataset.try_emplace("line", line.data(), static_cast<Idx>(line.size()));
         dataset.try_emplace("source", source.data(), static_cast<Idx>(source.size()));
         dataset.try_emplace("sym_load", sym_load.data(), static_cast<Idx>(sym_load.size()));
         dataset.try_emplace("asym_load", asym_load.data(), static_cast<Idx>(asym_load.size()));
         dataset.try_emplace("shunt", shunt.data(), static_cast<Idx>(shunt.size()));
+        dataset.try_emplace("sym_voltage_sensor", sym_voltage_sensor.data(),
+                            static_cast<Idx>(sym_voltage_sensor.size()));
+        dataset.try_emplace("sym_power_sensor", sym_power_sensor.data(), static_cast<Idx>(sym_power_sensor.size()));
+        dataset.try_emplace("fault", fault.data(), static_cast<Idx>(fault.size()));
         return dataset;
     }
 };
@@ -49,6 +77,7 @@ struct InputData {
 template <bool sym> struct OutputData {
     std::vector<NodeOutput<sym>> node;
     std::vector<BranchOutput<sym>> transformer;
+    std::vector<Branch3Output<sym>> three_winding_transformer;
     std::vector<BranchOutput<sym>> line;
     std::vector<ApplianceOutput<sym>> source;
     std::vector<ApplianceOutput<sym>> sym_load;
@@ -61,6 +90,8 @@ template <bool sym> struct OutputData {
         dataset.try_emplace("node", node.data(), batch_size, static_cast<Idx>(node.size()) / batch_size);
         dataset.try_emplace("transformer", transformer.data(), batch_size,
                             static_cast<Idx>(transformer.size()) / batch_size);
+        dataset.try_emplace("three_winding_transformer", three_winding_transformer.data(), batch_size,
+                            static_cast<Idx>(three_winding_transformer.size()) / batch_size);
         dataset.try_emplace("line", line.data(), batch_size, static_cast<Idx>(line.size()) / batch_size);
         dataset.try_emplace("source", source.data(), batch_size, static_cast<Idx>(source.size()) / batch_size);
         dataset.try_emplace("sym_load", sym_load.data(), batch_size, static_cast<Idx>(sym_load.size()) / batch_size);
@@ -70,9 +101,37 @@ template <bool sym> struct OutputData {
     }
 };
 
+struct ShortCircuitOutputData {
+    std::vector<NodeShortCircuitOutput> node;
+    std::vector<BranchShortCircuitOutput> transformer;
+    std::vector<Branch3ShortCircuitOutput> three_winding_transformer;
+    std::vector<BranchShortCircuitOutput> line;
+    std::vector<ApplianceShortCircuitOutput> source;
+    std::vector<FaultShortCircuitOutput> fault;
+    Idx batch_size{1};
+
+    Dataset get_dataset() {
+        Dataset dataset;
+        dataset.try_emplace("node", node.data(), batch_size, static_cast<Idx>(node.size()) / batch_size);
+        dataset.try_emplace("transformer", transformer.data(), batch_size,
+                            static_cast<Idx>(transformer.size()) / batch_size);
+        dataset.try_emplace("three_winding_transformer", three_winding_transformer.data(), batch_size,
+                            static_cast<Idx>(three_winding_transformer.size()) / batch_size);
+        dataset.try_emplace("line", line.data(), batch_size, static_cast<Idx>(line.size()) / batch_size);
+        dataset.try_emplace("source", source.data(), batch_size, static_cast<Idx>(source.size()) / batch_size);
+        dataset.try_emplace("fault", fault.data(), batch_size, static_cast<Idx>(fault.size()) / batch_size);
+        return dataset;
+    }
+};
+
 struct BatchData {
     std::vector<SymLoadGenUpdate> sym_load;
     std::vector<AsymLoadGenUpdate> asym_load;
+    std::vector<SourceUpdate> source;
+    std::vector<BranchUpdate> line;
+    std::vector<BranchUpdate> transformer;
+    std::vector<Branch3Update> three_winding_transformer;
+    std::vector<FaultUpdate> fault;
     Idx batch_size{0};
 
     ConstDataset get_dataset() const {
@@ -82,6 +141,23 @@ struct BatchData {
         }
         dataset.try_emplace("sym_load", sym_load.data(), batch_size, static_cast<Idx>(sym_load.size()) / batch_size);
         dataset.try_emplace("asym_load", asym_load.data(), batch_size, static_cast<Idx>(asym_load.size()) / batch_size);
+        if (!source.empty()) {
+            dataset.try_emplace("source", source.data(), batch_size, static_cast<Idx>(source.size()) / batch_size);
+        }
+        if (!line.empty()) {
+            dataset.try_emplace("line", line.data(), batch_size, static_cast<Idx>(line.size()) / batch_size);
+        }
+        if (!transformer.empty()) {
+            dataset.try_emplace("transformer", transformer.data(), batch_size,
+                                static_cast<Idx>(transformer.size()) / batch_size);
+        }
+        if (!three_winding_transformer.empty()) {
+            dataset.try_emplace("three_winding_transformer", three_winding_transformer.data(), batch_size,
+                                static_cast<Idx>(three_winding_transformer.size()) / batch_size);
+        }
+        if (!fault.empty()) {
+            dataset.try_emplace("fault", fault.data(), batch_size, static_cast<Idx>(fault.size()) / batch_size);
+        }
         return dataset;
     }
 };
@@ -96,7 +172,6 @@ class FictionalGridGenerator {
         // initialization
         input_ = InputData{};
         mv_ring_.clear();
-        lv_ring_.clear();
         option_ = option;
         gen_ = std::mt19937_64{seed};
         id_gen_ = 0;
@@ -116,10 +191,24 @@ class FictionalGridGenerator {
         total_mv_connection = option_.n_mv_feeder * option_.n_node_per_mv_feeder;
         option_.ratio_lv_grid = static_cast<double>(option_.n_lv_grid) / static_cast<double>(total_mv_connection);
         // each mv feeder 10 MVA, each transformer 60 MVA, scaled up by 10%
+        Idx const n_feeder_per_substation = option_.n_mv_feeder_per_substation > 0
+                                                ? std::min(option_.n_mv_feeder_per_substation, option_.n_mv_feeder)
+                                                : option_.n_mv_feeder;
         option_.n_parallel_hv_mv_transformer =
-            static_cast<Idx>(static_cast<double>(option.n_mv_feeder) * 10.0 * 1.1 / 60.0) + 1;
+            static_cast<Idx>(static_cast<double>(n_feeder_per_substation) * 10.0 * 1.1 / 60.0) + 1;
         // start generating grid
-        generate_mv_grid();
+        if (option_.n_mv_feeder_per_substation > 0) {
+            generate_hv_grid();
+        } else {
+            option_.n_hv_substation = 1;
+            // source node
+            ID const id_source_node = id_gen_++;
+            NodeInput const source_node{{id_source_node}, 150.0e3};
+            input_.node.push_back(source_node);
+            SourceInput const source{{{id_gen_++}, id_source_node, 1}, 1.05, nan, 2000e6, nan, nan};
+            input_.source.push_back(source);
+            generate_mv_grid(id_source_node, option_.n_mv_feeder);
+        }
     }
 
     InputData const& input_data() const { return input_; }
@@ -130,6 +219,7 @@ class FictionalGridGenerator {
         output.batch_size = batch_size;
         output.node.resize(input_.node.size() * batch_size);
         output.transformer.resize(input_.transformer.size() * batch_size);
+        output.three_winding_transformer.resize(input_.three_winding_transformer.size() * batch_size);
         output.line.resize(input_.line.size() * batch_size);
         output.source.resize(input_.source.size() * batch_size);
         output.sym_load.resize(input_.sym_load.size() * batch_size);
@@ -138,6 +228,108 @@ class FictionalGridGenerator {
         return output;
     }
 
+    ShortCircuitOutputData generate_short_circuit_output_data(Idx batch_size = 1) const {
+        batch_size = std::max(batch_size, Idx{1});
+        ShortCircuitOutputData output{};
+        output.batch_size = batch_size;
+        output.node.resize(input_.node.size() * batch_size);
+        output.transformer.resize(input_.transformer.size() * batch_size);
+        output.three_winding_transformer.resize(input_.three_winding_transformer.size() * batch_size);
+        output.line.resize(input_.line.size() * batch_size);
+        output.source.resize(input_.source.size() * batch_size);
+        output.fault.resize(input_.fault.size() * batch_size);
+        return output;
+    }
+
+    // measurements for state estimation, derived from a (power flow) result of the grid as reference
+    // the source nodes and the hv substation nodes always have a voltage sensor
+    // the other nodes, the appliances and the branches are measured at random with the coverage of the option
+    // the measured values deviate from the reference with a normally distributed relative error
+    void generate_sensors(SensorOption const& option, OutputData<true> const& reference,
+                          std::random_device::result_type seed) {
+        gen_ = std::mt19937_64{seed};
+        input_.sym_voltage_sensor.clear();
+        input_.sym_power_sensor.clear();
+        std::bernoulli_distribution voltage_gen{option.voltage_coverage};
+        std::bernoulli_distribution appliance_gen{option.appliance_coverage};
+        std::bernoulli_distribution branch_gen{option.branch_coverage};
+        std::normal_distribution<double> error_gen{};
+
+        std::vector<ID> source_nodes(input_.source.size());
+        std::ranges::transform(input_.source, source_nodes.begin(), &SourceInput::node);
+        for (Idx i = 0; i != static_cast<Idx>(input_.node.size()); ++i) {
+            ID const node = input_.node[i].id;
+            bool const is_hv_node = input_.node[i].u_rated == 150.0e3;
+            if (!is_hv_node && std::ranges::find(source_nodes, node) == source_nodes.cend() && !voltage_gen(gen_)) {
+                continue;
+            }
+            double const u = reference.node[i].u;
+            double const u_sigma = std::max(option.voltage_noise, 1e-3) * u;
+            double const u_measured = u * (1.0 + option.voltage_noise * error_gen(gen_));
+            input_.sym_voltage_sensor.push_back({{{{id_gen_++}, node}, u_sigma}, u_measured, nan});
+        }
+
+        auto const add_power_sensor = [this, &option, &error_gen](ID measured_object,
+                                                                  MeasuredTerminalType terminal_type, double p,
+                                                                  double q) {
+            double const s = std::hypot(p, q);
+            double const power_sigma = std::max(option.power_noise * s, 1.0);
+            double const p_measured = p + option.power_noise * s * error_gen(gen_);
+            double const q_measured = q + option.power_noise * s * error_gen(gen_);
+            input_.sym_power_sensor.push_back(
+                {{{{id_gen_++}, measured_object}, terminal_type, power_sigma}, p_measured, q_measured});
+        };
+        auto const add_power_sensors = [this, &add_power_sensor](auto const& components, auto const& outputs,
+                                                                 MeasuredTerminalType terminal_type,
+                                                                 std::bernoulli_distribution& coverage_gen) {
+            for (Idx i = 0; i != static_cast<Idx>(components.size()); ++i) {
+                if (!coverage_gen(gen_)) {
+                    continue;
+                }
+                if constexpr (requires { outputs[i].p_from; }) {
+                    add_power_sensor(components[i].id, terminal_type, outputs[i].p_from, outputs[i].q_from);
+                } else if constexpr (requires { outputs[i].p_1; }) {
+                    add_power_sensor(components[i].id, terminal_type, outputs[i].p_1, outputs[i].q_1);
+                } else {
+                    add_power_sensor(components[i].id, terminal_type, outputs[i].p, outputs[i].q);
+                }
+            }
+        };
+        add_power_sensors(input_.sym_load, reference.sym_load, MeasuredTerminalType::load, appliance_gen);
+        add_power_sensors(input_.asym_load, reference.asym_load, MeasuredTerminalType::load, appliance_gen);
+        add_power_sensors(input_.source, reference.source, MeasuredTerminalType::source, appliance_gen);
+        add_power_sensors(input_.line, reference.line, MeasuredTerminalType::branch_from, branch_gen);
+        add_power_sensors(input_.transformer, reference.transformer, MeasuredTerminalType::branch_from, branch_gen);
+        add_power_sensors(input_.three_winding_transformer, reference.three_winding_transformer,
+                          MeasuredTerminalType::branch3_1, branch_gen);
+        add_power_sensors(input_.shunt, reference.shunt, MeasuredTerminalType::shunt, appliance_gen);
+    }
+
+    // one bolted fault at the far end of the first mv feeder
+    void generate_fault(FaultType fault_type) {
+        input_.fault.clear();
+        input_.fault.push_back(
+            {{id_gen_++}, 1, fault_type, FaultPhase::default_value, mv_fault_nodes().front(), 0.0, 0.0});
+    }
+
+    // batch which moves the fault of generate_fault() over the mv nodes, one node per scenario
+    // the scenarios are empty if there is no fault or no mv node
+    BatchData generate_fault_sweep_batch_input(Idx batch_size) const {
+        std::vector<ID> const fault_nodes = mv_fault_nodes();
+        BatchData batch_data{};
+        batch_data.batch_size = std::max(batch_size, Idx{0});
+        if (input_.fault.empty() || fault_nodes.empty()) {
+            return batch_data;
+        }
+        batch_data.fault.resize(batch_data.batch_size);
+        ID const fault_id = input_.fault.front().id;
+        for (Idx batch = 0; batch != batch_data.batch_size; ++batch) {
+            ID const fault_node = fault_nodes[batch % static_cast<Idx>(fault_nodes.size())];
+            batch_data.fault[batch] = {{fault_id}, na_IntS, FaultType::nan, FaultPhase::nan, fault_node, nan, nan};
+        }
+        return batch_data;
+    }
+
     BatchData generate_batch_input(Idx batch_size) { return generate_batch_input(batch_size, std::random_device{}()); }
 
     BatchData generate_batch_input(Idx batch_size, std::random_device::result_type seed) {
@@ -150,54 +342,205 @@ class FictionalGridGenerator {
         return batch_data;
     }
 
+    // time series batch, every scenario is a time step of a day with n_step_per_day steps
+    // the loads follow a daily profile, with a random deviation per load and time step
+    BatchData generate_time_series_batch_input(Idx batch_size, Idx n_step_per_day,
+                                               std::random_device::result_type seed) {
+        batch_size = std::max(batch_size, Idx{0});
+        gen_ = std::mt19937_64{seed};
+        BatchData batch_data{};
+        batch_data.batch_size = batch_size;
+        // lowest load at midnight (20% of the specified load), highest at noon (100%)
+        std::vector<double> profile(batch_size);
+        for (Idx batch = 0; batch != batch_size; ++batch) {
+            double const time_of_day =
+                static_cast<double>(batch % n_step_per_day) / static_cast<double>(n_step_per_day);
+            profile[batch] = 0.6 - 0.4 * std::cos(2.0 * std::numbers::pi * time_of_day);
+        }
+        generate_profile_series(input_.sym_load, batch_data.sym_load, profile);
+        generate_profile_series(input_.asym_load, batch_data.asym_load, profile);
+        return batch_data;
+    }
+
+    // batch with very uneven cost per scenario
+    // the source is disconnected in the first part of the scenarios (ratio_islanded)
+    // these scenarios are islanded and therefore much cheaper to calculate than the others
+    BatchData generate_unbalanced_batch_input(Idx batch_size, std::random_device::result_type seed,
+                                              double ratio_islanded) {
+        BatchData batch_data = generate_batch_input(batch_size, seed);
+        auto const n_islanded = static_cast<Idx>(static_cast<double>(batch_data.batch_size) * ratio_islanded);
+        batch_data.source.resize(input_.source.size() * batch_data.batch_size);
+        auto const n_object = static_cast<Idx>(input_.source.size());
+        for (Idx batch = 0; batch < batch_data.batch_size; ++batch) {
+            for (Idx object = 0; object < n_object; ++object) {
+                SourceUpdate& update_obj = batch_data.source[batch * n_object + object];
+                update_obj.id = input_.source[object].id;
+                update_obj.status = batch < n_islanded ? 0 : na_IntS;
+                update_obj.u_ref = nan;
+                update_obj.u_ref_angle = nan;
+            }
+        }
+        return batch_data;
+    }
+
+    // batch in which the order of the loads differs per scenario
+    // the IDs are not the same for all scenarios, the update cannot use cached sequence indices
+    BatchData generate_dependent_batch_input(Idx batch_size, std::random_device::result_type seed) {
+        BatchData batch_data = generate_batch_input(batch_size, seed);
+        shuffle_per_batch(batch_data.sym_load, batch_data.batch_size);
+        shuffle_per_batch(batch_data.asym_load, batch_data.batch_size);
+        return batch_data;
+    }
+
+    // N-1 contingency batch, every scenario opens one line
+    BatchData generate_n_minus_1_batch_input() const {
+        BatchData batch_data{};
+        batch_data.batch_size = static_cast<Idx>(input_.line.size());
+        batch_data.line.resize(input_.line.size());
+        std::transform(input_.line.cbegin(), input_.line.cend(), batch_data.line.begin(),
+                       [](LineInput const& line) { return BranchUpdate{{line.id}, 0, 0}; });
+        return batch_data;
+    }
+
+    // contingency batch, every scenario opens one random line, transformer or three winding transformer
+    // every scenario has one update per branch type, the updates of the other branch types do not change anything
+    // the scenarios are empty if there is no branch
+    BatchData generate_contingency_batch_input(Idx batch_size, std::random_device::result_type seed) {
+        batch_size = std::max(batch_size, Idx{0});
+        gen_ = std::mt19937_64{seed};
+        BatchData batch_data{};
+        batch_data.batch_size = batch_size;
+        auto const n_line = static_cast<Idx>(input_.line.size());
+        auto const n_transformer = static_cast<Idx>(input_.transformer.size());
+        auto const n_three_winding_transformer = static_cast<Idx>(input_.three_winding_transformer.size());
+        Idx const n_branch = n_line + n_transformer + n_three_winding_transformer;
+        if (n_branch == 0) {
+            return batch_data;
+        }
+        std::uniform_int_distribution<Idx> branch_gen{0, n_branch - 1};
+        for (Idx batch = 0; batch != batch_size; ++batch) {
+            Idx const branch = branch_gen(gen_);
+            if (n_line > 0) {
+                bool const open = branch < n_line;
+                batch_data.line.push_back(open ? BranchUpdate{{input_.line[branch].id}, 0, 0}
+                                               : BranchUpdate{{input_.line.front().id}, na_IntS, na_IntS});
+            }
+            if (n_transformer > 0) {
+                bool const open = branch >= n_line && branch < n_line + n_transformer;
+                batch_data.transformer.push_back(open
+                                                     ? BranchUpdate{{input_.transformer[branch - n_line].id}, 0, 0}
+                                                     : BranchUpdate{{input_.transformer.front().id}, na_IntS, na_IntS});
+            }
+            if (n_three_winding_transformer > 0) {
+                bool const open = branch >= n_line + n_transformer;
+                batch_data.three_winding_transformer.push_back(
+                    open ? Branch3Update{{input_.three_winding_transformer[branch - n_line - n_transformer].id}, 0, 0, 0}
+                         : Branch3Update{{input_.three_winding_transformer.front().id}, na_IntS, na_IntS, na_IntS});
+            }
+        }
+        return batch_data;
+    }
+
   private:
     Option option_{};
     std::mt19937_64 gen_;
     ID id_gen_;
     InputData input_;
-    std::vector<ID> mv_ring_;
-    std::vector<ID> lv_ring_;
+    std::vector<ID> mv_ring_; // far end nodes of all mv feeders
+
+    // hv substations, optionally in a ring with extra lines to the substation hv_mesh_span further
+    // every substation supplies n_mv_feeder_per_substation mv feeders
+    void generate_hv_grid() {
+        option_.n_hv_substation =
+            (option_.n_mv_feeder + option_.n_mv_feeder_per_substation - 1) / option_.n_mv_feeder_per_substation;
+        Idx const n_substation = option_.n_hv_substation;
+        Idx const n_substation_per_source =
+            option_.n_substation_per_hv_source > 0 ? option_.n_substation_per_hv_source : n_substation;
+
+        // substation nodes and sources
+        std::vector<ID> hv_nodes;
+        for (Idx i = 0; i != n_substation; ++i) {
+            ID const id_hv_node = id_gen_++;
+            NodeInput const hv_node{{id_hv_node}, 150.0e3};
+            input_.node.push_back(hv_node);
+            hv_nodes.push_back(id_hv_node);
+        }
+        for (Idx i = 0; i < n_substation; i += n_substation_per_source) {
+            SourceInput const source{{{id_gen_++}, hv_nodes[i], 1}, 1.05, nan, 2000e6, nan, nan};
+            input_.source.push_back(source);
+        }
+
+        // overhead line 150kV, per km
+        LineInput const hv_line{{{0}, 0, 0, 1, 1}, 0.06, 0.4, 9e-9, 0.0, 0.2, 1.2, 5e-9, 0.0, 1e3};
+        // length 10 km - 30 km
+        std::uniform_real_distribution<double> length_gen{10.0, 30.0};
+        auto const add_hv_line = [this, &hv_line, &hv_nodes, &length_gen](Idx from, Idx to) {
+            LineInput line = hv_line;
+            line.id = id_gen_++;
+            line.from_node = hv_nodes[from];
+            line.to_node = hv_nodes[to];
+            scale_cable(line, length_gen(gen_));
+            input_.line.push_back(line);
+        };
+        // ring, a single line between two substations
+        if (option_.has_hv_ring && n_substation > 1) {
+            for (Idx i = 0; i != (n_substation == 2 ? 1 : n_substation); ++i) {
+                add_hv_line(i, (i + 1) % n_substation);
+            }
+        }
+        // mesh, without the lines which are already in the ring
+        if (option_.has_hv_ring && option_.hv_mesh_span > 1 && option_.hv_mesh_span < n_substation - 1) {
+            for (Idx i = 0; i + option_.hv_mesh_span < n_substation; ++i) {
+                add_hv_line(i, i + option_.hv_mesh_span);
+            }
+        }
 
-    void generate_mv_grid() {
-        // source node
-        ID const id_source_node = id_gen_++;
-        NodeInput const source_node{{id_source_node}, 150.0e3};
-        input_.node.push_back(source_node);
-        SourceInput const source{{{id_gen_++}, id_source_node, 1}, 1.05, nan, 2000e6, nan, nan};
-        input_.source.push_back(source);
+        // mv grids
+        Idx n_remaining_feeder = option_.n_mv_feeder;
+        for (ID const hv_node : hv_nodes) {
+            Idx const n_feeder = std::min(option_.n_mv_feeder_per_substation, n_remaining_feeder);
+            generate_mv_grid(hv_node, n_feeder);
+            n_remaining_feeder -= n_feeder;
+        }
+    }
 
+    void generate_mv_grid(ID hv_node, Idx n_feeder) {
         // transformer and mv busbar
         ID const id_mv_busbar = id_gen_++;
         NodeInput const mv_busbar{{id_mv_busbar}, 10.5e3};
         input_.node.push_back(mv_busbar);
         for (Idx i = 0; i != option_.n_parallel_hv_mv_transformer; ++i) {
-            // transformer, 150/10.5kV, 60MVA, uk=20.3%
-            TransformerInput const transformer{{{id_gen_++}, id_source_node, id_mv_busbar, 1, 1},
-                                               150.0e3,
-                                               10.5e3,
-                                               60.0e6,
-                                               0.203,
-                                               200e3,
-                                               0.01,
-                                               40e3,
-                                               WindingType::wye_n,
-                                               WindingType::delta,
-                                               5,
-                                               BranchSide::from,
-                                               0,
-                                               -10,
-                                               10,
-                                               0,
-                                               2.5e3,
-                                               nan,
-                                               nan,
-                                               nan,
-                                               nan,
-                                               nan,
-                                               nan,
-                                               nan,
-                                               nan};
-            input_.transformer.push_back(transformer);
+            if (option_.use_three_winding_transformer) {
+                generate_three_winding_transformer(hv_node, id_mv_busbar);
+            } else {
+                // transformer, 150/10.5kV, 60MVA, uk=20.3%
+                TransformerInput const transformer{{{id_gen_++}, hv_node, id_mv_busbar, 1, 1},
+                                                   150.0e3,
+                                                   10.5e3,
+                                                   60.0e6,
+                                                   0.203,
+                                                   200e3,
+                                                   0.01,
+                                                   40e3,
+                                                   WindingType::wye_n,
+                                                   WindingType::delta,
+                                                   5,
+                                                   BranchSide::from,
+                                                   0,
+                                                   -10,
+                                                   10,
+                                                   0,
+                                                   2.5e3,
+                                                   nan,
+                                                   nan,
+                                                   nan,
+                                                   nan,
+                                                   nan,
+                                                   nan,
+                                                   nan,
+                                                   nan};
+                input_.transformer.push_back(transformer);
+            }
             // shunt, Z0 = 0 + j7 ohm
             ShuntInput const shunt{{{id_gen_++}, id_mv_busbar, 1}, 0.0, 0.0, 0.0, -1.0 / 7.0};
             input_.shunt.push_back(shunt);
@@ -220,7 +563,8 @@ class FictionalGridGenerator {
         std::bernoulli_distribution lv_gen{option_.ratio_lv_grid};
 
         // loop all feeder
-        for (Idx i = 0; i < option_.n_mv_feeder; i++) {
+        std::vector<ID> mv_ring;
+        for (Idx i = 0; i < n_feeder; i++) {
             ID prev_node_id = id_mv_busbar;
             // loop all mv connection
             for (Idx j = 0; j < option_.n_node_per_mv_feeder; ++j) {
@@ -253,7 +597,7 @@ class FictionalGridGenerator {
 
                 // push to ring node
                 if (j == option_.n_node_per_mv_feeder - 1) {
-                    mv_ring_.push_back(current_node_id);
+                    mv_ring.push_back(current_node_id);
                 }
                 // iterate previous node
                 prev_node_id = current_node_id;
@@ -261,10 +605,11 @@ class FictionalGridGenerator {
         }
 
         // add loop if needed, and there are more than one feeder, and there are ring nodes
-        if (mv_ring_.size() > 1 && option_.has_mv_ring) {
-            mv_ring_.push_back(mv_ring_.front());
+        mv_ring_.insert(mv_ring_.end(), mv_ring.cbegin(), mv_ring.cend());
+        if (mv_ring.size() > 1 && option_.has_mv_ring) {
+            mv_ring.push_back(mv_ring.front());
             // loop all far end nodes
-            for (auto it = mv_ring_.cbegin(); it != mv_ring_.cend() - 1; ++it) {
+            for (auto it = mv_ring.cbegin(); it != mv_ring.cend() - 1; ++it) {
                 // line
                 LineInput line = mv_line;
                 line.id = id_gen_++;
@@ -337,6 +682,7 @@ class FictionalGridGenerator {
         std::uniform_real_distribution<double> connection_cable_gen{5e-3, 20e-3};
 
         // loop feeders
+        std::vector<ID> lv_ring;
         for (Idx i = 0; i < option_.n_lv_feeder; ++i) {
             ID prev_main_node_id = id_lv_busbar;
             // loop all LV connection
@@ -378,7 +724,7 @@ class FictionalGridGenerator {
 
                 // push to ring node
                 if (j == option_.n_connection_per_lv_feeder - 1) {
-                    lv_ring_.push_back(current_main_node_id);
+                    lv_ring.push_back(current_main_node_id);
                 }
                 // iterate previous node
                 prev_main_node_id = current_main_node_id;
@@ -386,10 +732,10 @@ class FictionalGridGenerator {
         }
 
         // add loop if needed, and there are more than one feeder, and there are ring nodes
-        if (lv_ring_.size() > 1 && option_.has_lv_ring) {
-            lv_ring_.push_back(lv_ring_.front());
+        if (lv_ring.size() > 1 && option_.has_lv_ring) {
+            lv_ring.push_back(lv_ring.front());
             // loop all far end nodes
-            for (auto it = lv_ring_.cbegin(); it != lv_ring_.cend() - 1; ++it) {
+            for (auto it = lv_ring.cbegin(); it != lv_ring.cend() - 1; ++it) {
                 // line
                 LineInput line = lv_main_line;
                 line.id = id_gen_++;
@@ -402,6 +748,76 @@ class FictionalGridGenerator {
         }
     }
 
+    // transformer, 150/10.5/20kV, 60/60/20MVA, with a compensation shunt of 5 Mvar at the tertiary winding
+    void generate_three_winding_transformer(ID hv_node, ID mv_busbar) {
+        ID const id_tertiary_node = id_gen_++;
+        NodeInput const tertiary_node{{id_tertiary_node}, 20.0e3};
+        input_.node.push_back(tertiary_node);
+        ThreeWindingTransformerInput const transformer{{{id_gen_++}, hv_node, mv_busbar, id_tertiary_node, 1, 1, 1},
+                                                       150.0e3,
+                                                       10.5e3,
+                                                       20.0e3,
+                                                       60.0e6,
+                                                       60.0e6,
+                                                       20.0e6,
+                                                       0.203,
+                                                       0.12,
+                                                       0.08,
+                                                       200e3,
+                                                       80e3,
+                                                       60e3,
+                                                       0.01,
+                                                       40e3,
+                                                       WindingType::wye_n,
+                                                       WindingType::delta,
+                                                       WindingType::delta,
+                                                       5,
+                                                       5,
+                                                       Branch3Side::side_1,
+                                                       0,
+                                                       -10,
+                                                       10,
+                                                       0,
+                                                       2.5e3,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan,
+                                                       nan};
+        input_.three_winding_transformer.push_back(transformer);
+        // reactor, grounded for the zero sequence of the tertiary node behind the delta winding
+        double const b_reactor = -5e6 / (20.0e3 * 20.0e3);
+        ShuntInput const shunt{{{id_gen_++}, id_tertiary_node, 1}, 0.0, b_reactor, 0.0, b_reactor};
+        input_.shunt.push_back(shunt);
+    }
+
+    // the mv nodes, starting from the far end of the first feeder
+    std::vector<ID> mv_fault_nodes() const {
+        std::vector<ID> nodes;
+        for (NodeInput const& node : input_.node) {
+            if (node.u_rated == 10.5e3) {
+                nodes.push_back(node.id);
+            }
+        }
+        if (!mv_ring_.empty()) {
+            std::ranges::rotate(nodes, std::ranges::find(nodes, mv_ring_.front()));
+        }
+        return nodes;
+    }
+
     static void scale_cable(LineInput& line, double cable_ratio) {
         line.r1 *= cable_ratio;
         line.x1 *= cable_ratio;
@@ -422,11 +838,41 @@ class FictionalGridGenerator {
                 U& update_obj = load_series[batch * n_object + object];
                 update_obj.id = input_obj.id;
                 update_obj.status = na_IntS;
-                update_obj.p_specified *= load_scaling_gen(gen_);
-                update_obj.q_specified *= load_scaling_gen(gen_);
+                update_obj.p_specified = input_obj.p_specified * load_scaling_gen(gen_);
+                update_obj.q_specified = input_obj.q_specified * load_scaling_gen(gen_);
+            }
+        }
+    }
+
+    template <class T, class U>
+    void generate_profile_series(std::vector<T> const& input, std::vector<U>& load_series,
+                                 std::vector<double> const& profile) {
+        std::uniform_real_distribution<double> deviation_gen{0.8, 1.2};
+        auto const n_object = static_cast<Idx>(input.size());
+        load_series.resize(input.size() * profile.size());
+        for (Idx batch = 0; batch != static_cast<Idx>(profile.size()); ++batch) {
+            for (Idx object = 0; object != n_object; ++object) {
+                T const& input_obj = input[object];
+                U& update_obj = load_series[batch * n_object + object];
+                double const scaling = profile[batch] * deviation_gen(gen_);
+                update_obj.id = input_obj.id;
+                update_obj.status = na_IntS;
+                update_obj.p_specified = input_obj.p_specified * scaling;
+                update_obj.q_specified = input_obj.q_specified * scaling;
             }
         }
     }
+
+    template <class U> void shuffle_per_batch(std::vector<U>& batch_series, Idx batch_size) {
+        if (batch_size == 0) {
+            return;
+        }
+        auto const n_object = static_cast<ptrdiff_t>(batch_series.size()) / batch_size;
+        for (ptrdiff_t batch = 0; batch < batch_size; ++batch) {
+            auto const begin = batch_series.begin() + batch * n_object;
+            std::shuffle(begin, begin + n_object, gen_);
+        }
+    }
 };
 
 } // namespace power_grid_model::benchmark
@@ -11,6 +11,10 @@
 
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+
 #include <power_grid_model_c/dataset_definitions.h>
 
 /*
@@ -175,6 +179,55 @@ TEST_CASE("C API Model") {
         CHECK(u[2] == doctest::Approx(70.0));
     }
 
+    SUBCASE("Batch power flow statistics and calculation info") {
+        std::array<Idx, 2> n_iterations{-1, -1};
+        std::array<double, 2> max_deviation{-1.0, -1.0};
+        std::array<double, 2> wall_time{-1.0, -1.0};
+        PGM_set_scenario_statistics(hl, opt, n_iterations.data(), max_deviation.data(), wall_time.data());
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        PGM_calculate(hl, model, opt, batch_output_dataset, batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        for (Idx scenario = 0; scenario != 2; ++scenario) {
+            CHECK(n_iterations[scenario] > 0);
+            CHECK(max_deviation[scenario] >= 0.0);
+            CHECK(max_deviation[scenario] < 1e-8);
+            CHECK(wall_time[scenario] >= 0.0);
+        }
+
+        Idx const n_info = PGM_get_calculation_info(hl, model);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        REQUIRE(n_info > 0);
+        char const** const keys = PGM_calculation_info_keys(hl, model);
+        double const* const values = PGM_calculation_info_values(hl, model);
+        bool found_iterations = false;
+        for (Idx i = 0; i != n_info; ++i) {
+            if (std::string_view{keys[i]}.find("Max number of iterations") != std::string_view::npos) {
+                found_iterations = true;
+                CHECK(values[i] == static_cast<double>(std::max(n_iterations[0], n_iterations[1])));
+            }
+        }
+        CHECK(found_iterations);
+    }
+
+    SUBCASE("Batch power flow trace") {
+        PGM_set_tracing(hl, opt, 1);
+        PGM_set_threading(hl, opt, 2);
+        PGM_calculate(hl, model, opt, batch_output_dataset, batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        std::string const trace = PGM_get_trace(hl, model);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        CHECK(trace.starts_with("{\"traceEvents\":["));
+        CHECK(trace.find("\"name\":\"Update model\"") != std::string::npos);
+        CHECK(trace.find("\"args\":{\"code\":1200,\"scenario\":0}") != std::string::npos);
+        CHECK(trace.find("\"args\":{\"code\":1200,\"scenario\":1}") != std::string::npos);
+
+        // without tracing, the trace is empty
+        PGM_set_tracing(hl, opt, 0);
+        PGM_calculate(hl, model, opt, batch_output_dataset, batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_no_error);
+        CHECK(std::string{PGM_get_trace(hl, model)}.find("\"name\"") == std::string::npos);
+    }
+
     SUBCASE("Construction error") {
         load_input.id = 0;
         ModelPtr const wrong_model{PGM_create_model(hl, 50.0, input_dataset)};
@@ -211,6 +264,32 @@ TEST_CASE("C API Model") {
         CHECK(err_msg.find("The calculation method is invalid for this calculation!") != std::string::npos);
     }
 
+    SUBCASE("Paired short circuit dataset error") {
+        PGM_set_calculation_type(hl, opt, PGM_short_circuit);
+        PGM_set_calculation_method(hl, opt, PGM_iec60909);
+        std::array<NodeShortCircuitOutput, 2> sc_node_outputs{};
+        std::array<NodeShortCircuitOutput, 2> paired_sc_node_outputs{};
+        MutableDatasetPtr const unique_sc_output_dataset{PGM_create_dataset_mutable(hl, "sc_output", true, 2)};
+        PGM_MutableDataset* sc_output_dataset = unique_sc_output_dataset.get();
+        PGM_dataset_mutable_add_buffer(hl, sc_output_dataset, "node", 1, 2, nullptr, sc_node_outputs.data());
+        // different batch size
+        MutableDatasetPtr const unique_paired_dataset_1{PGM_create_dataset_mutable(hl, "sc_output", true, 1)};
+        PGM_dataset_mutable_add_buffer(hl, unique_paired_dataset_1.get(), "node", 1, 1, nullptr,
+                                       paired_sc_node_outputs.data());
+        PGM_calculate_short_circuit_paired(hl, model, opt, sc_output_dataset, unique_paired_dataset_1.get(),
+                                           batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_regular_error);
+        std::string err_msg{PGM_error_message(hl)};
+        CHECK(err_msg.find("should have the same batch size and components") != std::string::npos);
+        // different components
+        MutableDatasetPtr const unique_paired_dataset_2{PGM_create_dataset_mutable(hl, "sc_output", true, 2)};
+        PGM_calculate_short_circuit_paired(hl, model, opt, sc_output_dataset, unique_paired_dataset_2.get(),
+                                           batch_update_dataset);
+        CHECK(PGM_error_code(hl) == PGM_regular_error);
+        err_msg = PGM_error_message(hl);
+        CHECK(err_msg.find("should have the same batch size and components") != std::string::npos);
+    }
+
     SUBCASE("Batch calculation error") {
         // wrong id
         load_updates[1].id = 5;
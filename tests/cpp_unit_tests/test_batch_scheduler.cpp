@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/batch_scheduler.hpp>
+
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+namespace power_grid_model {
+
+namespace {
+// run all tasks and count how many times each task is handed out
+std::vector<Idx> run_and_count(BatchScheduler& scheduler, Idx n_thread, Idx n_task) {
+    std::vector<std::atomic<Idx>> counter(n_task);
+    scheduler.run(n_thread, n_task, [&counter](BatchScheduler::TaskSource& task_source) {
+        for (Idx task = task_source.next(); task != -1; task = task_source.next()) {
+            // make some tasks more expensive than others to trigger stealing
+            if (task % 7 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds{200});
+            }
+            ++counter[task];
+        }
+    });
+    std::vector<Idx> result(n_task);
+    std::transform(counter.cbegin(), counter.cend(), result.begin(), [](auto const& x) { return x.load(); });
+    return result;
+}
+} // namespace
+
+TEST_CASE("Test batch scheduler") {
+    BatchScheduler scheduler;
+
+    SUBCASE("Sequential") {
+        std::vector<Idx> order;
+        scheduler.run(1, 5, [&order](BatchScheduler::TaskSource& task_source) {
+            CHECK(task_source.worker() == 0);
+            for (Idx task = task_source.next(); task != -1; task = task_source.next()) {
+                order.push_back(task);
+            }
+        });
+        CHECK(order == std::vector<Idx>{0, 1, 2, 3, 4});
+        CHECK(scheduler.n_threads() == 1);
+    }
+
+    SUBCASE("Parallel, all tasks are executed exactly once") {
+        for (Idx const n_thread : {2, 3, 8}) {
+            auto const counter = run_and_count(scheduler, n_thread, 100);
+            CHECK(std::all_of(counter.cbegin(), counter.cend(), [](Idx x) { return x == 1; }));
+        }
+        // threads are kept alive between calls
+        CHECK(scheduler.n_threads() == 8);
+        // less tasks than threads
+        auto const counter = run_and_count(scheduler, 8, 3);
+        CHECK(counter == std::vector<Idx>{1, 1, 1});
+    }
+
+    SUBCASE("Contiguous partitioning, each worker calculates its own block in order") {
+        constexpr Idx n_thread = 3;
+        constexpr Idx n_task = 20;
+        std::vector<std::vector<Idx>> tasks_per_worker(n_thread);
+        scheduler.run(
+            n_thread, n_task,
+            [&tasks_per_worker](BatchScheduler::TaskSource& task_source) {
+                for (Idx task = task_source.next(); task != -1; task = task_source.next()) {
+                    // an expensive block would be stolen from with work stealing
+                    if (task_source.worker() == 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds{500});
+                    }
+                    tasks_per_worker[task_source.worker()].push_back(task);
+                }
+            },
+            BatchPartitioning::contiguous);
+        for (Idx worker = 0; worker != n_thread; ++worker) {
+            std::vector<Idx> expected(n_task * (worker + 1) / n_thread - n_task * worker / n_thread);
+            std::iota(expected.begin(), expected.end(), n_task * worker / n_thread);
+            CHECK(tasks_per_worker[worker] == expected);
+        }
+    }
+
+    SUBCASE("Copy does not share threads") {
+        run_and_count(scheduler, 4, 10);
+        BatchScheduler const copied{scheduler};
+        CHECK(scheduler.n_threads() == 4);
+        CHECK(copied.n_threads() == 1);
+    }
+
+    SUBCASE("Exception is propagated to calling thread") {
+        CHECK_THROWS_AS(scheduler.run(4, 10,
+                                      [](BatchScheduler::TaskSource& task_source) {
+                                          if (task_source.worker() == 2) {
+                                              throw std::runtime_error{"worker failed"};
+                                          }
+                                          while (task_source.next() != -1) {
+                                          }
+                                      }),
+                        std::runtime_error);
+        // scheduler is still usable
+        auto const counter = run_and_count(scheduler, 4, 10);
+        CHECK(std::all_of(counter.cbegin(), counter.cend(), [](Idx x) { return x == 1; }));
+    }
+}
+
+} // namespace power_grid_model
@@ -106,6 +106,13 @@ TEST_CASE("Test component container") {
         CHECK_THROWS_AS(container.get_item<C>(8), IDNotFound);
     }
 
+    SUBCASE("Test find idx_2d by id") {
+        CHECK(const_container.find_idx_by_id<C>(2) == Idx2D{1, 0});
+        CHECK(const_container.find_idx_by_id(22) == Idx2D{1, 1});
+        CHECK(const_container.find_idx_by_id<C2>(2) == Idx2D{-1, -1});
+        CHECK(const_container.find_idx_by_id<C>(8) == Idx2D{-1, -1});
+    }
+
     SUBCASE("Test size of a component class collection") {
         CHECK(const_container.size<C>() == 6);
         CHECK(const_container.size<C1>() == 2);
@@ -226,6 +233,38 @@ TEST_CASE("Test component container") {
             CHECK(container.get_item<C>(id).a == other_value_a);
         }
     }
+
+    SUBCASE("Test copy on write") {
+        CompContainer container_copy{container};
+        auto const& const_container_copy = container_copy;
+
+        // storage is shared after copy
+        CHECK(&const_container_copy.get_item<C>(1) == &const_container.get_item<C>(1));
+        CHECK(&const_container_copy.get_item<C1>(2) == &const_container.get_item<C1>(2));
+
+        // modification only copies the storage of the modified type
+        container_copy.get_item<C1>(2).a = 8;
+        CHECK(const_container_copy.get_item<C1>(2).a == 8);
+        CHECK(const_container.get_item<C1>(2).a == 6);
+        CHECK(&const_container_copy.get_item<C1>(2) != &const_container.get_item<C1>(2));
+        CHECK(&const_container_copy.get_item<C>(1) == &const_container.get_item<C>(1));
+        CHECK(&const_container_copy.get_item<C2>(3) == &const_container.get_item<C2>(3));
+
+        // cache and restore in the copy does not affect the original
+        container_copy.cache_item<C>(0);
+        container_copy.get_item<C>(1).a = 9;
+        CHECK(const_container.get_item<C>(1).a == 5);
+        container_copy.restore_values();
+        CHECK(const_container_copy.get_item<C>(1).a == 5);
+        CHECK(const_container.get_item<C>(1).a == 5);
+
+        // the original can be modified in place after the copy is gone
+        C const* const original_address = &const_container.get_item<C2>(3);
+        container_copy = CompContainer{};
+        container.get_item<C2>(3).a = 10;
+        CHECK(&const_container.get_item<C2>(3) == original_address);
+        CHECK(const_container.get_item<C2>(3).a == 10);
+    }
 }
 
 } // namespace power_grid_model
\ No newline at end of file
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/id_index.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model {
+
+TEST_CASE("Test ID index") {
+    IdIndex index;
+    CHECK(index.size() == 0);
+    CHECK(!index.contains(1));
+    CHECK(index.find(1) == nullptr);
+
+    SUBCASE("Hash mode") {
+        // large spread and negative IDs
+        std::vector<ID> const ids{-5, 1000000, 3, na_IntID, std::numeric_limits<ID>::max(), 7};
+        for (Idx i = 0; i != static_cast<Idx>(ids.size()); ++i) {
+            index.insert(ids[i], Idx2D{i % 2, i});
+        }
+        index.compact();
+        CHECK(!index.is_dense());
+        CHECK(index.size() == 6);
+        for (Idx i = 0; i != static_cast<Idx>(ids.size()); ++i) {
+            REQUIRE(index.contains(ids[i]));
+            CHECK(*index.find(ids[i]) == Idx2D{i % 2, i});
+        }
+        CHECK(!index.contains(4));
+        CHECK(!index.contains(0));
+
+        // overwrite
+        index.insert(3, Idx2D{5, 5});
+        CHECK(index.size() == 6);
+        CHECK(*index.find(3) == Idx2D{5, 5});
+    }
+
+    SUBCASE("Many IDs with rehash") {
+        for (ID id = 0; id != 10000; ++id) {
+            index.insert(id * 7, Idx2D{0, id});
+        }
+        CHECK(index.size() == 10000);
+        for (ID id = 0; id != 10000; ++id) {
+            CHECK(index.find(id * 7)->pos == id);
+            CHECK(!index.contains(id * 7 + 1));
+        }
+    }
+
+    SUBCASE("Dense mode") {
+        for (ID id = 10; id != 20; ++id) {
+            index.insert(id, Idx2D{0, id - 10});
+        }
+        // gap in the IDs is allowed
+        index.insert(25, Idx2D{1, 0});
+        index.compact();
+        CHECK(index.is_dense());
+        CHECK(index.size() == 11);
+        for (ID id = 10; id != 20; ++id) {
+            CHECK(*index.find(id) == Idx2D{0, id - 10});
+        }
+        CHECK(*index.find(25) == Idx2D{1, 0});
+        CHECK(!index.contains(9));
+        CHECK(!index.contains(22));
+        CHECK(!index.contains(26));
+
+        SUBCASE("Insert inside the dense range") {
+            index.insert(22, Idx2D{1, 1});
+            CHECK(index.is_dense());
+            CHECK(index.size() == 12);
+            CHECK(*index.find(22) == Idx2D{1, 1});
+        }
+
+        SUBCASE("Insert outside the dense range") {
+            index.insert(1000, Idx2D{1, 1});
+            CHECK(!index.is_dense());
+            CHECK(index.size() == 12);
+            CHECK(*index.find(1000) == Idx2D{1, 1});
+            CHECK(*index.find(25) == Idx2D{1, 0});
+            for (ID id = 10; id != 20; ++id) {
+                CHECK(*index.find(id) == Idx2D{0, id - 10});
+            }
+        }
+    }
+}
+
+} // namespace power_grid_model
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/instrumentation.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model {
+
+TEST_CASE("Test instrumentation counters") {
+    InstrumentationCounters counters;
+    CHECK(counters.empty());
+
+    counters.add(2222, "Prepare", 1.0);
+    counters.add(2223, "Solve", 2.0);
+    counters.add(2222, "Prepare", 0.5);
+    // same code with a different name is a different step
+    counters.add(2223, "Other", 4.0);
+
+    InstrumentationCounters other;
+    other.add(2223, "Solve", 8.0);
+    other.add(3000, "Output", 16.0);
+    counters.merge(other);
+
+    CalculationInfo info;
+    info[Timer::make_key(3000, "Output")] = 32.0;
+    counters.collect(info);
+    CHECK(info.size() == 4);
+    CHECK(info.at(Timer::make_key(2222, "Prepare")) == 1.5);
+    CHECK(info.at(Timer::make_key(2223, "Solve")) == 10.0);
+    CHECK(info.at(Timer::make_key(2223, "Other")) == 4.0);
+    CHECK(info.at(Timer::make_key(3000, "Output")) == 48.0);
+
+    counters.clear();
+    CHECK(counters.empty());
+}
+
+#ifndef POWER_GRID_MODEL_DISABLE_INSTRUMENTATION
+TEST_CASE("Test instrumented timer") {
+    InstrumentationCounters outer;
+    InstrumentationCounters inner;
+
+    {
+        InstrumentationScope const outer_scope{outer};
+        InstrumentedTimer const t_outer(1000, "Outer");
+        {
+            InstrumentationScope const inner_scope{inner};
+            InstrumentedTimer timer(2000, "First");
+            // stops the first timer
+            timer = InstrumentedTimer(2001, "Second");
+        }
+        InstrumentedTimer const t_after(1001, "After inner");
+    }
+    // outside of any scope, nothing is recorded
+    { InstrumentedTimer const t_unreported(9999, "Unreported"); }
+
+    CalculationInfo outer_info;
+    outer.collect(outer_info);
+    CHECK(outer_info.size() == 2);
+    CHECK(outer_info.contains(Timer::make_key(1000, "Outer")));
+    CHECK(outer_info.contains(Timer::make_key(1001, "After inner")));
+
+    CalculationInfo inner_info;
+    inner.collect(inner_info);
+    CHECK(inner_info.size() == 2);
+    CHECK(inner_info.at(Timer::make_key(2000, "First")) >= 0.0);
+    CHECK(inner_info.at(Timer::make_key(2001, "Second")) >= 0.0);
+}
+
+TEST_CASE("Test trace recorder") {
+    InstrumentationCounters counters;
+    TraceRecorder recorder{3, Clock::now()};
+
+    {
+        InstrumentationScope const scope{counters};
+        TraceScope const trace_scope{&recorder};
+        recorder.set_scenario(7);
+        {
+            InstrumentedTimer const t_outer(1200, "Update model");
+            {
+                // tracing is disabled in a nested scope without recorder
+                TraceScope const no_trace_scope{nullptr};
+                InstrumentedTimer const t_untraced(2100, "Untraced");
+            }
+            InstrumentedTimer const t_inner(2200, "Math \"Calculation\"");
+        }
+        recorder.set_scenario(-1);
+        InstrumentedTimer const t_after(0000, "Total");
+    }
+    // outside of the scope, nothing is traced
+    { InstrumentedTimer const t_untraced(9999, "Untraced"); }
+
+    // the events are recorded when the timers stop
+    std::vector<TraceEvent> const events = recorder.take_events();
+    REQUIRE(events.size() == 3);
+    CHECK(events[0].code == 2200);
+    CHECK(events[1].code == 1200);
+    CHECK(events[2].code == 0000);
+    CHECK(events[0].thread == 3);
+    CHECK(events[0].scenario == 7);
+    CHECK(events[1].scenario == 7);
+    CHECK(events[2].scenario == -1);
+    CHECK(events[1].begin <= events[0].begin);
+    CHECK(events[0].end <= events[1].end);
+    CHECK(events[1].end <= events[2].begin);
+    // the timings are still recorded in the counters
+    CalculationInfo info;
+    counters.collect(info);
+    CHECK(info.size() == 4);
+
+    std::string const trace = to_chrome_trace(events);
+    CHECK(trace.starts_with("{\"traceEvents\":["));
+    CHECK(trace.find("\"name\":\"Math \\\"Calculation\\\"\"") != std::string::npos);
+    CHECK(trace.find("\"ph\":\"X\",\"pid\":0,\"tid\":3") != std::string::npos);
+    CHECK(trace.find("\"args\":{\"code\":1200,\"scenario\":7}") != std::string::npos);
+    CHECK(trace.find("\"args\":{\"code\":0,\"scenario\":-1}") != std::string::npos);
+}
+#endif
+
+} // namespace power_grid_model
@@ -893,6 +893,139 @@ TEST_CASE_TEMPLATE("Test main model - restore components", settings, regular_upd
     }
 }
 
+TEST_CASE_TEMPLATE("Test main model - incremental parameter update", settings, regular_update, cached_update) {
+    State state;
+    auto main_model = default_model(state);
+    auto updated_model = default_model(state);
+    updated_model.update_component<Shunt, MainModel::permanent_update_t>(state.shunt_update);
+
+    for (auto const method : {CalculationMethod::linear, CalculationMethod::iterative_current}) {
+        CAPTURE(method);
+        // calculate first, such that the Y bus is built before the shunt is updated
+        auto const math_output_orig = main_model.calculate_power_flow<true>(1e-8, 20, method);
+        main_model.update_component<Shunt, typename settings::update_type>(state.shunt_update);
+        auto const math_output = main_model.calculate_power_flow<true>(1e-8, 20, method);
+        auto const math_output_ref = updated_model.calculate_power_flow<true>(1e-8, 20, method);
+        main_model.output_result<Appliance>(math_output, state.sym_appliance.begin());
+        CHECK(state.sym_appliance[4].i == doctest::Approx(0.0));
+        REQUIRE(math_output.size() == math_output_ref.size());
+        for (size_t i = 0; i != math_output[0].u.size(); ++i) {
+            CHECK(cabs(math_output[0].u[i] - math_output_ref[0].u[i]) < numerical_tolerance);
+        }
+
+        if constexpr (settings::update_type::value) {
+            main_model.restore_components();
+            auto const math_output_restored = main_model.calculate_power_flow<true>(1e-8, 20, method);
+            for (size_t i = 0; i != math_output_restored[0].u.size(); ++i) {
+                CHECK(cabs(math_output_restored[0].u[i] - math_output_orig[0].u[i]) < numerical_tolerance);
+            }
+        } else {
+            // restore the shunt by a regular update
+            main_model.update_component<Shunt, MainModel::permanent_update_t>(
+                std::vector<ShuntUpdate>{{{{9}, 1}, nan, 0.015, nan, 0.015}});
+        }
+    }
+}
+
+TEST_CASE("Test main model - linear current batch with injection updates") {
+    State state;
+    auto main_model = default_model(state);
+
+    // more scenarios than one block of right-hand sides
+    Idx const n_batch = 150;
+    std::vector<SymLoadGenUpdate> sym_load_update;
+    std::vector<AsymLoadGenUpdate> asym_load_update;
+    for (Idx batch = 0; batch != n_batch; ++batch) {
+        sym_load_update.push_back({{{7}, static_cast<IntS>(batch % 7 != 0)}, 1.0e4 * batch, 1.0e3 * batch});
+        asym_load_update.push_back({{{8}, 1}, RealValue<false>{2.0e3 * batch}, RealValue<false>{nan}});
+    }
+    ConstDataset update_data;
+    update_data["sym_load"] = DataPointer<true>{sym_load_update.data(), n_batch, 1};
+    update_data["asym_load"] = DataPointer<true>{asym_load_update.data(), n_batch, 1};
+    CHECK(MainModel::is_update_injection_only(update_data));
+
+    std::vector<NodeOutput<true>> batch_node(n_batch * 3);
+    std::vector<ApplianceOutput<true>> batch_sym_load(n_batch);
+    Dataset result_data;
+    result_data["node"] = DataPointer<false>{batch_node.data(), n_batch, 3};
+    result_data["sym_load"] = DataPointer<false>{batch_sym_load.data(), n_batch, 1};
+
+    for (Idx const threading : {-1, 2}) {
+        CAPTURE(threading);
+        main_model.calculate_power_flow<true>(1e-8, 20, CalculationMethod::linear_current, result_data, update_data,
+                                              threading);
+
+        for (Idx batch = 0; batch != n_batch; ++batch) {
+            auto ref_model = default_model(state);
+            ref_model.update_component<SymLoad, MainModel::permanent_update_t>(
+                std::vector<SymLoadGenUpdate>{sym_load_update[batch]});
+            ref_model.update_component<AsymLoad, MainModel::permanent_update_t>(
+                std::vector<AsymLoadGenUpdate>{asym_load_update[batch]});
+            auto const ref_output = ref_model.calculate_power_flow<true>(1e-8, 20, CalculationMethod::linear_current);
+            std::vector<NodeOutput<true>> ref_node(3);
+            std::vector<ApplianceOutput<true>> ref_sym_load(1);
+            ref_model.output_result<Node>(ref_output, ref_node.begin());
+            ref_model.output_result<SymLoad>(ref_output, ref_sym_load.begin());
+            for (Idx i = 0; i != 3; ++i) {
+                CHECK(batch_node[batch * 3 + i].u_pu == doctest::Approx(ref_node[i].u_pu));
+                CHECK(batch_node[batch * 3 + i].u_angle == doctest::Approx(ref_node[i].u_angle));
+            }
+            CHECK(batch_sym_load[batch].energized == ref_sym_load[0].energized);
+            CHECK(batch_sym_load[batch].p == doctest::Approx(ref_sym_load[0].p));
+        }
+    }
+
+    // other updates are not injection-only
+    update_data["shunt"] = DataPointer<true>{state.shunt_update.data(), 1};
+    CHECK(!MainModel::is_update_injection_only(update_data));
+}
+
+TEST_CASE("Test main model - batch worker copies only the updated components") {
+    State state;
+    auto main_model = default_model(state);
+    MainModel const& base_model = main_model;
+
+    Idx const n_batch = 4;
+    std::vector<SymLoadGenUpdate> sym_load_update;
+    for (Idx batch = 0; batch != n_batch; ++batch) {
+        sym_load_update.push_back({{{7}, 1}, 1.0e4 * batch, nan});
+    }
+    ConstDataset update_data;
+    update_data["sym_load"] = DataPointer<true>{sym_load_update.data(), n_batch, 1};
+
+    for (Idx const threading : {-1, 2}) {
+        CAPTURE(threading);
+        // whether the worker model shares the storage of a component with the base model, per scenario
+        std::vector<char> node_shared(n_batch);
+        std::vector<char> line_shared(n_batch);
+        std::vector<char> asym_load_shared(n_batch);
+        std::vector<char> sym_load_shared(n_batch);
+        main_model.batch_calculation_(
+            [&](MainModel& model, Dataset const& /* result_data */, Idx pos) {
+                // the preparation runs on the base model itself
+                if (pos < 0) {
+                    return;
+                }
+                MainModel const& worker_model = model;
+                node_shared[pos] = &worker_model.get_component<Node>(1) == &base_model.get_component<Node>(1);
+                line_shared[pos] = &worker_model.get_component<Line>(4) == &base_model.get_component<Line>(4);
+                asym_load_shared[pos] =
+                    &worker_model.get_component<AsymLoad>(8) == &base_model.get_component<AsymLoad>(8);
+                sym_load_shared[pos] =
+                    &worker_model.get_component<SymLoad>(7) == &base_model.get_component<SymLoad>(7);
+            },
+            Dataset{}, update_data, threading);
+
+        for (Idx batch = 0; batch != n_batch; ++batch) {
+            CAPTURE(batch);
+            CHECK(node_shared[batch]);
+            CHECK(line_shared[batch]);
+            CHECK(asym_load_shared[batch]);
+            CHECK(!sym_load_shared[batch]);
+        }
+    }
+}
+
 TEST_CASE("Test main model - runtime dispatch") {
     State state;
     auto main_model = default_model(state);
@@ -1021,6 +1154,72 @@ TEST_CASE("Test main model - runtime dispatch") {
         CHECK(sym_node_2[7].u_pu == doctest::Approx(0.67).epsilon(0.005));
         CHECK(sym_node_2[8].u_pu == doctest::Approx(0.67).epsilon(0.005));
     }
+
+    SUBCASE("Dependent batch with variable scenario sizes") {
+        MainModel model{50.0, input_data};
+        ConstDataset dependent_update_data;
+        Dataset dependent_result_data;
+
+        // the second scenario is empty, the third scenario has an unknown id
+        std::vector<SymLoadGenUpdate> sym_load_update_2{
+            {{{7}, 1}, nan, 1.0e7}, {{{100}, 1}, 1.0e3, nan}, {{{7}, 1}, 1.0e3, nan}};
+        IdxVector const indptr{0, 1, 1, 2, 3};
+        Idx const n_batch = 4;
+        dependent_update_data["sym_load"] = DataPointer<true>{sym_load_update_2.data(), indptr.data(), n_batch};
+
+        std::vector<NodeOutput<true>> sym_node_2(n_batch * state.sym_node.size());
+        dependent_result_data["node"] =
+            DataPointer<false>{sym_node_2.data(), n_batch, static_cast<Idx>(state.sym_node.size())};
+
+        for (Idx const threading : {-1, 2}) {
+            CAPTURE(threading);
+            IdxVector failed_scenarios;
+            try {
+                model.calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson, dependent_result_data,
+                                                 dependent_update_data, threading);
+            } catch (BatchCalculationError const& e) {
+                failed_scenarios = e.failed_scenarios();
+            }
+            CHECK(failed_scenarios == IdxVector{2});
+            CHECK(sym_node_2[1].u_pu == doctest::Approx(0.66).epsilon(0.005));
+            CHECK(sym_node_2[4].u_pu == doctest::Approx(state.u1));
+            CHECK(sym_node_2[10].u_pu == doctest::Approx(0.87).epsilon(0.005));
+        }
+    }
+
+    SUBCASE("Batch errors of multiple threads") {
+        MainModel model{50.0, input_data};
+        ConstDataset dependent_update_data;
+        Dataset dependent_result_data;
+
+        // scenarios 1, 4 and 5 have an unknown id
+        std::vector<SymLoadGenUpdate> sym_load_update_2{{{{7}, 1}, 1.0e3, nan},   {{{100}, 1}, 1.0e3, nan},
+                                                        {{{7}, 1}, 1.0e3, nan},   {{{7}, 1}, 1.0e3, nan},
+                                                        {{{101}, 1}, 1.0e3, nan}, {{{102}, 1}, 1.0e3, nan}};
+        Idx const n_batch = static_cast<Idx>(sym_load_update_2.size());
+        dependent_update_data["sym_load"] = DataPointer<true>{sym_load_update_2.data(), n_batch, 1};
+
+        std::vector<NodeOutput<true>> sym_node_2(n_batch * state.sym_node.size());
+        dependent_result_data["node"] =
+            DataPointer<false>{sym_node_2.data(), n_batch, static_cast<Idx>(state.sym_node.size())};
+
+        for (Idx const threading : {-1, 3}) {
+            CAPTURE(threading);
+            IdxVector failed_scenarios;
+            std::vector<std::string> err_msgs;
+            try {
+                model.calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson, dependent_result_data,
+                                                 dependent_update_data, threading);
+            } catch (BatchCalculationError const& e) {
+                failed_scenarios = e.failed_scenarios();
+                err_msgs = e.err_msgs();
+            }
+            CHECK(failed_scenarios == IdxVector{1, 4, 5});
+            REQUIRE(err_msgs.size() == 3);
+            CHECK(err_msgs[0] != err_msgs[1]);
+            CHECK(model.calculation_info().contains(Timer::make_key(1200, "Update model")));
+        }
+    }
 }
 
 TEST_CASE("Test main model - incomplete input but complete dataset") {
@@ -1137,4 +1336,117 @@ TEST_CASE("Test main model - incomplete input but complete dataset") {
     }
 }
 
+TEST_CASE("Test main model - switching in meshed grid") {
+    // meshed grid: source at node 1, lines 4 (1 -> 2), 5 (2 -> 3) and 6 (1 -> 3), loads at node 2 and 3
+    std::vector<NodeInput> const node_input{{{1}, 10e3}, {{2}, 10e3}, {{3}, 10e3}};
+    std::vector<SourceInput> const source_input{{{{7}, 1, 1}, 1.05, nan, 1e12, nan, nan}};
+    std::vector<SymLoadGenInput> const sym_load_input{{{{{8}, 2, 1}, LoadGenType::const_pq}, 1.0e6, 0.2e6},
+                                                      {{{{9}, 3, 1}, LoadGenType::const_pq}, 0.5e6, 0.1e6}};
+
+    auto const get_line_input = [](IntS status_5_from, IntS status_5_to, IntS status_6_from, IntS status_6_to) {
+        return std::vector<LineInput>{
+            {{{4}, 1, 2, 1, 1}, 0.5, 1.0, 0.0, 0.0, 0.5, 1.0, 0.0, 0.0, 1e3},
+            {{{5}, 2, 3, status_5_from, status_5_to}, 0.5, 1.0, 1e-6, 0.0, 0.5, 1.0, 1e-6, 0.0, 1e3},
+            {{{6}, 1, 3, status_6_from, status_6_to}, 0.5, 1.0, 1e-6, 0.0, 0.5, 1.0, 1e-6, 0.0, 1e3}};
+    };
+    auto const get_model = [&](std::vector<LineInput> const& line_input) {
+        MainModel model{50.0};
+        model.add_component<Node>(node_input);
+        model.add_component<Line>(line_input);
+        model.add_component<Source>(source_input);
+        model.add_component<SymLoad>(sym_load_input);
+        model.set_construction_complete();
+        return model;
+    };
+    auto const check_equal = [](MainModel& test_model, MainModel& ref_model) {
+        std::vector<NodeOutput<true>> test_node(3);
+        std::vector<NodeOutput<true>> ref_node(3);
+        std::vector<BranchOutput<true>> test_branch(3);
+        std::vector<BranchOutput<true>> ref_branch(3);
+        auto const test_output = test_model.calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson);
+        auto const ref_output = ref_model.calculate_power_flow<true>(1e-8, 20, CalculationMethod::newton_raphson);
+        test_model.output_result<Node>(test_output, test_node.begin());
+        ref_model.output_result<Node>(ref_output, ref_node.begin());
+        test_model.output_result<Branch>(test_output, test_branch.begin());
+        ref_model.output_result<Branch>(ref_output, ref_branch.begin());
+        for (Idx i = 0; i != 3; ++i) {
+            CHECK(test_node[i].energized == ref_node[i].energized);
+            CHECK(test_node[i].u_pu == doctest::Approx(ref_node[i].u_pu));
+            CHECK(test_node[i].u_angle == doctest::Approx(ref_node[i].u_angle));
+            CHECK(test_branch[i].energized == ref_branch[i].energized);
+            CHECK(test_branch[i].p_from == doctest::Approx(ref_branch[i].p_from));
+            CHECK(test_branch[i].q_from == doctest::Approx(ref_branch[i].q_from));
+            CHECK(test_branch[i].p_to == doctest::Approx(ref_branch[i].p_to));
+            CHECK(test_branch[i].q_to == doctest::Approx(ref_branch[i].q_to));
+        }
+    };
+
+    auto main_model = get_model(get_line_input(1, 1, 1, 1));
+    auto ref_closed = get_model(get_line_input(1, 1, 1, 1));
+    check_equal(main_model, ref_closed);
+
+    SUBCASE("Open branch") {
+        auto ref_model = get_model(get_line_input(1, 1, 0, 0));
+        main_model.update_component<Line, MainModel::cached_update_t>(std::vector<BranchUpdate>{{{6}, 0, 0}});
+        check_equal(main_model, ref_model);
+    }
+    SUBCASE("Open one side of branch") {
+        auto ref_model = get_model(get_line_input(1, 1, 0, 1));
+        main_model.update_component<Line, MainModel::cached_update_t>(std::vector<BranchUpdate>{{{6}, 0, na_IntS}});
+        check_equal(main_model, ref_model);
+    }
+    SUBCASE("Disconnect node") {
+        auto ref_model = get_model(get_line_input(0, 1, 1, 0));
+        main_model.update_component<Line, MainModel::cached_update_t>(
+            std::vector<BranchUpdate>{{{5}, 0, na_IntS}, {{6}, na_IntS, 0}});
+        check_equal(main_model, ref_model);
+    }
+
+    SUBCASE("Batch with recurring switching states") {
+        // status of line 5 and 6 per scenario, the disconnected node needs a full topology build
+        std::vector<std::array<IntS, 4>> const statuses{
+            {0, 1, 1, 0}, {1, 1, 0, 0}, {0, 1, 1, 0}, {1, 1, 1, 1}, {0, 1, 1, 0}, {1, 1, 0, 1}};
+        auto const n_batch = static_cast<Idx>(statuses.size());
+        std::vector<BranchUpdate> line_update;
+        for (auto const& status : statuses) {
+            line_update.push_back({{5}, status[0], status[1]});
+            line_update.push_back({{6}, status[2], status[3]});
+        }
+        ConstDataset update_data;
+        update_data["line"] = DataPointer<true>{line_update.data(), n_batch, 2};
+        std::vector<NodeOutput<true>> batch_node(n_batch * 3);
+        Dataset result_data;
+        result_data["node"] = DataPointer<false>{batch_node.data(), n_batch, 3};
+
+        // the linear and iterative current methods re-use the base case factorization for the opened branch
+        // starting from the previous solution gives the same result, also if the topology changes
+        for (auto const& [initialization, threading, partitioning] :
+             {std::tuple{PowerFlowInitialization::flat_start, Idx{-1}, BatchPartitioning::work_stealing},
+              std::tuple{PowerFlowInitialization::previous_solution, Idx{-1}, BatchPartitioning::work_stealing},
+              std::tuple{PowerFlowInitialization::previous_solution, Idx{2}, BatchPartitioning::contiguous}}) {
+            for (auto const method : {CalculationMethod::newton_raphson, CalculationMethod::linear,
+                                      CalculationMethod::iterative_current, CalculationMethod::fast_decoupled}) {
+                main_model.calculate_power_flow<true>(1e-8, 20, method, result_data, update_data, threading,
+                                                      initialization, partitioning);
+
+                for (Idx batch = 0; batch != n_batch; ++batch) {
+                    auto const& status = statuses[batch];
+                    auto ref_model = get_model(get_line_input(status[0], status[1], status[2], status[3]));
+                    std::vector<NodeOutput<true>> ref_node(3);
+                    ref_model.output_result<Node>(ref_model.calculate_power_flow<true>(1e-8, 20, method),
+                                                  ref_node.begin());
+                    for (Idx i = 0; i != 3; ++i) {
+                        CHECK(batch_node[batch * 3 + i].energized == ref_node[i].energized);
+                        CHECK(batch_node[batch * 3 + i].u_pu == doctest::Approx(ref_node[i].u_pu));
+                        CHECK(batch_node[batch * 3 + i].u_angle == doctest::Approx(ref_node[i].u_angle));
+                    }
+                }
+            }
+        }
+    }
+
+    main_model.restore_components();
+    check_equal(main_model, ref_closed);
+}
+
 } // namespace power_grid_model
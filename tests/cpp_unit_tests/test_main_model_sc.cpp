@@ -169,4 +169,71 @@ TEST_CASE("Test main model - short circuit - Dataset input") {
     }
 }
 
+TEST_CASE("Test main model - short circuit - paired voltage scaling") {
+    std::vector<NodeInput> node_input{{{1}, 10e4}, {{2}, 10e4}};
+    std::vector<LineInput> line_input{{{{3}, 1, 2, 1, 1}, 10.0, 0.0, 0.0, 0.0, 10.0, 0.0, 0.0, 0.0, 1e3}};
+    std::vector<SourceInput> source_input{{{{4}, 1, 1}, 1.0, nan, nan, nan, nan}};
+    std::vector<FaultInput> fault_input{{{5}, 1, FaultType::three_phase, FaultPhase::default_value, 2, 1.0, 1.0},
+                                        {{6}, 0, FaultType::three_phase, FaultPhase::default_value, 1, nan, nan}};
+
+    ConstDataset input_data;
+    input_data["node"] = DataPointer<true>{node_input.data(), static_cast<Idx>(node_input.size())};
+    input_data["line"] = DataPointer<true>{line_input.data(), static_cast<Idx>(line_input.size())};
+    input_data["source"] = DataPointer<true>{source_input.data(), static_cast<Idx>(source_input.size())};
+    input_data["fault"] = DataPointer<true>{fault_input.data(), static_cast<Idx>(fault_input.size())};
+
+    MainModel model{50.0, input_data};
+
+    // a single fault, and two faults at the same time
+    std::vector<FaultUpdate> fault_update{
+        {{5}, 1, FaultType::three_phase, FaultPhase::abc, 1, nan, nan},
+        {{6}, 0, FaultType::three_phase, FaultPhase::abc, na_IntID, nan, nan},
+        {{5}, 1, FaultType::single_phase_to_ground, FaultPhase::a, 2, nan, nan},
+        {{6}, 1, FaultType::single_phase_to_ground, FaultPhase::a, 2, nan, nan},
+        {{5}, 1, FaultType::three_phase, FaultPhase::abc, 2, nan, nan},
+        {{6}, 1, FaultType::three_phase, FaultPhase::abc, 1, nan, nan},
+    };
+    Idx const n_batch = 3;
+    ConstDataset update_data;
+    update_data["fault"] = DataPointer<true>{fault_update.data(), n_batch, 2};
+
+    auto const get_result = [n_batch](std::vector<NodeShortCircuitOutput>& node_output,
+                                      std::vector<FaultShortCircuitOutput>& fault_output) {
+        node_output.resize(n_batch * 2);
+        fault_output.resize(n_batch * 2);
+        Dataset result_data;
+        result_data["node"] = DataPointer<false>{node_output.data(), n_batch, 2};
+        result_data["fault"] = DataPointer<false>{fault_output.data(), n_batch, 2};
+        return result_data;
+    };
+
+    std::vector<NodeShortCircuitOutput> node_max;
+    std::vector<FaultShortCircuitOutput> fault_max;
+    std::vector<NodeShortCircuitOutput> node_min;
+    std::vector<FaultShortCircuitOutput> fault_min;
+    model.calculate_short_circuit(ShortCircuitVoltageScaling::maximum, CalculationMethod::iec60909,
+                                  get_result(node_max, fault_max), update_data);
+    model.calculate_short_circuit(ShortCircuitVoltageScaling::minimum, CalculationMethod::iec60909,
+                                  get_result(node_min, fault_min), update_data);
+
+    std::vector<NodeShortCircuitOutput> node_output;
+    std::vector<FaultShortCircuitOutput> fault_output;
+    std::vector<NodeShortCircuitOutput> paired_node_output;
+    std::vector<FaultShortCircuitOutput> paired_fault_output;
+    model.calculate_short_circuit_paired(ShortCircuitVoltageScaling::maximum, CalculationMethod::iec60909,
+                                         get_result(node_output, fault_output),
+                                         get_result(paired_node_output, paired_fault_output), update_data);
+
+    for (Idx i = 0; i != n_batch * 2; ++i) {
+        for (Idx phase = 0; phase != 3; ++phase) {
+            CHECK(node_output[i].u_pu(phase) == doctest::Approx(node_max[i].u_pu(phase)));
+            CHECK(paired_node_output[i].u_pu(phase) == doctest::Approx(node_min[i].u_pu(phase)));
+            CHECK(fault_output[i].i_f(phase) == doctest::Approx(fault_max[i].i_f(phase)));
+            CHECK(paired_fault_output[i].i_f(phase) == doctest::Approx(fault_min[i].i_f(phase)));
+        }
+    }
+    // the maximum voltage scaling gives a larger fault current
+    CHECK(fault_output[0].i_f(0) > paired_fault_output[0].i_f(0));
+}
+
 } // namespace power_grid_model
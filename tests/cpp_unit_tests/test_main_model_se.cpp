@@ -142,6 +142,31 @@ TEST_CASE("Test main model - state estimation") {
                     CHECK(power_sensor_output[2].p_residual == doctest::Approx(-200.0).scale(1e3)); // node
                     CHECK(power_sensor_output[2].q_residual == doctest::Approx(-20.0).scale(1e3));  // node
                 }
+                SUBCASE("With Injection Sensor - Newton-Raphson") {
+                    main_model.add_component<SymPowerSensor>(
+                        {{{{{12}, 2}, MeasuredTerminalType::node, 2e2}, -1200.0, -120.0}});
+                    main_model.set_construction_complete();
+
+                    std::vector<MathOutput<true>> const math_output =
+                        main_model.calculate_state_estimation<true>(1e-8, 20, CalculationMethod::newton_raphson);
+
+                    std::vector<SymApplianceOutput> gen_output(1);
+                    std::vector<SymApplianceOutput> load_output(1);
+                    std::vector<SymNodeOutput> node_output(2);
+                    main_model.output_result<AsymGenerator>(math_output, gen_output.begin());
+                    main_model.output_result<AsymLoad>(math_output, load_output.begin());
+                    main_model.output_result<Node>(math_output, node_output.begin());
+
+                    CHECK(gen_output[0].p == doctest::Approx(850.0).scale(1e3));
+                    CHECK(gen_output[0].q == doctest::Approx(85.0).scale(1e3));
+
+                    CHECK(load_output[0].p == doctest::Approx(1850.0).scale(1e3));
+                    CHECK(load_output[0].q == doctest::Approx(185.0).scale(1e3));
+
+                    CHECK(node_output[0].u == doctest::Approx(10.0e3));
+                    CHECK(node_output[1].p == doctest::Approx(-1000.0).scale(1e3));
+                    CHECK(node_output[1].q == doctest::Approx(-100.0).scale(1e3));
+                }
             }
         }
 
@@ -13,6 +13,7 @@
 
 namespace power_grid_model {
 namespace {
+using CalculationMethod::fast_decoupled;
 using CalculationMethod::iterative_current;
 using CalculationMethod::iterative_linear;
 using CalculationMethod::linear;
@@ -442,6 +443,38 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref);
     }
 
+    SUBCASE("Test symmetric fast decoupled pf solver") {
+        MathSolver<true> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<true> output = solver.run_power_flow(pf_input, 1e-12, 200, info, fast_decoupled, y_bus_sym);
+        // verify
+        assert_output(output, output_ref);
+        // run again with the prefactorized matrices
+        output = solver.run_power_flow(pf_input, 1e-12, 200, info, fast_decoupled, y_bus_sym);
+        assert_output(output, output_ref);
+    }
+
+    SUBCASE("Test symmetric pf solver with previous solution as initialization") {
+        auto const iteration_key = Timer::make_key(2226, "Max number of iterations");
+        for (auto const method : {newton_raphson, iterative_current, fast_decoupled}) {
+            CAPTURE(method);
+            MathSolver<true> solver{topo_ptr};
+            CalculationInfo info;
+            MathOutput<true> output = solver.run_power_flow(pf_input, 1e-12, 200, info, method, y_bus_sym,
+                                                            PowerFlowInitialization::previous_solution);
+            // no previous solution, flat start
+            assert_output(output, output_ref);
+            CHECK(info[iteration_key] > 1.0);
+
+            // start from the converged solution
+            CalculationInfo info_warm;
+            output = solver.run_power_flow(pf_input, 1e-12, 200, info_warm, method, y_bus_sym,
+                                           PowerFlowInitialization::previous_solution);
+            assert_output(output, output_ref);
+            CHECK(info_warm[iteration_key] == 1.0);
+        }
+    }
+
     SUBCASE("Test symmetric linear current pf solver") {
         // low precision
         constexpr auto error_tolerance{5e-3};
@@ -453,6 +486,21 @@ TEST_CASE("Test math solver") {
             solver.run_power_flow(pf_input, error_tolerance, 20, info, linear_current, y_bus_sym);
         // verify
         assert_output(output, output_ref, false, result_tolerance);
+
+        // multiple inputs at once give the same result as one by one
+        PowerFlowInput<true> pf_input_scaled = pf_input;
+        for (auto& s_injection : pf_input_scaled.s_injection) {
+            s_injection *= 0.5;
+        }
+        MathSolver<true> single_solver{topo_ptr};
+        MathOutput<true> const output_scaled =
+            single_solver.run_power_flow(pf_input_scaled, error_tolerance, 20, info, linear_current, y_bus_sym);
+        std::vector<MathOutput<true>> const outputs =
+            solver.run_power_flow_linear_current_batch({pf_input, pf_input_scaled, pf_input}, info, y_bus_sym);
+        REQUIRE(outputs.size() == 3);
+        assert_output(outputs[0], output);
+        assert_output(outputs[1], output_scaled);
+        assert_output(outputs[2], output);
     }
 
     SUBCASE("Test wrong calculation type") {
@@ -482,7 +530,8 @@ TEST_CASE("Test math solver") {
     }
 
     SUBCASE("Test singular ybus") {
-        std::vector<CalculationMethod> const methods{linear, newton_raphson, linear_current, iterative_current};
+        std::vector<CalculationMethod> const methods{linear, newton_raphson, linear_current, iterative_current,
+                                                     fast_decoupled};
 
         param.branch_param[0] = BranchCalcParam<true>{};
         param.branch_param[1] = BranchCalcParam<true>{};
@@ -515,6 +564,16 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref_asym);
     }
 
+    SUBCASE("Test fast decoupled asymmetric pf solver") {
+        // the zero sequence admittance of branch0 is capacitive with R = |X|
+        // the unbalanced modes of P-Theta and Q-V are strongly coupled, decoupling is not valid for this grid
+        // the solver should report the divergence instead of returning a wrong result
+        MathSolver<false> solver{topo_ptr};
+        CalculationInfo info;
+        CHECK_THROWS_AS(solver.run_power_flow(pf_input_asym, 1e-12, 200, info, fast_decoupled, y_bus_asym),
+                        IterationDiverge);
+    }
+
     SUBCASE("Test asym const z pf solver") {
         MathSolver<false> solver{topo_ptr};
         CalculationInfo info;
@@ -551,6 +610,52 @@ TEST_CASE("Test math solver") {
         assert_output(output, output_ref_z);
     }
 
+    SUBCASE("Test sym se with re-used gain matrix") {
+        // consecutive calculations on the same solver, with changed measured values and changed measurement pattern
+        MathSolver<true> solver{topo_ptr};
+        CalculationInfo info;
+        assert_output(solver.run_state_estimation(se_input_angle, 1e-10, 20, info, iterative_linear, y_bus_sym),
+                      output_ref);
+        assert_output(solver.run_state_estimation(se_input_no_angle, 1e-10, 20, info, iterative_linear, y_bus_sym),
+                      output_ref, true);
+        assert_output(
+            solver.run_state_estimation(se_input_angle_const_z, 1e-10, 20, info, iterative_linear, y_bus_sym),
+            output_ref_z);
+        assert_output(solver.run_state_estimation(se_input_angle, 1e-10, 20, info, iterative_linear, y_bus_sym),
+                      output_ref);
+    }
+
+    SUBCASE("Test se not observable") {
+        // invalidate all measurements, only the zero injection of bus2 remains
+        StateEstimationInput<true> se_input_invalid = se_input_angle;
+        for (auto* measured : {&se_input_invalid.measured_voltage, &se_input_invalid.measured_bus_injection,
+                               &se_input_invalid.measured_source_power, &se_input_invalid.measured_load_gen_power,
+                               &se_input_invalid.measured_shunt_power, &se_input_invalid.measured_branch_from_power,
+                               &se_input_invalid.measured_branch_to_power}) {
+            for (auto& sensor : *measured) {
+                sensor.variance = std::numeric_limits<double>::infinity();
+            }
+        }
+        // enough measurements, but bus0 does not appear in any measurement
+        // voltage and shunt at bus2, zero injection at bus2
+        StateEstimationInput<true> se_input_bus0_unmeasured = se_input_invalid;
+        se_input_bus0_unmeasured.measured_voltage[1].variance = 1.0;
+        se_input_bus0_unmeasured.measured_shunt_power[0].variance = 1.0;
+
+        for (auto const method : {iterative_linear, newton_raphson}) {
+            MathSolver<true> solver{topo_ptr};
+            CalculationInfo info;
+            CHECK_THROWS_AS(solver.run_state_estimation(se_input_invalid, 1e-10, 20, info, method, y_bus_sym),
+                            NotObservableError);
+            CHECK_THROWS_AS(solver.run_state_estimation(se_input_bus0_unmeasured, 1e-10, 20, info, method, y_bus_sym),
+                            NotObservableError);
+            // the cached result of the check is refreshed when the measurement pattern changes
+            assert_output(solver.run_state_estimation(se_input_angle, 1e-10, 20, info, method, y_bus_sym), output_ref);
+            CHECK_THROWS_AS(solver.run_state_estimation(se_input_invalid, 1e-10, 20, info, method, y_bus_sym),
+                            NotObservableError);
+        }
+    }
+
     SUBCASE("Test asym se with angle") {
         MathSolver<false> solver{topo_ptr};
         CalculationInfo info;
@@ -578,6 +683,51 @@ TEST_CASE("Test math solver") {
         // verify
         assert_output(output, output_ref_asym_z);
     }
+
+    SUBCASE("Test sym se newton raphson with angle") {
+        MathSolver<true> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<true> const output =
+            solver.run_state_estimation(se_input_angle, 1e-10, 20, info, newton_raphson, y_bus_sym);
+        // verify
+        assert_output(output, output_ref);
+    }
+
+    SUBCASE("Test sym se newton raphson without angle") {
+        MathSolver<true> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<true> const output =
+            solver.run_state_estimation(se_input_no_angle, 1e-10, 20, info, newton_raphson, y_bus_sym);
+        // verify
+        assert_output(output, output_ref, true);
+    }
+
+    SUBCASE("Test sym se newton raphson with angle, const z") {
+        MathSolver<true> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<true> const output =
+            solver.run_state_estimation(se_input_angle_const_z, 1e-10, 20, info, newton_raphson, y_bus_sym);
+        // verify
+        assert_output(output, output_ref_z);
+    }
+
+    SUBCASE("Test asym se newton raphson with angle") {
+        MathSolver<false> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<false> const output =
+            solver.run_state_estimation(se_input_asym_angle, 1e-10, 20, info, newton_raphson, y_bus_asym);
+        // verify
+        assert_output(output, output_ref_asym);
+    }
+
+    SUBCASE("Test asym se newton raphson without angle") {
+        MathSolver<false> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<false> const output =
+            solver.run_state_estimation(se_input_asym_no_angle, 1e-10, 20, info, newton_raphson, y_bus_asym);
+        // verify
+        assert_output(output, output_ref_asym, true);
+    }
 }
 
 namespace {
@@ -668,6 +818,81 @@ ShortCircuitMathOutput<sym> create_sc_test_output(FaultType fault_type, DoubleCo
 
 } // namespace
 
+TEST_CASE("Math solver, fast decoupled with high R/X ratio") {
+    /*
+    network, cables with R/X = 4 and a mesh between bus1 and bus3
+
+    source --yref-- bus0 --branch0-- bus1 --branch1-- bus2 --branch2-- bus3
+                                      |                                  |
+                                      ---------------branch3-------------
+    loads at bus1, bus2 and bus3
+    */
+    MathModelTopology topo;
+    topo.slack_bus_ = 0;
+    topo.phase_shift = {0.0, 0.0, 0.0, 0.0};
+    topo.branch_bus_idx = {{0, 1}, {1, 2}, {2, 3}, {1, 3}};
+    topo.source_bus_indptr = {0, 1, 1, 1, 1};
+    topo.shunt_bus_indptr = {0, 0, 0, 0, 0};
+    topo.load_gen_bus_indptr = {0, 0, 1, 2, 3};
+    topo.load_gen_type = {LoadGenType::const_pq, LoadGenType::const_pq, LoadGenType::const_pq};
+    topo.voltage_sensor_indptr = {0, 0, 0, 0, 0};
+    topo.bus_power_sensor_indptr = {0, 0, 0, 0, 0};
+    topo.source_power_sensor_indptr = {0, 0};
+    topo.load_gen_power_sensor_indptr = {0, 0, 0, 0};
+    topo.shunt_power_sensor_indptr = {0};
+    topo.branch_from_power_sensor_indptr = {0, 0, 0, 0, 0};
+    topo.branch_to_power_sensor_indptr = {0, 0, 0, 0, 0};
+    auto topo_ptr = std::make_shared<MathModelTopology const>(topo);
+
+    DoubleComplex const y_cable = 1.0 / (0.04 + 0.01i);
+    DoubleComplex const y_cable_0 = 1.0 / (0.12 + 0.04i);
+    DoubleComplex const y_shunt = 0.002i;
+    DoubleComplex const yref = 10.0 - 50.0i;
+
+    MathModelParam<true> param;
+    param.branch_param.assign(4, {y_cable + y_shunt, -y_cable, -y_cable, y_cable + y_shunt});
+    param.source_param = {yref};
+    YBus<true> const y_bus_sym{topo_ptr, std::make_shared<MathModelParam<true> const>(param)};
+    PowerFlowInput<true> pf_input;
+    pf_input.source = {1.05};
+    pf_input.s_injection = {-0.8 - 0.3i, -0.5 - 0.2i, -0.9 - 0.4i};
+
+    MathModelParam<false> param_asym;
+    ComplexTensor<false> const y_cable_asym{(2.0 * y_cable + y_cable_0) / 3.0, (y_cable_0 - y_cable) / 3.0};
+    ComplexTensor<false> const y_shunt_asym{y_shunt};
+    param_asym.branch_param.assign(
+        4, {y_cable_asym + y_shunt_asym, -y_cable_asym, -y_cable_asym, y_cable_asym + y_shunt_asym});
+    param_asym.source_param = {ComplexTensor<false>{yref}};
+    YBus<false> const y_bus_asym{topo_ptr, std::make_shared<MathModelParam<false> const>(param_asym)};
+    PowerFlowInput<false> pf_input_asym;
+    pf_input_asym.source = pf_input.source;
+    for (DoubleComplex const s_injection : pf_input.s_injection) {
+        pf_input_asym.s_injection.push_back(RealValue<false>{real(s_injection)} +
+                                            1.0i * RealValue<false>{imag(s_injection)});
+    }
+
+    SUBCASE("Symmetric") {
+        MathSolver<true> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<true> const output_ref =
+            solver.run_power_flow(pf_input, 1e-12, 20, info, newton_raphson, y_bus_sym);
+        // the voltage drop is significant
+        CHECK(cabs(output_ref.u[3]) < 0.95);
+        MathOutput<true> const output = solver.run_power_flow(pf_input, 1e-12, 100, info, fast_decoupled, y_bus_sym);
+        assert_output(output, output_ref);
+    }
+
+    SUBCASE("Asymmetric") {
+        MathSolver<false> solver{topo_ptr};
+        CalculationInfo info;
+        MathOutput<false> const output_ref =
+            solver.run_power_flow(pf_input_asym, 1e-12, 20, info, newton_raphson, y_bus_asym);
+        MathOutput<false> const output =
+            solver.run_power_flow(pf_input_asym, 1e-12, 100, info, fast_decoupled, y_bus_asym);
+        assert_output(output, output_ref);
+    }
+}
+
 TEST_CASE("Short circuit solver") {
     // Test case grid
     // source -- bus --- line -- bus -- fault(type varying as per subcase)
@@ -859,6 +1084,77 @@ TEST_CASE("Short circuit solver") {
         assert_sc_output<true>(sym_output, sym_sc_output_ref);
     }
 
+    SUBCASE("Test short circuit solver fault sweep") {
+        // a single fault re-uses the factorization of the pre-fault network for all fault locations
+        // the reference splits the fault in two halves on the same bus, which factorizes the faulted network
+        YBus<false> y_bus_asym{topo_sc_ptr, param_asym_ptr};
+        MathSolver<false> solver{topo_sc_ptr};
+        MathSolver<false> ref_solver{topo_sc_ptr};
+        CalculationInfo info;
+        for (auto const& [fault_type, fault_phase] :
+             {std::pair{three_phase, FaultPhase::abc}, std::pair{single_phase_to_ground, FaultPhase::b},
+              std::pair{two_phase, FaultPhase::ac}}) {
+            for (IdxVector const& sweep_bus_indptr : {IdxVector{0, 1, 1}, IdxVector{0, 0, 1}}) {
+                auto const sc_input = create_sc_test_input(fault_type, fault_phase, y_fault, vref, sweep_bus_indptr);
+                ShortCircuitInput ref_input = create_sc_test_input(fault_type, fault_phase, 0.5 * y_fault, vref,
+                                                                   {0, 2 * sweep_bus_indptr[1], 2});
+                ref_input.faults.push_back(ref_input.faults.front());
+
+                auto const output = solver.run_short_circuit(sc_input, info, CalculationMethod::iec60909, y_bus_asym);
+                auto ref_output =
+                    ref_solver.run_short_circuit(ref_input, info, CalculationMethod::iec60909, y_bus_asym);
+                ref_output.fault = {{ref_output.fault[0].i_fault + ref_output.fault[1].i_fault}};
+                assert_sc_output<false>(output, ref_output);
+            }
+        }
+    }
+
+    SUBCASE("Test short circuit solver single fault against full solve") {
+        // the grid is extended with an isolated bus 2 with its own source and a shunt
+        // the reference adds a second fault at bus 2, such that the faulted network is factorized
+        // the second fault does not affect the first island
+        // the fault admittances include an open fault (infinite impedance) and a solid fault (infinite admittance)
+        MathModelTopology topo_ext = topo_sc;
+        topo_ext.phase_shift = {0.0, 0.0, 0.0};
+        topo_ext.source_bus_indptr = {0, 1, 1, 2};
+        topo_ext.shunt_bus_indptr = {0, 0, 0, 1};
+        topo_ext.load_gen_bus_indptr = {0, 0, 0, 0};
+        auto const topo_ext_ptr = std::make_shared<MathModelTopology const>(topo_ext);
+        MathModelParam<false> param_ext = param_sc_asym;
+        param_ext.source_param = {yref_asym, yref_asym};
+        param_ext.shunt_param = {ComplexTensor<false>{y0}};
+        YBus<false> const y_bus_ext{topo_ext_ptr, std::make_shared<MathModelParam<false> const>(param_ext)};
+        MathSolver<false> solver{topo_ext_ptr};
+        MathSolver<false> ref_solver{topo_ext_ptr};
+        CalculationInfo info;
+
+        for (auto const& [fault_type, fault_phase] :
+             {std::pair{three_phase, FaultPhase::abc}, std::pair{single_phase_to_ground, FaultPhase::b},
+              std::pair{two_phase, FaultPhase::ac}, std::pair{two_phase_to_ground, FaultPhase::ab}}) {
+            for (DoubleComplex const& y_fault_single : {y_fault, DoubleComplex{0.0}, y_fault_solid}) {
+                for (IdxVector const& single_bus_indptr : {IdxVector{0, 1, 1, 1}, IdxVector{0, 0, 1, 1}}) {
+                    ShortCircuitInput input =
+                        create_sc_test_input(fault_type, fault_phase, y_fault_single, vref, single_bus_indptr);
+                    input.source = {vref, vref};
+                    ShortCircuitInput ref_input = input;
+                    ref_input.fault_bus_indptr = {0, single_bus_indptr[1], 1, 2};
+                    ref_input.faults.push_back({y_fault, fault_type, fault_phase});
+
+                    auto output = solver.run_short_circuit(input, info, CalculationMethod::iec60909, y_bus_ext);
+                    auto ref_output =
+                        ref_solver.run_short_circuit(ref_input, info, CalculationMethod::iec60909, y_bus_ext);
+                    // compare the first island
+                    for (auto* result : {&output, &ref_output}) {
+                        result->u_bus.resize(2);
+                        result->fault.resize(1);
+                        result->source.resize(1);
+                    }
+                    assert_sc_output<false>(output, ref_output);
+                }
+            }
+        }
+    }
+
     SUBCASE("Test fault on source bus") {
         // Grid for short circuit
         MathModelTopology topo_comp;
@@ -176,7 +176,7 @@ TEST_CASE("Test source") {
     SUBCASE("test update") {
         auto changed = source.update(SourceUpdate{{{1}, 1}, 1.05, nan});
         CHECK(!changed.topo);
-        CHECK(changed.param);
+        CHECK(!changed.param);
         changed = source.update(SourceUpdate{{{1}, 0}, 1.05, nan});
         CHECK(changed.topo);
         CHECK(changed.param);
@@ -7,6 +7,8 @@
 
 #include <doctest/doctest.h>
 
+#include <set>
+
 namespace power_grid_model {
 
 using lu_trait_double = math_model_impl::sparse_lu_entry_trait<double, double, double>;
@@ -76,6 +78,16 @@ TEST_CASE("Test Sparse LU solver") {
             check_result(x, x_ref);
         }
 
+        SUBCASE("Test multiple right-hand sides") {
+            // second rhs is rhs * 2, interleaved per row
+            std::vector<double> const multi_rhs = {21, 42, 2, 4, 18, 36};
+            std::vector<double> const multi_x_ref = {3, 6, -1, -2, 2, 4};
+            std::vector<double> multi_x(6, 0.0);
+            solver.prefactorize(data, block_perm);
+            solver.solve_with_prefactorized_matrix((std::vector<double> const&)data, block_perm, 2, multi_rhs, multi_x);
+            check_result(multi_x, multi_x_ref);
+        }
+
         SUBCASE("Data is prefactorized by solve") {
             auto prefactorized_data = data;
             auto prefactorized_block_perm = block_perm;
@@ -125,6 +137,206 @@ TEST_CASE("Test Sparse LU solver") {
             solver.solve_with_prefactorized_matrix((std::vector<Tensor> const&)data, block_perm, rhs, x);
             check_result(x, x_ref);
         }
+
+        SUBCASE("Test multiple right-hand sides") {
+            // second rhs is -rhs, interleaved per row
+            std::vector<Array> const multi_rhs = {{38, 356}, {-38, -356}, {-389, 2}, {389, -2}, {44, 611}, {-44, -611}};
+            std::vector<Array> const multi_x_ref = {{3, 4}, {-3, -4}, {-1, -2}, {1, 2}, {5, 6}, {-5, -6}};
+            std::vector<Array> multi_x(6, Array::Zero());
+            solver.prefactorize(data, block_perm);
+            solver.solve_with_prefactorized_matrix((std::vector<Tensor> const&)data, block_perm, 2, multi_rhs, multi_x);
+            check_result(multi_x, multi_x_ref);
+        }
+
+        SUBCASE("Test re-use block permutation") {
+            auto prefactorized_data = data;
+            solver.prefactorize(prefactorized_data, block_perm);
+            auto const prefactorized_block_perm = block_perm;
+            // slightly perturbed matrix, the same pivots are still valid
+            data[8](1, 1) = 101.0;
+            std::vector<Array> const rhs_perturbed = {{38, 356}, {-389, 2}, {44, 617}};
+            solver.prefactorize_and_solve(data, block_perm, rhs_perturbed, x, true);
+            check_result(x, x_ref);
+            for (Idx i = 0; i != 3; ++i) {
+                CHECK(block_perm[i].p.indices() == prefactorized_block_perm[i].p.indices());
+                CHECK(block_perm[i].q.indices() == prefactorized_block_perm[i].q.indices());
+            }
+        }
+
+        SUBCASE("Test re-use degraded block permutation") {
+            // identity permutation gives a zero pivot in the first block, fall back to full pivoting
+            for (auto& perm : block_perm) {
+                perm.p.setIdentity();
+                perm.q.setIdentity();
+            }
+            solver.prefactorize_and_solve(data, block_perm, rhs, x, true);
+            check_result(x, x_ref);
+        }
+
+        SUBCASE("Test re-use block permutation (pseudo) singular") {
+            auto prefactorized_data = data;
+            solver.prefactorize(prefactorized_data, block_perm);
+            data[0](0, 1) = 0.0;
+            CHECK_THROWS_AS(solver.prefactorize_and_solve(data, block_perm, rhs, x, true), SparseMatrixError);
+        }
+    }
+}
+
+namespace {
+// matrix of a number of meshed grids, where the last node of each grid is connected to a common root node
+// the nodes are ordered per grid, the root is the last node
+// fill-ins are calculated by symbolic elimination
+struct MeshedTestMatrix {
+    static constexpr Idx n_grid = 8;
+    static constexpr Idx grid_width = 20;
+    static constexpr Idx n_grid_node = grid_width * grid_width;
+    static constexpr Idx size = n_grid * n_grid_node + 1;
+
+    std::shared_ptr<IdxVector const> row_indptr;
+    std::shared_ptr<IdxVector const> col_indices;
+    std::shared_ptr<IdxVector const> diag_lu;
+    std::vector<Tensor> data;
+    std::vector<Array> x_ref;
+    std::vector<Array> rhs;
+
+    MeshedTestMatrix() {
+        Idx const root = size - 1;
+        std::vector<std::set<Idx>> adjacency(size);
+        auto const connect = [&adjacency](Idx i, Idx j) {
+            adjacency[i].insert(j);
+            adjacency[j].insert(i);
+        };
+        for (Idx grid = 0; grid != n_grid; ++grid) {
+            Idx const offset = grid * n_grid_node;
+            for (Idx r = 0; r != grid_width; ++r) {
+                for (Idx c = 0; c != grid_width; ++c) {
+                    Idx const node = offset + r * grid_width + c;
+                    if (c + 1 != grid_width) {
+                        connect(node, node + 1);
+                    }
+                    if (r + 1 != grid_width) {
+                        connect(node, node + grid_width);
+                    }
+                }
+            }
+            connect(offset + n_grid_node - 1, root);
+        }
+        std::vector<std::set<Idx>> const original = adjacency;
+        // symbolic elimination
+        for (Idx k = 0; k != size; ++k) {
+            std::vector<Idx> const higher(adjacency[k].upper_bound(k), adjacency[k].end());
+            for (Idx const i : higher) {
+                adjacency[i].insert(higher.cbegin(), higher.cend());
+                adjacency[i].erase(i);
+            }
+        }
+
+        IdxVector indptr{0};
+        IdxVector indices;
+        IdxVector diag;
+        x_ref.resize(size);
+        rhs.resize(size, Array::Zero());
+        for (Idx row = 0; row != size; ++row) {
+            adjacency[row].insert(row);
+            x_ref[row] = {std::sin((double)row), std::cos((double)row)};
+            for (Idx const col : adjacency[row]) {
+                if (col == row) {
+                    diag.push_back((Idx)indices.size());
+                    // diagonal dominant, but with a small upper-left entry to trigger pivoting
+                    auto const degree = (double)original[row].size();
+                    data.push_back(Tensor{{0.1, 3.0 * degree}, {3.0 * degree, 1.0}});
+                } else if (original[row].contains(col)) {
+                    data.push_back(Tensor{{-1.0, 0.5}, {0.2 * (double)(row % 3), -1.0}});
+                } else {
+                    data.push_back(Tensor::Zero());
+                }
+                indices.push_back(col);
+            }
+            indptr.push_back((Idx)indices.size());
+        }
+        for (Idx row = 0; row != size; ++row) {
+            for (Idx idx = indptr[row]; idx != indptr[row + 1]; ++idx) {
+                rhs[row] += (data[idx].matrix() * x_ref[indices[idx]].matrix()).array();
+            }
+        }
+        row_indptr = std::make_shared<IdxVector const>(std::move(indptr));
+        col_indices = std::make_shared<IdxVector const>(std::move(indices));
+        diag_lu = std::make_shared<IdxVector const>(std::move(diag));
+    }
+};
+} // namespace
+
+TEST_CASE("Test parallel sparse LU solver") {
+    MeshedTestMatrix const matrix;
+    Idx const size = MeshedTestMatrix::size;
+
+    SUBCASE("Schedule") {
+        SparseLUSchedule const schedule{*matrix.row_indptr, *matrix.col_indices, *matrix.diag_lu, 3};
+        CHECK(schedule.n_thread == 3);
+        // each row exactly once
+        IdxVector row_thread(size, -2);
+        for (Idx thread = 0; thread != schedule.n_thread; ++thread) {
+            for (Idx idx = schedule.subtree_thread_indptr[thread]; idx != schedule.subtree_thread_indptr[thread + 1];
+                 ++idx) {
+                CHECK(row_thread[schedule.subtree_rows[idx]] == -2);
+                row_thread[schedule.subtree_rows[idx]] = thread;
+            }
+        }
+        for (Idx const row : schedule.top_rows) {
+            CHECK(row_thread[row] == -2);
+            row_thread[row] = -1;
+        }
+        CHECK(std::none_of(row_thread.cbegin(), row_thread.cend(), [](Idx x) { return x == -2; }));
+        // all the threads have work, the root is at the top
+        for (Idx thread = 0; thread != schedule.n_thread; ++thread) {
+            CHECK(schedule.subtree_thread_indptr[thread + 1] > schedule.subtree_thread_indptr[thread]);
+        }
+        CHECK(row_thread[size - 1] == -1);
+        // a row in a subtree only depends on rows in the same thread
+        for (Idx row = 0; row != size; ++row) {
+            if (row_thread[row] == -1) {
+                continue;
+            }
+            for (Idx idx = (*matrix.row_indptr)[row]; idx != (*matrix.diag_lu)[row]; ++idx) {
+                CHECK(row_thread[(*matrix.col_indices)[idx]] == row_thread[row]);
+            }
+        }
+
+        // not enough rows for the threads
+        SparseLUSchedule const small_schedule{*matrix.row_indptr, *matrix.col_indices, *matrix.diag_lu, 8};
+        CHECK(small_schedule.n_thread == size / SparseLUSchedule::min_rows_per_thread);
+    }
+
+    SUBCASE("Calculation") {
+        SparseLUSolver<Tensor, Array, Array> solver{matrix.row_indptr, matrix.col_indices, matrix.diag_lu};
+        SparseLUSolver<Tensor, Array, Array>::BlockPermArray block_perm(size);
+        std::vector<Array> x(size, Array::Zero());
+
+        auto data_sequential = matrix.data;
+        solver.prefactorize_and_solve(data_sequential, block_perm, matrix.rhs, x);
+        check_result(x, matrix.x_ref);
+
+        solver.set_threading(3);
+        auto data_parallel = matrix.data;
+        std::vector<Array> x_parallel(size, Array::Zero());
+        solver.prefactorize_and_solve(data_parallel, block_perm, matrix.rhs, x_parallel);
+        check_result(x_parallel, matrix.x_ref);
+        // exactly the same operations per row
+        for (Idx idx = 0; idx != (Idx)data_parallel.size(); ++idx) {
+            CHECK((data_parallel[idx] == data_sequential[idx]).all());
+        }
+
+        // re-use block permutation
+        data_parallel = matrix.data;
+        solver.prefactorize_and_solve(data_parallel, block_perm, matrix.rhs, x_parallel, true);
+        check_result(x_parallel, matrix.x_ref);
+
+        // singular matrix, with a zero row
+        data_parallel = matrix.data;
+        Idx const zero_row = MeshedTestMatrix::n_grid_node * 5 + 7;
+        std::fill(data_parallel.begin() + (*matrix.row_indptr)[zero_row],
+                  data_parallel.begin() + (*matrix.row_indptr)[zero_row + 1], Tensor::Zero());
+        CHECK_THROWS_AS(solver.prefactorize(data_parallel, block_perm), SparseMatrixError);
     }
 }
 
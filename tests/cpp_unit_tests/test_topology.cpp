@@ -314,6 +314,54 @@ TEST_CASE("Test topology") {
             CHECK(math.fill_in == math_ref.fill_in);
         }
     }
+
+    SUBCASE("Test patch topology") {
+        Topology topo{comp_topo, comp_conn};
+        auto const pair = topo.build_topology();
+        auto const& math_topology = pair.first;
+        auto const& topo_comp_coup = pair.second;
+        ComponentConnections new_conn = comp_conn;
+        auto const patch = [&]() {
+            return Topology::patch_topology(comp_topo, comp_conn, new_conn, math_topology, topo_comp_coup);
+        };
+
+        SUBCASE("No change") { CHECK(patch() == topo_comp_coup); }
+        SUBCASE("Open parallel branch") {
+            new_conn.branch_connected[6] = {0, 0};
+            auto const patched_coup = patch();
+            REQUIRE(patched_coup != nullptr);
+            auto branch_ref = comp_coup_ref.branch;
+            branch_ref[6] = {-1, -1};
+            CHECK(patched_coup->branch == branch_ref);
+            CHECK(patched_coup->node == comp_coup_ref.node);
+            CHECK(patched_coup->power_sensor == comp_coup_ref.power_sensor);
+        }
+        SUBCASE("Open one side of parallel branch") {
+            new_conn.branch_connected[7] = {1, 0};
+            CHECK(patch() == topo_comp_coup);
+        }
+        SUBCASE("Open isolated branch") {
+            new_conn.branch_connected[3] = {0, 1};
+            CHECK(patch() == topo_comp_coup);
+        }
+        SUBCASE("Disconnect node") {
+            new_conn.branch_connected[6] = {0, 0};
+            new_conn.branch_connected[7] = {0, 1};
+            CHECK(patch() == nullptr);
+        }
+        SUBCASE("Close branch") {
+            new_conn.branch_connected[2] = {1, 1};
+            CHECK(patch() == nullptr);
+        }
+        SUBCASE("Open measured branch") {
+            new_conn.branch_connected[1] = {1, 0};
+            CHECK(patch() == nullptr);
+        }
+        SUBCASE("Source change") {
+            new_conn.source_connected[2] = 1;
+            CHECK(patch() == nullptr);
+        }
+    }
 }
 
 TEST_CASE("Test cycle reorder") {
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/main_core/topology_cache.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model::main_core {
+
+namespace {
+TopologyCache::Entry make_entry(ComponentConnections const& comp_conn, Idx n_math_model) {
+    TopologyCache::Entry entry{.comp_conn = comp_conn, .math_topology = {}, .topo_comp_coup = {}, .math_state = {}};
+    entry.math_topology.resize(n_math_model);
+    return entry;
+}
+} // namespace
+
+TEST_CASE("Test topology cache") {
+    ComponentConnections comp_conn_a{};
+    comp_conn_a.branch_connected = {{1, 1}, {1, 0}};
+    comp_conn_a.branch3_connected = {{1, 1, 1}};
+    comp_conn_a.branch_phase_shift = {0.0, 0.0};
+    comp_conn_a.branch3_phase_shift = {{0.0, 0.0, 0.0}};
+    comp_conn_a.source_connected = {1};
+
+    ComponentConnections comp_conn_b = comp_conn_a;
+    comp_conn_b.branch_connected[1] = {1, 1};
+    ComponentConnections comp_conn_c = comp_conn_a;
+    comp_conn_c.source_connected[0] = 0;
+
+    TopologyCache cache;
+
+    SUBCASE("Hash") {
+        CHECK(TopologyCache::hash(comp_conn_a) == TopologyCache::hash(ComponentConnections{comp_conn_a}));
+        CHECK(TopologyCache::hash(comp_conn_a) != TopologyCache::hash(comp_conn_b));
+        CHECK(TopologyCache::hash(comp_conn_a) != TopologyCache::hash(comp_conn_c));
+    }
+
+    SUBCASE("Disabled by default") {
+        CHECK(cache.capacity() == 0);
+        cache.store(make_entry(comp_conn_a, 1));
+        CHECK(cache.size() == 0);
+        CHECK(!cache.take(comp_conn_a).has_value());
+    }
+
+    SUBCASE("Store and take") {
+        cache.set_capacity(2);
+        cache.store(make_entry(comp_conn_a, 1));
+        cache.store(make_entry(comp_conn_b, 2));
+        CHECK(cache.size() == 2);
+
+        CHECK(!cache.take(comp_conn_c).has_value());
+        auto const entry = cache.take(comp_conn_b);
+        REQUIRE(entry.has_value());
+        CHECK(entry->math_topology.size() == 2);
+        CHECK(cache.size() == 1);
+        CHECK(!cache.take(comp_conn_b).has_value());
+    }
+
+    SUBCASE("Same statuses with different phase shift") {
+        cache.set_capacity(2);
+        cache.store(make_entry(comp_conn_a, 1));
+        ComponentConnections shifted = comp_conn_a;
+        shifted.branch_phase_shift[0] = 1.0;
+        CHECK(TopologyCache::hash(shifted) == TopologyCache::hash(comp_conn_a));
+        CHECK(!cache.take(shifted).has_value());
+        CHECK(cache.take(comp_conn_a).has_value());
+    }
+
+    SUBCASE("Evict least recently stored") {
+        cache.set_capacity(2);
+        cache.store(make_entry(comp_conn_a, 1));
+        cache.store(make_entry(comp_conn_b, 2));
+        cache.store(make_entry(comp_conn_c, 3));
+        CHECK(cache.size() == 2);
+        CHECK(!cache.take(comp_conn_a).has_value());
+        CHECK(cache.take(comp_conn_c).has_value());
+
+        cache.set_capacity(0);
+        CHECK(cache.size() == 0);
+    }
+
+    SUBCASE("Not copied") {
+        cache.set_capacity(2);
+        cache.store(make_entry(comp_conn_a, 1));
+        TopologyCache const copy{cache};
+        CHECK(copy.size() == 0);
+        CHECK(copy.capacity() == 0);
+        CHECK(cache.size() == 1);
+    }
+}
+
+} // namespace power_grid_model::main_core
@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2022 Contributors to the Power Grid Model project <dynamic.grid.calculation@alliander.com>
+//
+// SPDX-License-Identifier: MPL-2.0
+
+#include <power_grid_model/math_solver/woodbury_lu_solver.hpp>
+
+#include <doctest/doctest.h>
+
+namespace power_grid_model {
+
+namespace {
+// chain of 6 buses, each bus has a shunt to ground and is connected with a branch to the next bus
+// the matrix is tri-diagonal, so no fill-ins
+constexpr Idx n_bus = 6;
+
+struct ChainMatrix {
+    std::shared_ptr<IdxVector const> row_indptr;
+    std::shared_ptr<IdxVector const> col_indices;
+    std::shared_ptr<IdxVector const> diag_lu;
+
+    ChainMatrix() {
+        IdxVector indptr{0};
+        IdxVector indices;
+        IdxVector diag;
+        for (Idx row = 0; row != n_bus; ++row) {
+            for (Idx col = std::max(Idx{0}, row - 1); col != std::min(n_bus, row + 2); ++col) {
+                if (col == row) {
+                    diag.push_back(static_cast<Idx>(indices.size()));
+                }
+                indices.push_back(col);
+            }
+            indptr.push_back(static_cast<Idx>(indices.size()));
+        }
+        row_indptr = std::make_shared<IdxVector const>(std::move(indptr));
+        col_indices = std::make_shared<IdxVector const>(std::move(indices));
+        diag_lu = std::make_shared<IdxVector const>(std::move(diag));
+    }
+
+    // branch admittance per branch k (between bus k and k + 1), a zero admittance represents an outage
+    template <bool sym>
+    ComplexTensorVector<sym> get_data(std::vector<DoubleComplex> const& y_branch, DoubleComplex y_shunt) const {
+        auto const tensor = [](DoubleComplex y) {
+            if constexpr (sym) {
+                return ComplexTensor<sym>{y};
+            } else {
+                return ComplexTensor<sym>{y, 0.25 * y};
+            }
+        };
+        ComplexTensorVector<sym> data(row_indptr->back(), ComplexTensor<sym>{0.0});
+        for (Idx row = 0; row != n_bus; ++row) {
+            for (Idx k = (*row_indptr)[row]; k != (*row_indptr)[row + 1]; ++k) {
+                Idx const col = (*col_indices)[k];
+                if (col == row) {
+                    DoubleComplex y_diag = y_shunt;
+                    if (row > 0) {
+                        y_diag += y_branch[row - 1];
+                    }
+                    if (row < n_bus - 1) {
+                        y_diag += y_branch[row];
+                    }
+                    data[k] = tensor(y_diag);
+                } else {
+                    data[k] = tensor(-y_branch[std::min(row, col)]);
+                }
+            }
+        }
+        return data;
+    }
+};
+
+template <bool sym> void check_result(ComplexValueVector<sym> const& x, ComplexValueVector<sym> const& x_ref) {
+    REQUIRE(x.size() == x_ref.size());
+    for (size_t i = 0; i != x.size(); ++i) {
+        CHECK(max_val(cabs(x[i] - x_ref[i])) < numerical_tolerance);
+    }
+}
+
+template <bool sym> void test_woodbury_lu_solver() {
+    ChainMatrix const matrix;
+    std::vector<DoubleComplex> const y_branch(n_bus - 1, DoubleComplex{1.0, -5.0});
+    DoubleComplex const y_shunt{0.1, 0.2};
+    ComplexValueVector<sym> rhs(n_bus, ComplexValue<sym>{0.0});
+    rhs[0] = ComplexValue<sym>{DoubleComplex{1.0, 0.5}};
+    rhs[4] = ComplexValue<sym>{DoubleComplex{-0.5, 0.1}};
+
+    WoodburyLUSolver<sym> solver{matrix.row_indptr, matrix.col_indices, matrix.diag_lu};
+    SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>> ref_solver{
+        matrix.row_indptr, matrix.col_indices, matrix.diag_lu};
+    typename SparseLUSolver<ComplexTensor<sym>, ComplexValue<sym>, ComplexValue<sym>>::BlockPermArray perm(n_bus);
+
+    auto const solve = [&](ComplexTensorVector<sym> data) {
+        ComplexValueVector<sym> x(n_bus);
+        solver.prefactorize_and_solve(data, rhs, x);
+        return x;
+    };
+    auto const solve_ref = [&](ComplexTensorVector<sym> data) {
+        ComplexValueVector<sym> x(n_bus);
+        ref_solver.prefactorize_and_solve(data, perm, rhs, x);
+        return x;
+    };
+
+    auto const base_data = matrix.get_data<sym>(y_branch, y_shunt);
+    check_result<sym>(solve(base_data), solve_ref(base_data));
+    CHECK(solver.is_base_case_reused());
+
+    SUBCASE("Same matrix") {
+        check_result<sym>(solve(base_data), solve_ref(base_data));
+        CHECK(solver.is_base_case_reused());
+    }
+
+    SUBCASE("Branch outage") {
+        for (Idx k = 0; k != n_bus - 1; ++k) {
+            auto y_outage = y_branch;
+            y_outage[k] = 0.0;
+            auto const data = matrix.get_data<sym>(y_outage, y_shunt);
+            check_result<sym>(solve(data), solve_ref(data));
+            CHECK(solver.is_base_case_reused());
+        }
+        // back to the base case
+        check_result<sym>(solve(base_data), solve_ref(base_data));
+        CHECK(solver.is_base_case_reused());
+    }
+
+    SUBCASE("Large change") {
+        auto const data = matrix.get_data<sym>(y_branch, 2.0 * y_shunt);
+        check_result<sym>(solve(data), solve_ref(data));
+        CHECK(!solver.is_base_case_reused());
+        // base case is kept
+        check_result<sym>(solve(base_data), solve_ref(base_data));
+        CHECK(solver.is_base_case_reused());
+    }
+
+    SUBCASE("Singular") {
+        // isolate bus 0, which has no shunt
+        auto data = base_data;
+        data[0] = ComplexTensor<sym>{0.0};
+        data[1] = ComplexTensor<sym>{0.0};
+        data[2] = ComplexTensor<sym>{0.0};
+        ComplexValueVector<sym> x(n_bus);
+        CHECK_THROWS_AS(solver.prefactorize_and_solve(data, rhs, x), SparseMatrixError);
+    }
+}
+} // namespace
+
+TEST_CASE("Test Woodbury LU solver") {
+    SUBCASE("Symmetric") { test_woodbury_lu_solver<true>(); }
+    SUBCASE("Asymmetric") { test_woodbury_lu_solver<false>(); }
+}
+
+} // namespace power_grid_model
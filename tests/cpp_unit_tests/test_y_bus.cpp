@@ -197,6 +197,59 @@ TEST_CASE("Test y bus") {
     }
 }
 
+TEST_CASE("Test incremental y bus update") {
+    /*
+    [0] --0--> [1] --1--> [2] --2--X
+     |
+    shunt 0
+    */
+    MathModelTopology topo{};
+    topo.phase_shift.resize(3, 0.0);
+    topo.branch_bus_idx = {{0, 1}, {1, 2}, {2, -1}};
+    topo.shunt_bus_indptr = {0, 1, 1, 1};
+    MathModelParam<true> param;
+    param.branch_param = {{1.0, 2.0, 3.0, 4.0}, {5.0, 6.0, 7.0, 8.0}, {9.0i, 0.0, 0.0, 0.0}};
+    param.shunt_param = {100.0i};
+    auto const topo_ptr = std::make_shared<MathModelTopology const>(topo);
+
+    auto const param_ptr = std::make_shared<MathModelParam<true> const>(param);
+    YBus<true> ybus{topo_ptr, param_ptr};
+    // the parameters of the caller are shared, not copied
+    CHECK(&ybus.math_model_param() == param_ptr.get());
+    YBus<true> const ybus_copy = ybus;
+    auto const version = ybus.admittance_version();
+    CHECK(ybus_copy.admittance_version() == version);
+
+    // change branch 1, branch 2 and the shunt
+    MathModelParamIncrement<true> increment;
+    increment.branch_param_to_change = {1, 2};
+    increment.branch_param = {{50.0, 60.0, 70.0, 80.0}, {90.0i, 0.0, 0.0, 0.0}};
+    increment.shunt_param_to_change = {0};
+    increment.shunt_param = {200.0i};
+    ybus.update_admittance_increment(increment);
+
+    param.branch_param[1] = increment.branch_param[0];
+    param.branch_param[2] = increment.branch_param[1];
+    param.shunt_param[0] = increment.shunt_param[0];
+    YBus<true> const ybus_ref{topo_ptr, std::make_shared<MathModelParam<true> const>(param)};
+
+    CHECK(ybus.admittance_version() != version);
+    REQUIRE(ybus.admittance().size() == ybus_ref.admittance().size());
+    for (size_t i = 0; i < ybus.admittance().size(); i++) {
+        CHECK(cabs(ybus.admittance()[i] - ybus_ref.admittance()[i]) < numerical_tolerance);
+    }
+    CHECK(cabs(ybus.math_model_param().branch_param[1].yft() - 60.0) < numerical_tolerance);
+    CHECK(cabs(ybus.math_model_param().shunt_param[0] - 200.0i) < numerical_tolerance);
+
+    // the copy sharing the original data is not affected
+    CHECK(ybus_copy.admittance_version() == version);
+    CHECK(cabs(ybus_copy.admittance()[0] - (1.0 + 100.0i)) < numerical_tolerance);
+    CHECK(cabs(ybus_copy.math_model_param().branch_param[1].yft() - 6.0) < numerical_tolerance);
+    // the parameters of the caller are not modified
+    CHECK(&ybus.math_model_param() != param_ptr.get());
+    CHECK(cabs(param_ptr->branch_param[1].yft() - 6.0) < numerical_tolerance);
+}
+
 TEST_CASE("Test one bus system") {
     MathModelTopology topo{};
     MathModelParam<true> const param;
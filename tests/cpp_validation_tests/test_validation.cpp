@@ -279,6 +279,7 @@ std::map<std::string, CalculationMethod> const calculation_method_mapping = {
     {"newton_raphson", CalculationMethod::newton_raphson},
     {"linear", CalculationMethod::linear},
     {"iterative_current", CalculationMethod::iterative_current},
+    {"fast_decoupled", CalculationMethod::fast_decoupled},
     {"iterative_linear", CalculationMethod::iterative_linear},
     {"iec60909", CalculationMethod::iec60909},
 };
@@ -7,7 +7,16 @@ from copy import copy
 import numpy as np
 import pytest
 
-from power_grid_model import PowerGridModel, initialize_array
+from power_grid_model import (
+    BatchPartitioning,
+    CalculationMethod,
+    FaultPhase,
+    FaultType,
+    PowerFlowInitialization,
+    PowerGridModel,
+    ShortCircuitVoltageScaling,
+    initialize_array,
+)
 from power_grid_model.errors import PowerGridBatchError, PowerGridError
 from power_grid_model.validation import assert_valid_input_data
 
@@ -112,6 +121,95 @@ def test_batch_power_flow(model: PowerGridModel, case_data):
     compare_result(result, case_data["output_batch"], rtol=0.0, atol=1e-8)
 
 
+def test_fast_decoupled_power_flow(model: PowerGridModel, case_data):
+    result = model.calculate_power_flow(calculation_method=CalculationMethod.fast_decoupled)
+    compare_result(result, case_data["output"], rtol=0.0, atol=1e-8)
+    result = model.calculate_power_flow(calculation_method="fast_decoupled", update_data=case_data["update_batch"])
+    compare_result(result, case_data["output_batch"], rtol=0.0, atol=1e-8)
+
+
+@pytest.mark.parametrize(
+    "power_flow_initialization",
+    [PowerFlowInitialization.flat_start, PowerFlowInitialization.previous_solution, "previous_solution"],
+)
+def test_power_flow_initialization(model: PowerGridModel, case_data, power_flow_initialization):
+    # calculate twice, so the second calculation can start from the previous solution
+    for _ in range(2):
+        result = model.calculate_power_flow(power_flow_initialization=power_flow_initialization)
+        compare_result(result, case_data["output"], rtol=0.0, atol=1e-8)
+    result = model.calculate_power_flow(
+        update_data=case_data["update_batch"], power_flow_initialization=power_flow_initialization
+    )
+    compare_result(result, case_data["output_batch"], rtol=0.0, atol=1e-8)
+
+
+@pytest.mark.parametrize(
+    "batch_partitioning", [BatchPartitioning.work_stealing, BatchPartitioning.contiguous, "contiguous"]
+)
+@pytest.mark.parametrize("threading", [-1, 0, 2])
+def test_batch_partitioning(model: PowerGridModel, case_data, batch_partitioning, threading):
+    result = model.calculate_power_flow(
+        update_data=case_data["update_batch"], threading=threading, batch_partitioning=batch_partitioning
+    )
+    compare_result(result, case_data["output_batch"], rtol=0.0, atol=1e-8)
+
+
+@pytest.fixture
+def sc_model(case_data):
+    fault = initialize_array("input", "fault", 1)
+    fault["id"] = 3
+    fault["status"] = 1
+    fault["fault_type"] = FaultType.three_phase
+    fault["fault_phase"] = FaultPhase.abc
+    fault["fault_object"] = 0
+    return PowerGridModel(input_data={**case_data["input"], "fault": fault})
+
+
+def test_short_circuit_paired(sc_model: PowerGridModel):
+    expected_max = sc_model.calculate_short_circuit(short_circuit_voltage_scaling=ShortCircuitVoltageScaling.maximum)
+    expected_min = sc_model.calculate_short_circuit(short_circuit_voltage_scaling="minimum")
+    assert expected_max["fault"]["i_f"][0, 0] > expected_min["fault"]["i_f"][0, 0]
+
+    result_max, result_min = sc_model.calculate_short_circuit_paired()
+    compare_result(result_max, expected_max, rtol=0.0, atol=1e-8)
+    compare_result(result_min, expected_min, rtol=0.0, atol=1e-8)
+
+    # the first result follows the voltage scaling in the options
+    result_min, result_max = sc_model.calculate_short_circuit_paired(
+        short_circuit_voltage_scaling=ShortCircuitVoltageScaling.minimum
+    )
+    compare_result(result_max, expected_max, rtol=0.0, atol=1e-8)
+    compare_result(result_min, expected_min, rtol=0.0, atol=1e-8)
+
+
+def test_short_circuit_paired_batch(sc_model: PowerGridModel):
+    fault_update = initialize_array("update", "fault", (2, 1))
+    fault_update["id"] = 3
+    fault_update["r_f"] = [[0.0], [1.0]]
+    update_data = {"fault": fault_update}
+    expected_max = sc_model.calculate_short_circuit(update_data=update_data, short_circuit_voltage_scaling="maximum")
+    expected_min = sc_model.calculate_short_circuit(update_data=update_data, short_circuit_voltage_scaling="minimum")
+
+    output_component_types = {"node", "fault"}
+    result_max, result_min = sc_model.calculate_short_circuit_paired(
+        update_data=update_data, output_component_types=output_component_types
+    )
+    assert set(result_max.keys()) == output_component_types
+    assert set(result_min.keys()) == output_component_types
+    compare_result(result_max, {k: expected_max[k] for k in output_component_types}, rtol=0.0, atol=1e-8)
+    compare_result(result_min, {k: expected_min[k] for k in output_component_types}, rtol=0.0, atol=1e-8)
+
+
+def test_short_circuit_paired_batch_error(sc_model: PowerGridModel):
+    fault_update = initialize_array("update", "fault", (2, 1))
+    fault_update["id"] = [[3], [5]]
+    with pytest.raises(PowerGridBatchError) as e:
+        sc_model.calculate_short_circuit_paired(update_data={"fault": fault_update})
+    error = e.value
+    np.allclose(error.failed_scenarios, [1])
+    assert "The id cannot be found:" in error.error_messages[0]
+
+
 def test_construction_error(case_data):
     case_data["input"]["sym_load"]["id"] = 0
     with pytest.raises(PowerGridError, match="Conflicting id detected:"):